@@ -24,6 +24,7 @@
 // Diese Version von LittleFS sollte als Tab eingebunden werden.
 // #include <LittleFS.h> #include <ESP8266WebServer.h> müssen im Haupttab aufgerufen werden
 // Die Funktionalität des ESP8266 Webservers ist erforderlich.
+// Portiert auf ESPAsyncWebServer: die Handler laufen im Task des TCP-Stacks, nicht in loop().
 // "server.onNotFound()" darf nicht im Setup des ESP8266 Webserver stehen.
 // Die Funktion "setupFS();" muss im Setup aufgerufen werden.
 /**************************************************************************************/
@@ -33,22 +34,23 @@
 #include <FS.h>
 #include <LittleFS.h>
 
-extern WebServer server;
+extern AsyncWebServer server;
 
 const char WARNING[] PROGMEM = R"(<h2>Der Sketch wurde mit "FS:none" kompilliert!)";
 const char HELPER[] PROGMEM = R"(<form method="POST" action="/upload" enctype="multipart/form-data">
 <input type="file" name="[]" multiple><button>Upload</button></form>Lade die fs.html hoch.)";
 
-void sendResponce() {
-  server.sendHeader("Location", "fs.html");
-  server.send(303, "message/http");
+void sendResponce(AsyncWebServerRequest *request) {
+  AsyncWebServerResponse *response = request->beginResponse(303, "message/http");
+  response->addHeader("Location", "fs.html");
+  request->send(response);
 }
 
 const String formatBytes(size_t const& bytes) {                                        // lesbare Anzeige der Speichergrößen
   return bytes < 1024 ? static_cast<String>(bytes) + " Byte" : bytes < 1048576 ? static_cast<String>(bytes / 1024.0) + " KB" : static_cast<String>(bytes / 1048576.0) + " MB";
 }
 
-bool handleList() {                                                                    // Senden aller Daten an den Client
+bool handleList(AsyncWebServerRequest *request) {                                                                    // Senden aller Daten an den Client
   // Dir dir = LittleFS.openDir("/");
   // using namespace std;
   // using records = tuple<String, String, int>;
@@ -130,16 +132,16 @@ String getContentType(String filename){
   return F("text/plain");
 }
 
-bool handleFile(String &&path) {
-  if (server.hasArg("new")) {
-    String folderName {server.arg("new")};
+bool handleFile(AsyncWebServerRequest *request, String &&path) {
+  if (request->hasParam("new")) {
+    String folderName {request->getParam("new")->value()};
     for (auto& c : {34, 37, 38, 47, 58, 59, 92}) for (auto& e : folderName) if (e == c) e = 95;    // Ersetzen der nicht erlaubten Zeichen
     LittleFS.mkdir(folderName);
   }
-  if (server.hasArg("sort")) return handleList();
-  if (server.hasArg("delete")) {
-    deleteRecursive(server.arg("delete"));
-    sendResponce();
+  if (request->hasParam("sort")) return handleList(request);
+  if (request->hasParam("delete")) {
+    deleteRecursive(request->getParam("delete")->value());
+    sendResponce(request);
     return true;
   }
 
@@ -159,33 +161,41 @@ bool handleFile(String &&path) {
   // server.send(200, "text/plain", temp);
   // return true;
 
-  if (!LittleFS.exists("/fs.html")) server.send(200, "text/html", HELPER);     // ermöglicht das hochladen der fs.html
   if (path.endsWith("/")) path += "index.html";
-  if (path == "/spiffs.html") sendResponce(); // Vorrübergehend für den Admin Tab
-  return LittleFS.exists(path) ? ({File f = LittleFS.open(path, "r"); server.streamFile(f, getContentType(path)); f.close(); true;}) : false;
+  if (path == "/fs.html" && !LittleFS.exists(path)) {                             // ermöglicht das hochladen der fs.html
+    request->send(200, "text/html", HELPER);
+    return true;
+  }
+  if (path == "/spiffs.html") {                                                   // Vorrübergehend für den Admin Tab
+    sendResponce(request);
+    return true;
+  }
+  return LittleFS.exists(path) ? (request->send(LittleFS, path, getContentType(path)), true) : false;   // die Datei wird asynchron gesendet
 }
 
-void handleUpload() {                                                                  // Dateien ins Filesystem schreiben
-  static File fsUploadFile;
-  HTTPUpload& upload = server.upload();
-  if (upload.status == UPLOAD_FILE_START) {
-    if (upload.filename.length() > 31) {  // Dateinamen kürzen
-      upload.filename = upload.filename.substring(upload.filename.length() - 31, upload.filename.length());
+void handleUpload(AsyncWebServerRequest *request, String filename, size_t index, uint8_t *data, size_t len, bool final) {   // Dateien ins Filesystem schreiben
+  // die Datei gehört zum Request (_tempFile), gleichzeitige Uploads schreiben so nicht in die Datei des anderen
+  if (index == 0) {
+    if (filename.length() > 31) {  // Dateinamen kürzen
+      filename = filename.substring(filename.length() - 31, filename.length());
     }
-    printf(PSTR("handleFileUpload Name: /%s\n"), upload.filename.c_str());
-    fsUploadFile = LittleFS.open(server.arg(0) + "/" + server.urlDecode(upload.filename), "w");
-  } else if (upload.status == UPLOAD_FILE_WRITE) {
-    printf(PSTR("handleFileUpload Data: %u\n"), upload.currentSize);
-    fsUploadFile.write(upload.buf, upload.currentSize);
-  } else if (upload.status == UPLOAD_FILE_END) {
-    printf(PSTR("handleFileUpload Size: %u\n"), upload.totalSize);
-    fsUploadFile.close();
+    printf(PSTR("handleFileUpload Name: /%s\n"), filename.c_str());
+    String folder = request->params() > 0 ? request->getParam(0)->value() : "";
+    request->_tempFile = LittleFS.open(folder + "/" + request->urlDecode(filename), "w");
+  }
+  if (len > 0 && request->_tempFile) {
+    printf(PSTR("handleFileUpload Data: %u\n"), len);
+    request->_tempFile.write(data, len);
+  }
+  if (final && request->_tempFile) {
+    printf(PSTR("handleFileUpload Size: %u\n"), index + len);
+    request->_tempFile.close();
   }
 }
 
-void formatFS() {                                                                      // Formatiert das Filesystem
+void formatFS(AsyncWebServerRequest *request) {                                       // Formatiert das Filesystem
   LittleFS.format();
-  sendResponce();
+  sendResponce(request);
 }
 
 void setupFS() {                                                                       // Funktionsaufruf "setupFS();" muss im Setup eingebunden werden
@@ -196,8 +206,8 @@ void setupFS() {
   Serial.println("LittleFS Mount Successful");
   server.on("/format", formatFS);
   server.on("/upload", HTTP_POST, sendResponce, handleUpload);
-  server.onNotFound([]() {
-    if (!handleFile(server.urlDecode(server.uri())))
-      server.send(404, "text/plain", "FileNotFound");
+  server.onNotFound([](AsyncWebServerRequest *request) {
+    if (!handleFile(request, String(request->url())))   // url() ist bereits dekodiert
+      request->send(404, "text/plain", "FileNotFound");
   });
 }
\ No newline at end of file
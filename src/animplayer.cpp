@@ -0,0 +1,292 @@
+/**
+ * @file animplayer.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for the animation player, which streams animations from LittleFS
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "animplayer.h"
+
+/**
+ * @brief Construct a new AnimationPlayer:: AnimationPlayer object
+ *
+ */
+AnimationPlayer::AnimationPlayer(){
+
+}
+
+/**
+ * @brief Construct a new AnimationPlayer:: AnimationPlayer object
+ *
+ * @param myledmatrix pointer to LEDMatrix object, need to provide gridAddPixel(x, y, col), gridFlush() and drawOnMatrixInstant()
+ * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
+ */
+AnimationPlayer::AnimationPlayer(LEDMatrix *myledmatrix, UDPLogger *mylogger){
+    _ledmatrix = myledmatrix;
+    _logger = mylogger;
+}
+
+/**
+ * @brief Set the animation file to be played (takes effect with next initGame())
+ *
+ * @param path path of the animation file on LittleFS
+ */
+void AnimationPlayer::setFile(String path){
+    if (!path.startsWith("/")) {
+        path = "/" + path;
+    }
+    _path = path;
+}
+
+/**
+ * @brief Get the path of the current animation file
+ *
+ * @return String path of the animation file
+ */
+String AnimationPlayer::getFile(){
+    return _path;
+}
+
+/**
+ * @brief Start playing the animation file from the beginning
+ *
+ */
+void AnimationPlayer::initGame(){
+    closeFile();
+    (*_ledmatrix).gridFlush();
+    String lowerPath = _path;
+    lowerPath.toLowerCase();
+    _isGif = lowerPath.endsWith(".gif");
+    if (_isGif) {
+        _open = _gif.open(_path);
+        if (!_open) {
+            (*_logger).logString("Player: can't open GIF " + _path);
+            return;
+        }
+        (*_logger).logString("Player: play " + _path + " (GIF, " + String(sizeof(GifDecoder)) + " bytes decoder memory)");
+        _nextFrameTime = millis();
+    }
+    else if (openFile()) {
+        (*_logger).logString("Player: play " + _path + " (" + String(_numFrames) + " frames)");
+        _nextFrameTime = millis();
+    }
+}
+
+/**
+ * @brief Run main loop for one cycle, shows the next frame when the duration of the current frame is over
+ *
+ */
+void AnimationPlayer::loopCycle(){
+    if (!_open || (long)(millis() - _nextFrameTime) < 0) {
+        return;
+    }
+    if (millis() - _nextFrameTime > 1000) {
+        // we are far behind (e.g. blocked by other tasks), do not try to catch up
+        _nextFrameTime = millis();
+    }
+    if (_isGif ? readGifFrame() : readFrame()) {
+        (*_ledmatrix).drawOnMatrixInstant();
+    }
+}
+
+/**
+ * @brief Open the animation file and read header and palette
+ *
+ * @return true if the file is a valid animation
+ */
+bool AnimationPlayer::openFile(){
+    _bufferPos = 0;
+    _bufferLen = 0;
+    _file = LittleFS.open(_path, "r");
+    if (!_file) {
+        (*_logger).logString("Player: can't open " + _path);
+        return false;
+    }
+    _open = true;
+
+    if (readByte() != 'W' || readByte() != 'C' || readByte() != 'A' || readByte() != '1') {
+        (*_logger).logString("Player: invalid file format");
+        closeFile();
+        return false;
+    }
+    int width = readByte();
+    int height = readByte();
+    int paletteSize = readByte();
+    int flags = readByte();
+    int numFrames = readUInt16();
+    if (width != GRID_WIDTH || height != GRID_HEIGHT || numFrames <= 0) {
+        (*_logger).logString("Player: invalid dimensions or no frames");
+        closeFile();
+        return false;
+    }
+    _paletteSize = (paletteSize == 0) ? 256 : paletteSize;
+    _flags = flags;
+    _numFrames = numFrames;
+
+    for (uint16_t i = 0; i < _paletteSize; i++) {
+        for (uint8_t c = 0; c < 3; c++) {
+            int value = readByte();
+            if (value < 0) {
+                (*_logger).logString("Player: palette incomplete");
+                closeFile();
+                return false;
+            }
+            _palette[i][c] = value;
+        }
+    }
+    _firstFrameOffset = ANIMPLAYER_HEADER_SIZE + _paletteSize * 3;
+    _currentFrame = 0;
+    return true;
+}
+
+/**
+ * @brief Close the animation file
+ *
+ */
+void AnimationPlayer::closeFile(){
+    if (_open) {
+        if (_isGif) {
+            _gif.close();
+        } else {
+            _file.close();
+        }
+    }
+    _open = false;
+}
+
+/**
+ * @brief Read and show the next frame. Rewinds at the end of a looped animation.
+ *
+ * @return true if a frame was shown
+ */
+bool AnimationPlayer::readFrame(){
+    if (_currentFrame >= _numFrames) {
+        if (!(_flags & ANIMPLAYER_FLAG_LOOP)) {
+            // keep showing the last frame
+            return false;
+        }
+        _file.seek(_firstFrameOffset);
+        _bufferPos = 0;
+        _bufferLen = 0;
+        _currentFrame = 0;
+    }
+
+    int duration = readUInt16();
+    int type = readByte();
+    int payloadLength = readUInt16();
+    if (duration < 0 || type < 0 || payloadLength < 0) {
+        (*_logger).logString("Player: unexpected end of file in frame " + String(_currentFrame));
+        closeFile();
+        return false;
+    }
+
+    uint8_t opSize = (type == ANIMPLAYER_FRAME_DELTA) ? 3 : 2;
+    uint16_t pixel = 0;
+    int consumed = 0;
+    while (consumed + opSize <= payloadLength) {
+        int skip = (type == ANIMPLAYER_FRAME_DELTA) ? readByte() : 0;
+        int run = readByte();
+        int paletteIndex = readByte();
+        if (skip < 0 || run < 0 || paletteIndex < 0) {
+            (*_logger).logString("Player: unexpected end of file in frame " + String(_currentFrame));
+            closeFile();
+            return false;
+        }
+        consumed += opSize;
+        pixel += skip;
+        for (uint8_t i = 0; i < run; i++) {
+            setPixel(pixel++, paletteIndex);
+        }
+    }
+    // skip trailing bytes of a malformed payload
+    while (consumed < payloadLength) {
+        readByte();
+        consumed++;
+    }
+
+    _currentFrame++;
+    _nextFrameTime += duration;
+    return true;
+}
+
+/**
+ * @brief Decode and show the next frame of a GIF file. GIFs are always looped.
+ *
+ * @return true if a frame was shown
+ */
+bool AnimationPlayer::readGifFrame(){
+    unsigned long start = micros();
+    long delay = _gif.decodeFrame();
+    if (delay == GIFDECODER_END) {
+        if (!_gif.rewind()) {
+            (*_logger).logString("Player: can't rewind " + _path);
+            closeFile();
+            return false;
+        }
+        delay = _gif.decodeFrame();
+    }
+    if (delay < 0) {
+        (*_logger).logString("Player: invalid GIF " + _path);
+        closeFile();
+        return false;
+    }
+    unsigned long decodeMicros = micros() - start;
+    if (decodeMicros > (unsigned long)delay * 1000) {
+        (*_logger).logString("Player: GIF frame decoding too slow (" + String(decodeMicros) + " us)");
+    }
+
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        for (uint8_t x = 0; x < GRID_WIDTH; x++) {
+            (*_ledmatrix).gridAddPixel(x, y, _gif.canvas[y][x]);
+        }
+    }
+    _nextFrameTime += delay;
+    return true;
+}
+
+/**
+ * @brief Read next byte from the file (through the read-ahead buffer)
+ *
+ * @return int byte value, -1 at end of file
+ */
+int AnimationPlayer::readByte(){
+    if (_bufferPos >= _bufferLen) {
+        _bufferLen = _file.read(_buffer, ANIMPLAYER_BUFFER_SIZE);
+        _bufferPos = 0;
+        if (_bufferLen == 0) {
+            return -1;
+        }
+    }
+    return _buffer[_bufferPos++];
+}
+
+/**
+ * @brief Read next 16bit value (little endian) from the file
+ *
+ * @return int value, -1 at end of file
+ */
+int AnimationPlayer::readUInt16(){
+    int low = readByte();
+    int high = readByte();
+    if (low < 0 || high < 0) {
+        return -1;
+    }
+    return low | (high << 8);
+}
+
+/**
+ * @brief Set pixel with given index (row-major) to the color of the palette entry
+ *
+ * @param index index of the pixel
+ * @param paletteIndex index of the color in the palette
+ */
+void AnimationPlayer::setPixel(uint16_t index, uint8_t paletteIndex){
+    if (index >= GRID_WIDTH * GRID_HEIGHT || paletteIndex >= _paletteSize) {
+        return;
+    }
+    (*_ledmatrix).gridAddPixel(index % GRID_WIDTH, index / GRID_WIDTH,
+                               LEDMatrix::Color24bit(_palette[paletteIndex][0], _palette[paletteIndex][1], _palette[paletteIndex][2]));
+}
@@ -0,0 +1,99 @@
+/**
+ * @file animplayer.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for the animation player, which streams animations from LittleFS
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Animation file format (*.wca, all values little endian):
+ *
+ *   Header
+ *     char[4]  magic "WCA1"
+ *     uint8    width (must be GRID_WIDTH)
+ *     uint8    height (must be GRID_HEIGHT)
+ *     uint8    number of palette entries (0 = 256)
+ *     uint8    flags (bit 0: loop animation)
+ *     uint16   number of frames
+ *     uint8[3] palette entries (red, green, blue)
+ *
+ *   Frame (repeated)
+ *     uint16   duration in ms
+ *     uint8    frame type (0 = key frame, 1 = delta frame)
+ *     uint16   payload length in bytes
+ *     payload:
+ *       key frame:   pairs of (uint8 run length, uint8 palette index), covering
+ *                    all pixels in row-major order
+ *       delta frame: triples of (uint8 pixels to skip, uint8 run length, uint8 palette index),
+ *                    skipped pixels keep the color of the previous frame
+ *
+ * The first frame has to be a key frame. The file is read frame by frame
+ * through a small read-ahead buffer, so the memory usage does not depend on
+ * the length of the animation.
+ *
+ * Files ending with .gif are played with the streaming GifDecoder instead
+ * (always looped, frame delays taken from the file).
+ *
+ */
+#ifndef animplayer_h
+#define animplayer_h
+
+#include <Arduino.h>
+#include <FS.h>
+#include <LittleFS.h>
+#include "ledmatrix.h"
+#include "udplogger.h"
+#include "gifdecoder.h"
+#include "config.h"
+
+#define ANIMPLAYER_BUFFER_SIZE      64                  // size of read-ahead buffer in bytes
+#define ANIMPLAYER_DEFAULT_FILE     "/animation.wca"
+#define ANIMPLAYER_HEADER_SIZE      10
+#define ANIMPLAYER_FRAME_KEY        0
+#define ANIMPLAYER_FRAME_DELTA      1
+#define ANIMPLAYER_FLAG_LOOP        0x01
+
+class AnimationPlayer{
+
+    public:
+        AnimationPlayer();
+        AnimationPlayer(LEDMatrix *myledmatrix, UDPLogger *mylogger);
+        void setFile(String path);
+        String getFile();
+        void initGame();
+        void loopCycle();
+
+    private:
+        bool openFile();
+        void closeFile();
+        bool readFrame();
+        bool readGifFrame();
+        int readByte();
+        int readUInt16();
+        void setPixel(uint16_t index, uint8_t paletteIndex);
+
+        LEDMatrix *_ledmatrix;
+        UDPLogger *_logger;
+
+        String _path = ANIMPLAYER_DEFAULT_FILE;
+        File _file;
+        bool _open = false;
+        bool _isGif = false;
+        GifDecoder _gif;
+
+        // read-ahead buffer
+        uint8_t _buffer[ANIMPLAYER_BUFFER_SIZE];
+        uint8_t _bufferPos = 0;
+        uint8_t _bufferLen = 0;
+
+        uint8_t _palette[256][3];
+        uint16_t _paletteSize = 0;
+        uint8_t _flags = 0;
+        uint16_t _numFrames = 0;
+        uint16_t _currentFrame = 0;
+        uint32_t _firstFrameOffset = 0;
+        unsigned long _nextFrameTime = 0;
+};
+
+#endif
@@ -0,0 +1,379 @@
+/**
+ * @file breakout.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for breakout game
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "breakout.h"
+
+// color of the bricks per row
+static const uint32_t brickColors[BREAKOUT_BRICK_ROWS] = {0xFF0000, 0xFF8C00, 0xFFFF00};
+
+/**
+ * @brief Construct a new Breakout:: Breakout object
+ *
+ */
+Breakout::Breakout(){
+
+}
+
+/**
+ * @brief Construct a new Breakout:: Breakout object
+ *
+ * @param myledmatrix pointer to LEDMatrix object, the game is rendered to
+ * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
+ */
+Breakout::Breakout(LEDMatrix *myledmatrix, UDPLogger *mylogger) : Game(myledmatrix, mylogger, BREAKOUT_TICK_TIME){
+
+}
+
+/**
+ * @brief Simulate one tick (BREAKOUT_TICK_TIME) of the game
+ *
+ */
+void Breakout::update(){
+    if (_gameState != GAME_STATE_RUNNING) {
+        return;
+    }
+    takeInputs();
+    updatePaddle();
+    updateBall();
+    invalidate();
+}
+
+/**
+ * @brief Trigger control: LEFT (one paddle step)
+ *
+ */
+void Breakout::ctrlLeft(){
+    pushInput(INPUT_KEY_LEFT, INPUT_ACTION_TAP);
+}
+
+/**
+ * @brief Trigger control: RIGHT (one paddle step)
+ *
+ */
+void Breakout::ctrlRight(){
+    pushInput(INPUT_KEY_RIGHT, INPUT_ACTION_TAP);
+}
+
+/**
+ * @brief Trigger control: key pressed and held down, the paddle moves until the key is released
+ *
+ * @param key key {LEFT, RIGHT}
+ */
+void Breakout::ctrlPress(uint8_t key){
+    pushInput(key, INPUT_ACTION_PRESS);
+}
+
+/**
+ * @brief Trigger control: key released
+ *
+ * @param key key {LEFT, RIGHT}
+ */
+void Breakout::ctrlRelease(uint8_t key){
+    pushInput(key, INPUT_ACTION_RELEASE);
+}
+
+/**
+ * @brief Get number of remaining bricks
+ *
+ * @return uint8_t number of bricks
+ */
+uint8_t Breakout::getBrickCount(){
+    uint8_t count = 0;
+    for (uint8_t y = 0; y < BREAKOUT_BRICK_ROWS; y++) {
+        count += __builtin_popcount(_bricks[y]);
+    }
+    return count;
+}
+
+/**
+ * @brief Queue an input event, it is applied with the next tick
+ *
+ * @param key key of the event (INPUT_KEY_...)
+ * @param action action of the event {TAP, PRESS, RELEASE}
+ */
+void Breakout::pushInput(uint8_t key, uint8_t action){
+    if (!_inputs.push(key, action)) {
+        (*_logger).logString("Breakout: input queue full, " + String(_inputs.getDropped()) + " inputs dropped");
+    }
+}
+
+/**
+ * @brief Take over all queued inputs at the tick boundary
+ *
+ */
+void Breakout::takeInputs(){
+    InputEvent event;
+    while (popInput(event)) {
+        if (event.key != INPUT_KEY_LEFT && event.key != INPUT_KEY_RIGHT) {
+            continue;
+        }
+        if (event.action == INPUT_ACTION_TAP) {
+            _tapSteps = constrain(_tapSteps + (event.key == INPUT_KEY_RIGHT ? 1 : -1), -GRID_WIDTH, GRID_WIDTH);
+        }
+        else if (event.action == INPUT_ACTION_PRESS) {
+            _heldKey = event.key;
+            // first step right away
+            _nextPaddleTick = getTicks();
+        }
+        else if (event.key == _heldKey) {
+            _heldKey = INPUT_KEY_NONE;
+        }
+    }
+}
+
+/**
+ * @brief Initialize a new game
+ *
+ * @param bot true if the paddle is moved by the bot
+ */
+void Breakout::initGame(bool bot){
+    (*_logger).logString("Breakout: init" + String(bot ? " with bot" : ""));
+    startTime();
+    _inputs.clear();
+    _bot = bot;
+    _tapSteps = 0;
+    _heldKey = INPUT_KEY_NONE;
+    _bricksHit = 0;
+    _idleHits = 0;
+    _ballSpeed = BREAKOUT_BALL_SPEED_START;
+    startLevel();
+    setGameState(GAME_STATE_RUNNING);
+}
+
+/**
+ * @brief Fill all bricks and put the ball on the paddle
+ *
+ */
+void Breakout::startLevel(){
+    for (uint8_t y = 0; y < BREAKOUT_BRICK_ROWS; y++) {
+        _bricks[y] = BREAKOUT_BRICKS_FULL;
+    }
+    _paddle = (GRID_WIDTH - BREAKOUT_PADDLE_WIDTH) / 2;
+    _nextPaddleTick = 0;
+    _botAim = 0;
+    _ball.x = (GRID_WIDTH / 2) * COLLISION_FP_ONE;
+    _ball.y = (GRID_HEIGHT - 2) * COLLISION_FP_ONE;
+    _ball.vx = _ballSpeed / 2;
+    _ball.vy = -_ballSpeed;
+}
+
+/**
+ * @brief Move paddle one step (every BREAKOUT_PADDLE_TICKS)
+ *
+ */
+void Breakout::updatePaddle(){
+    if (getTicks() < _nextPaddleTick) {
+        return;
+    }
+    _nextPaddleTick = getTicks() + BREAKOUT_PADDLE_TICKS;
+    int8_t movement = getPaddleMovement();
+    if (movement < 0 && _paddle > 0) {
+        _paddle--;
+    }
+    else if (movement > 0 && _paddle + BREAKOUT_PADDLE_WIDTH < GRID_WIDTH) {
+        _paddle++;
+    }
+}
+
+/**
+ * @brief Get the next movement of the paddle from the bot or the inputs
+ *
+ * @return int8_t movement {-1: LEFT, 0: NONE, 1: RIGHT}
+ */
+int8_t Breakout::getPaddleMovement(){
+    if (_bot) {
+        // follow the ball, aim at the predicted position when it comes down
+        int16_t target = _ball.x;
+        if (_ball.vy > 0) {
+            target = predictBallX((GRID_HEIGHT - 2) * COLLISION_FP_ONE) + _botAim;
+        }
+        int16_t diff = target - (_paddle + BREAKOUT_PADDLE_WIDTH / 2) * COLLISION_FP_ONE;
+        if (diff > COLLISION_FP_HALF) {
+            return 1;
+        }
+        if (diff < -COLLISION_FP_HALF) {
+            return -1;
+        }
+        return 0;
+    }
+    if (_heldKey != INPUT_KEY_NONE) {
+        return (_heldKey == INPUT_KEY_RIGHT) ? 1 : -1;
+    }
+    if (_tapSteps > 0) {
+        _tapSteps--;
+        return 1;
+    }
+    if (_tapSteps < 0) {
+        _tapSteps++;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Move ball for one tick, reflect it on the bricks, walls and paddle
+ *
+ */
+void Breakout::updateBall(){
+    FpBall oldBall = _ball;
+    _ball.move();
+
+    // bricks, after a reflection the rest of the movement is checked again (max. one reflection per axis)
+    for (uint8_t i = 0; i < 2; i++) {
+        CellHit hit;
+        if (!fpSweepCells(oldBall.x, oldBall.y, _ball.x, _ball.y, [this](int8_t x, int8_t y) { return isBrick(x, y); }, hit)) {
+            break;
+        }
+        removeBrick(hit.x, hit.y);
+        fpReflectCellHit(_ball, hit);
+    }
+
+    // side walls and ceiling
+    fpReflectRange(_ball.x, _ball.vx, 0, (GRID_WIDTH - 1) * COLLISION_FP_ONE);
+    if (_ball.y < 0) {
+        fpReflect(_ball.y, _ball.vy, 0);
+    }
+
+    if (!checkPaddleHit(oldBall) && _ball.y > (GRID_HEIGHT - 1) * COLLISION_FP_ONE) {
+        _ball.y = (GRID_HEIGHT - 1) * COLLISION_FP_ONE;
+        endGame();
+        return;
+    }
+
+    if (getBrickCount() == 0) {
+        // next level with faster ball
+        setLevel(getLevel() + 1);
+        _ballSpeed = min(_ballSpeed + BREAKOUT_BALL_SPEED_LEVEL, BREAKOUT_BALL_SPEED_MAX);
+        (*_logger).logString("Breakout: level " + String(getLevel()));
+        startLevel();
+    }
+}
+
+/**
+ * @brief Check if the ball crossed the paddle plane during the last tick and hit the paddle.
+ * On a hit the ball is reflected, the angle depends on where the paddle was hit.
+ *
+ * @param oldBall ball before this tick
+ * @return true if the paddle was hit
+ */
+bool Breakout::checkPaddleHit(const FpBall &oldBall){
+    // plane the ball center reaches when touching the paddle
+    const int16_t planeY = (GRID_HEIGHT - 2) * COLLISION_FP_ONE;
+    if (_ball.vy <= 0 || !fpCrossed(oldBall.y, _ball.y, planeY)) {
+        return false;
+    }
+    int16_t crossX = fpCrossingAt(oldBall.y, _ball.y, oldBall.x, _ball.x, planeY);
+    int16_t offset = crossX - (_paddle + BREAKOUT_PADDLE_WIDTH / 2) * COLLISION_FP_ONE;
+    const int16_t halfPaddle = BREAKOUT_PADDLE_WIDTH * COLLISION_FP_ONE / 2;
+    if (offset < -halfPaddle || offset > halfPaddle) {
+        return false;
+    }
+    fpReflect(_ball.y, _ball.vy, planeY);
+    _ball.vy = -_ballSpeed;
+
+    // hit at the edge of the paddle deflects by 45deg, part of the old horizontal speed is kept
+    int16_t vx = _ball.vx / 4 + (int32_t)_ballSpeed * offset / halfPaddle;
+    if (++_idleHits >= BREAKOUT_MAX_IDLE_HITS) {
+        // the ball misses all bricks (periodic path), deflect it randomly
+        vx += random(-_ballSpeed / 2, _ballSpeed / 2 + 1);
+        _idleHits = 0;
+    }
+    _ball.vx = constrain(vx, -_ballSpeed * 3 / 2, _ballSpeed * 3 / 2);
+
+    // the bot aims at a new position on its paddle, so the ball will be deflected
+    _botAim = random(-COLLISION_FP_ONE, COLLISION_FP_ONE + 1);
+    return true;
+}
+
+/**
+ * @brief Check if there is a brick in a cell
+ *
+ * @param x column
+ * @param y row
+ * @return true if there is a brick
+ */
+bool Breakout::isBrick(int8_t x, int8_t y){
+    if (x < 0 || x >= GRID_WIDTH || y < 0 || y >= BREAKOUT_BRICK_ROWS) {
+        return false;
+    }
+    return (_bricks[y] >> x) & 1;
+}
+
+/**
+ * @brief Remove a brick which was hit
+ *
+ * @param x column
+ * @param y row
+ */
+void Breakout::removeBrick(int8_t x, int8_t y){
+    _bricks[y] &= ~(1 << x);
+    _bricksHit++;
+    _idleHits = 0;
+    setScore(_bricksHit);
+}
+
+/**
+ * @brief Predict the x position of the ball when it reaches the given y position (including reflections on the side walls)
+ *
+ * @param planeY y position in 1/256 cells
+ * @return int16_t x position in 1/256 cells
+ */
+int16_t Breakout::predictBallX(int16_t planeY){
+    if (_ball.vy == 0) {
+        return _ball.x;
+    }
+    int32_t ticks = (int32_t)(planeY - _ball.y) / _ball.vy;
+    const int32_t maxX = (GRID_WIDTH - 1) * COLLISION_FP_ONE;
+    // unfold the reflections: position on a line with period 2 * maxX
+    int32_t x = ((_ball.x + (int32_t)_ball.vx * ticks) % (2 * maxX) + 2 * maxX) % (2 * maxX);
+    return (x > maxX) ? 2 * maxX - x : x;
+}
+
+/**
+ * @brief Game over, ball is drawn red
+ *
+ */
+void Breakout::endGame(){
+    (*_logger).logString("Breakout: Game ended after " + String(getTicks() * BREAKOUT_TICK_TIME / 1000) + " s, " +
+                         String(_bricksHit) + " bricks, level " + String(getLevel()));
+    setGameState(GAME_STATE_END);
+}
+
+/**
+ * @brief Get variant of the game for a replay
+ *
+ * @return uint8_t 1 if the paddle is moved by the bot
+ */
+uint8_t Breakout::getVariant(){
+    return _bot ? 1 : 0;
+}
+
+/**
+ * @brief Draw bricks, paddle and ball
+ *
+ * @param framebuffer target of drawing
+ */
+void Breakout::render(Framebuffer &framebuffer){
+    framebuffer.gridFlush();
+    if (_gameState == GAME_STATE_READY) {
+        return;
+    }
+    for (uint8_t y = 0; y < BREAKOUT_BRICK_ROWS; y++) {
+        for (uint8_t x = 0; x < GRID_WIDTH; x++) {
+            if ((_bricks[y] >> x) & 1) {
+                framebuffer.gridAddPixel(x, y, brickColors[y]);
+            }
+        }
+    }
+    for (uint8_t i = 0; i < BREAKOUT_PADDLE_WIDTH; i++) {
+        framebuffer.gridAddPixel(_paddle + i, GRID_HEIGHT - 1, BREAKOUT_COLOR_PADDLE);
+    }
+    framebuffer.drawPoint(_ball.x, _ball.y, _gameState == GAME_STATE_END ? BREAKOUT_COLOR_BALL_END : BREAKOUT_COLOR_BALL);
+}
@@ -0,0 +1,87 @@
+/**
+ * @file breakout.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for breakout game
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The paddle is on the bottom row, the bricks fill the top rows. The ball
+ * physics is the same as in Pong (fixed-point ball, fixed timestep, see
+ * collision2d.h): the bricks are hit with a swept cell test, so the ball
+ * never tunnels through a brick. The bricks are a bitset per row.
+ * When all bricks are cleared the next level starts with a faster ball.
+ * A ball which only bounces between the paddle and the walls (e.g. from
+ * corner to corner) gets a random deflection, so every game ends.
+ *
+ */
+#ifndef breakout_h
+#define breakout_h
+
+#include <Arduino.h>
+#include "ledmatrix.h"
+#include "udplogger.h"
+#include "inputqueue.h"
+#include "game.h"
+#include "collision2d.h"
+#include "config.h"
+
+#define BREAKOUT_TICK_TIME          10  // in ms, fixed timestep of the simulation
+#define BREAKOUT_PADDLE_TICKS        8  // ticks per paddle step (= 80ms)
+#define BREAKOUT_PADDLE_WIDTH        3
+#define BREAKOUT_BRICK_ROWS          3
+#define BREAKOUT_BALL_SPEED_START   10  // vertical speed in 1/256 cells per tick
+#define BREAKOUT_BALL_SPEED_MAX     40  // vertical speed in 1/256 cells per tick
+#define BREAKOUT_BALL_SPEED_LEVEL    4  // speedup per level
+#define BREAKOUT_MAX_IDLE_HITS      10  // paddle hits without a brick hit after which the reflection is varied
+#define BREAKOUT_BRICKS_FULL        ((uint16_t)((1 << GRID_WIDTH) - 1))
+
+#define BREAKOUT_COLOR_PADDLE       0x005050
+#define BREAKOUT_COLOR_BALL         0x006400
+#define BREAKOUT_COLOR_BALL_END     0x780000
+
+class Breakout : public Game{
+
+    public:
+        Breakout();
+        Breakout(LEDMatrix *myledmatrix, UDPLogger *mylogger);
+        void initGame(bool bot);
+        void render(Framebuffer &framebuffer) override;
+        uint8_t getVariant() override;
+        void ctrlLeft();
+        void ctrlRight();
+        void ctrlPress(uint8_t key);
+        void ctrlRelease(uint8_t key);
+        uint8_t getBrickCount();
+
+    protected:
+        void update() override;
+
+    private:
+        bool _bot = false;
+        uint16_t _bricks[BREAKOUT_BRICK_ROWS];  // bit x is the brick in column x
+        uint8_t _paddle = 0;                    // x position of the leftmost paddle pixel
+        FpBall _ball;
+        int16_t _ballSpeed = BREAKOUT_BALL_SPEED_START;
+        int16_t _botAim = 0;                    // offset of paddle center to the predicted ball position
+        uint16_t _bricksHit = 0;
+        uint8_t _idleHits = 0;                  // paddle hits since the last brick hit
+        uint32_t _nextPaddleTick = 0;
+        int8_t _tapSteps = 0;                   // pending paddle steps of tapped inputs (> 0: RIGHT, < 0: LEFT)
+        uint8_t _heldKey = INPUT_KEY_NONE;
+
+        void startLevel();
+        void pushInput(uint8_t key, uint8_t action);
+        void takeInputs();
+        void updatePaddle();
+        int8_t getPaddleMovement();
+        void updateBall();
+        bool checkPaddleHit(const FpBall &oldBall);
+        bool isBrick(int8_t x, int8_t y);
+        void removeBrick(int8_t x, int8_t y);
+        int16_t predictBallX(int16_t planeY);
+        void endGame();
+};
+
+#endif
@@ -0,0 +1,49 @@
+/**
+ * @file changebus.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for the notification bus of changed settings (mode, nightmode, brightness, colors)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "changebus.h"
+
+/**
+ * @brief Construct a new ChangeBus:: ChangeBus object
+ *
+ */
+ChangeBus::ChangeBus(){
+
+}
+
+/**
+ * @brief Set the changes the subscribers listen to, pending changes nobody listens to anymore are dropped
+ *
+ * @param changes CHANGE_... flags, 0 if there is no subscriber
+ */
+void ChangeBus::setSubscriptions(uint8_t changes){
+    _subscriptions = changes;
+    _pending &= changes;
+}
+
+/**
+ * @brief Notify a change, does nothing if nobody listens to it
+ *
+ * @param changes CHANGE_... flags
+ */
+void ChangeBus::notify(uint8_t changes){
+    _pending |= changes & _subscriptions;
+}
+
+/**
+ * @brief Take the changes notified since the last call
+ *
+ * @return uint8_t CHANGE_... flags, 0 if nothing changed
+ */
+uint8_t ChangeBus::take(){
+    uint8_t changes = _pending;
+    _pending = 0;
+    return changes;
+}
@@ -0,0 +1,42 @@
+/**
+ * @file changebus.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for the notification bus of changed settings (mode, nightmode, brightness, colors)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The code which changes a setting calls notify() with the CHANGE_... flags of
+ * it. The bus only collects the flags the subscribers are interested in
+ * (setSubscriptions()), so a notification is a single AND/OR and nothing is
+ * collected while nobody listens. The subscriber takes the collected flags in
+ * the main loop (take()) and sends the changed settings once, no matter how
+ * often they changed in between.
+ *
+ */
+#ifndef changebus_h
+#define changebus_h
+
+#include <Arduino.h>
+
+#define CHANGE_MODE         0x01    // current mode or automatic mode change
+#define CHANGE_NIGHTMODE    0x02    // nightmode on/off or its start/end time
+#define CHANGE_BRIGHTNESS   0x04
+#define CHANGE_COLOR        0x08    // colors of the clock
+#define CHANGE_ALL          0x0F
+
+class ChangeBus{
+
+    public:
+        ChangeBus();
+        void setSubscriptions(uint8_t changes);
+        void notify(uint8_t changes);
+        uint8_t take();
+
+    private:
+        uint8_t _subscriptions = 0;     // CHANGE_... flags somebody listens to
+        uint8_t _pending = 0;           // CHANGE_... flags notified since the last take()
+};
+
+#endif
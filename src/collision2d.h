@@ -0,0 +1,196 @@
+/**
+ * @file collision2d.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Fixed-point collision and reflection of a ball with planes, ranges and grid cells (used by Pong and Breakout)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Positions are fixed-point values in 1/256 of a cell (Q8.8), the center of
+ * cell n is at n * COLLISION_FP_ONE, so cell n covers [n - 1/2, n + 1/2).
+ * The ball is handled as its center point, the game defines the planes and
+ * cells the center must not pass.
+ *
+ * All tests are swept: they check the segment the ball moved along during one
+ * tick, not only its new position, so a fast ball can not tunnel through a
+ * paddle or a brick.
+ *
+ */
+#ifndef collision2d_h
+#define collision2d_h
+
+#include <Arduino.h>
+
+#define COLLISION_FP_ONE    256     // fixed-point representation of one cell
+#define COLLISION_FP_HALF   128
+
+#define COLLISION_AXIS_X    0       // vertical boundary was crossed, x velocity is reflected
+#define COLLISION_AXIS_Y    1       // horizontal boundary was crossed, y velocity is reflected
+
+struct FpBall {
+    int16_t x, y;       // position in 1/256 cells, cell center at integer position
+    int16_t vx, vy;     // velocity in 1/256 cells per tick
+
+    // move one tick
+    inline void move() { x += vx; y += vy; }
+};
+
+struct CellHit {
+    int8_t x, y;        // cell which was hit
+    uint8_t axis;       // COLLISION_AXIS_X or COLLISION_AXIS_Y
+    int16_t boundary;   // position of the crossed cell boundary on that axis
+};
+
+/**
+ * @brief Get the cell of a position
+ *
+ * @param pos position in 1/256 cells
+ * @return int8_t cell index (can be negative)
+ */
+inline int8_t fpCell(int16_t pos)
+{
+    return (int16_t)(pos + COLLISION_FP_HALF) >> 8;
+}
+
+/**
+ * @brief Check if a movement from pos0 to pos1 crossed (or touched) the plane
+ *
+ * @param pos0 position before the movement
+ * @param pos1 position after the movement
+ * @param plane position of the plane
+ * @return true if the plane was crossed in direction of the movement
+ */
+inline bool fpCrossed(int16_t pos0, int16_t pos1, int16_t plane)
+{
+    return (pos0 < pos1) ? (pos0 <= plane && pos1 > plane) : (pos0 >= plane && pos1 < plane);
+}
+
+/**
+ * @brief Get the position on the other axis at which a movement crossed a plane
+ *
+ * @param a0 position on the axis of the plane before the movement
+ * @param a1 position on the axis of the plane after the movement, must differ from a0
+ * @param b0 position on the other axis before the movement
+ * @param b1 position on the other axis after the movement
+ * @param plane position of the plane
+ * @return int16_t position on the other axis at the crossing
+ */
+inline int16_t fpCrossingAt(int16_t a0, int16_t a1, int16_t b0, int16_t b1, int16_t plane)
+{
+    return b0 + (int32_t)(b1 - b0) * (a0 - plane) / (a0 - a1);
+}
+
+/**
+ * @brief Mirror position and velocity at a plane
+ *
+ * @param pos position, which has passed the plane
+ * @param vel velocity
+ * @param plane position of the plane
+ */
+inline void fpReflect(int16_t &pos, int16_t &vel, int16_t plane)
+{
+    pos = 2 * plane - pos;
+    vel = -vel;
+}
+
+/**
+ * @brief Keep a position within a range by reflecting at its borders (walls)
+ *
+ * @param pos position
+ * @param vel velocity
+ * @param min lower border
+ * @param max upper border
+ * @return true if the position was reflected
+ */
+inline bool fpReflectRange(int16_t &pos, int16_t &vel, int16_t min, int16_t max)
+{
+    if (pos < min) {
+        fpReflect(pos, vel, min);
+        return true;
+    }
+    if (pos > max) {
+        fpReflect(pos, vel, max);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Walk along the segment (x0, y0) -> (x1, y1) through all cells it touches (grid DDA)
+ * and find the first solid cell which is entered. The start cell is not tested.
+ *
+ * @param x0 start position x
+ * @param y0 start position y
+ * @param x1 end position x
+ * @param y1 end position y
+ * @param isSolid functor bool(int8_t x, int8_t y), true if the cell can not be entered
+ * @param hit first solid cell, axis and position of the crossed boundary
+ * @return true if a solid cell was hit
+ */
+template <class Solid>
+bool fpSweepCells(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Solid isSolid, CellHit &hit)
+{
+    int16_t dx = x1 - x0;
+    int16_t dy = y1 - y0;
+    int8_t stepX = (dx > 0) - (dx < 0);
+    int8_t stepY = (dy > 0) - (dy < 0);
+    int8_t cx = fpCell(x0);
+    int8_t cy = fpCell(y0);
+    int8_t endX = fpCell(x1);
+    int8_t endY = fpCell(y1);
+    // next boundary in direction of the movement
+    int16_t bx = cx * COLLISION_FP_ONE + stepX * COLLISION_FP_HALF;
+    int16_t by = cy * COLLISION_FP_ONE + stepY * COLLISION_FP_HALF;
+
+    while (cx != endX || cy != endY) {
+        // compare the fractions of the segment until the next boundaries: |bx - x0| / |dx| < |by - y0| / |dy|
+        bool nextX;
+        if (cx == endX) {
+            nextX = false;
+        }
+        else if (cy == endY) {
+            nextX = true;
+        }
+        else {
+            nextX = (int32_t)abs(bx - x0) * abs(dy) <= (int32_t)abs(by - y0) * abs(dx);
+        }
+
+        if (nextX) {
+            cx += stepX;
+            if (isSolid(cx, cy)) {
+                hit = {cx, cy, COLLISION_AXIS_X, bx};
+                return true;
+            }
+            bx += stepX * COLLISION_FP_ONE;
+        }
+        else {
+            cy += stepY;
+            if (isSolid(cx, cy)) {
+                hit = {cx, cy, COLLISION_AXIS_Y, by};
+                return true;
+            }
+            by += stepY * COLLISION_FP_ONE;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Reflect the ball at the boundary of a cell hit by fpSweepCells(), the ball stays in the cell it came from
+ *
+ * @param ball ball, which has moved into the cell
+ * @param hit cell hit
+ */
+inline void fpReflectCellHit(FpBall &ball, const CellHit &hit)
+{
+    int16_t &pos = (hit.axis == COLLISION_AXIS_X) ? ball.x : ball.y;
+    int16_t &vel = (hit.axis == COLLISION_AXIS_X) ? ball.vx : ball.vy;
+    fpReflect(pos, vel, hit.boundary);
+    if (vel < 0) {
+        // the boundary itself belongs to the cell with the higher index, which was hit
+        pos = min(pos, (int16_t)(hit.boundary - 1));
+    }
+}
+
+#endif
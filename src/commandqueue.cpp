@@ -0,0 +1,76 @@
+/**
+ * @file commandqueue.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for a bounded lock-free queue of web commands (single producer, single consumer)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "commandqueue.h"
+
+/**
+ * @brief Construct a new CommandQueue:: CommandQueue object
+ *
+ */
+CommandQueue::CommandQueue() : _head(0), _tail(0), _dropped(0){
+
+}
+
+/**
+ * @brief Push a command (producer side), too long names or values are cut
+ *
+ * @param name name of the command
+ * @param value value of the command
+ * @param received time (micros) the command was received
+ * @return true if the command was queued, false if the queue is full
+ */
+bool CommandQueue::push(const String &name, const String &value, unsigned long received){
+    uint8_t tail = _tail.load(std::memory_order_relaxed);
+    if ((uint8_t)(tail - _head.load(std::memory_order_acquire)) >= COMMAND_QUEUE_SIZE) {
+        _dropped++;
+        return false;
+    }
+    Command &command = _commands[tail & (COMMAND_QUEUE_SIZE - 1)];
+    command.received = received;
+    strlcpy(command.name, name.c_str(), COMMAND_NAME_SIZE);
+    strlcpy(command.value, value.c_str(), COMMAND_VALUE_SIZE);
+    // publish the command after it is written completely
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Remove and get the oldest command (consumer side)
+ *
+ * @param command oldest command
+ * @return true if there was a command
+ */
+bool CommandQueue::pop(Command &command){
+    uint8_t head = _head.load(std::memory_order_relaxed);
+    if (head == _tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    command = _commands[head & (COMMAND_QUEUE_SIZE - 1)];
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Get number of queued commands
+ *
+ * @return uint8_t number of commands
+ */
+uint8_t CommandQueue::size(){
+    return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Get number of commands which were dropped because the queue was full
+ *
+ * @return uint16_t number of dropped commands
+ */
+uint16_t CommandQueue::getDropped(){
+    return _dropped;
+}
@@ -0,0 +1,48 @@
+/**
+ * @file commandqueue.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for a bounded lock-free queue of web commands (single producer, single consumer)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The request handlers of the async webserver run in the task of the TCP
+ * stack, so they must not touch the LEDs or the modes. They only push the
+ * command (name and value of the first parameter) with the time it was
+ * received, the main loop pops and executes the commands in order.
+ *
+ */
+#ifndef commandqueue_h
+#define commandqueue_h
+
+#include <Arduino.h>
+#include <atomic>
+
+#define COMMAND_QUEUE_SIZE      16      // has to be a power of two
+#define COMMAND_NAME_SIZE       16      // max. length of a name + 1
+#define COMMAND_VALUE_SIZE      48      // max. length of a value + 1
+
+struct Command {
+    unsigned long received;             // time (micros) the command was received
+    char name[COMMAND_NAME_SIZE];
+    char value[COMMAND_VALUE_SIZE];
+};
+
+class CommandQueue{
+
+    public:
+        CommandQueue();
+        bool push(const String &name, const String &value, unsigned long received);
+        bool pop(Command &command);
+        uint8_t size();
+        uint16_t getDropped();
+
+    private:
+        Command _commands[COMMAND_QUEUE_SIZE];
+        std::atomic<uint8_t> _head;     // written by consumer only
+        std::atomic<uint8_t> _tail;     // written by producer only
+        std::atomic<uint16_t> _dropped;
+};
+
+#endif
@@ -34,12 +34,19 @@
 #define PERIOD_TETRIS 50
 #define PERIOD_SNAKE 50
 #define PERIOD_PONG 10
+#define PERIOD_LIFE 500
+#define PERIOD_PARTICLES 33
+#define PERIOD_PLAYER 10
+#define PERIOD_KERNEL 40
+#define PERIOD_BREAKOUT 10
 #define TIMEOUT_LEDDIRECT 5000
 #define PERIOD_STATECHANGE 10000
 #define PERIOD_NTPUPDATE 30000
 #define PERIOD_TIMEVISUUPDATE 1000
 #define PERIOD_MATRIXUPDATE 100
 #define PERIOD_NIGHTMODECHECK 20000
+#define PERIOD_WEBSOCKETSTATE 100
+#define PERIOD_DATASNAPSHOT 200
 
 #define SHORTPRESS 100
 #define LONGPRESS 2000
@@ -0,0 +1,245 @@
+/**
+ * @file ddpreceiver.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for receiving realtime pixel frames via DDP (Distributed Display Protocol, UDP port 4048)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "ddpreceiver.h"
+
+/**
+ * @brief Construct a new DDPReceiver:: DDPReceiver object
+ *
+ * @param myledmatrix pointer to LEDMatrix object, the frames are written into its grid
+ * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
+ */
+DDPReceiver::DDPReceiver(LEDMatrix *myledmatrix, UDPLogger *mylogger){
+    _ledmatrix = myledmatrix;
+    _logger = mylogger;
+}
+
+/**
+ * @brief Start listening for DDP packets, call once in setup (after WiFi is connected)
+ *
+ * @param port UDP port
+ */
+void DDPReceiver::begin(uint16_t port){
+    _started = _udp.begin(port);
+    (*_logger).logString("DDP: listening on port " + String(port) + (_started ? "" : " failed"));
+}
+
+/**
+ * @brief Run main loop for one cycle: read the waiting packets and show the latest complete frame
+ *
+ */
+void DDPReceiver::loopCycle(){
+    if (!_started) {
+        return;
+    }
+    for (uint8_t i = 0; i < DDP_MAX_PACKETS_PER_CYCLE; i++) {
+        int length = _udp.parsePacket();
+        if (length <= 0) {
+            break;
+        }
+        _packets++;
+        if (_paused) {
+            _udp.flush();
+            _ignored++;
+            continue;
+        }
+        if (!handlePacket(length)) {
+            _invalid++;
+        }
+    }
+    if (_pushPending) {
+        show();
+    }
+    if (_active && millis() - _lastFrame > _timeout) {
+        // sender stopped, the next sender may start with any sequence number
+        _active = false;
+        _receiving = false;
+        _lastSequence = 0;
+        (*_logger).logString("DDP: no frames for " + String(_timeout) + " ms, back to normal mode");
+    }
+}
+
+/**
+ * @brief Check if frames are received (the normal mode has to pause)
+ *
+ * @return true if the last frame was shown within the timeout
+ */
+bool DDPReceiver::isActive(){
+    return _active;
+}
+
+/**
+ * @brief Set the time without frames after which the normal mode resumes
+ *
+ * @param timeout timeout in ms
+ */
+void DDPReceiver::setTimeout(unsigned long timeout){
+    _timeout = timeout;
+}
+
+/**
+ * @brief Pause or resume drawing the received frames, while paused the packets are dropped
+ *
+ * @param paused true to pause (night mode)
+ */
+void DDPReceiver::setPaused(bool paused){
+    if (paused == _paused) {
+        return;
+    }
+    _paused = paused;
+    if (paused) {
+        // drop the frame in progress, the sender starts again after the pause
+        _active = false;
+        _receiving = false;
+        _pushPending = false;
+        _lastSequence = 0;
+    }
+    (*_logger).logString(String("DDP: ") + (paused ? "paused" : "resumed"));
+}
+
+/**
+ * @brief Clear the statistics
+ *
+ */
+void DDPReceiver::resetStats(){
+    _packets = 0;
+    _frames = 0;
+    _skipped = 0;
+    _late = 0;
+    _lost = 0;
+    _invalid = 0;
+    _ignored = 0;
+    _latency.reset();
+}
+
+/**
+ * @brief Get the state and statistics as JSON object
+ *
+ * @return String JSON object
+ */
+String DDPReceiver::getJSON(){
+    String message = "{";
+    message += "\"active\":\"" + String(_active) + "\"";
+    message += ",\"timeout\":\"" + String(_timeout) + "\"";
+    message += ",\"packets\":\"" + String(_packets) + "\"";
+    message += ",\"frames\":\"" + String(_frames) + "\"";
+    message += ",\"skipped\":\"" + String(_skipped) + "\"";
+    message += ",\"late\":\"" + String(_late) + "\"";
+    message += ",\"lost\":\"" + String(_lost) + "\"";
+    message += ",\"invalid\":\"" + String(_invalid) + "\"";
+    message += ",\"ignored\":\"" + String(_ignored) + "\"";
+    message += ",\"latency\":" + _latency.getJSON();
+    message += "}";
+    return message;
+}
+
+/**
+ * @brief Read a packet and write its pixels into the grid
+ *
+ * @param length length of the packet
+ * @return false if the packet is invalid
+ */
+bool DDPReceiver::handlePacket(int length){
+    unsigned long received = micros();
+    int size = _udp.read(_packet, min(length, (int)sizeof(_packet)));
+    if (size < DDP_HEADER_SIZE) {
+        return false;
+    }
+    uint8_t flags = _packet[0];
+    if ((flags & DDP_FLAGS_VERSION_MASK) != DDP_FLAGS_VERSION_1) {
+        return false;
+    }
+    if ((flags & DDP_FLAGS_QUERY) || _packet[3] != DDP_ID_DISPLAY) {
+        // status/config queries and other destinations are not supported, ignore them
+        return true;
+    }
+    if (!checkSequence(_packet[1] & 0x0F)) {
+        _late++;
+        return true;
+    }
+    uint32_t offset = ((uint32_t)_packet[4] << 24) | ((uint32_t)_packet[5] << 16) | ((uint32_t)_packet[6] << 8) | _packet[7];
+    uint16_t dataLength = ((uint16_t)_packet[8] << 8) | _packet[9];
+    int headerSize = DDP_HEADER_SIZE + ((flags & DDP_FLAGS_TIMECODE) ? DDP_TIMECODE_SIZE : 0);
+    if (offset % 3 != 0 || dataLength % 3 != 0 || headerSize + dataLength > length || size < headerSize) {
+        return false;
+    }
+
+    if (_pushPending) {
+        if (flags & DDP_FLAGS_PUSH) {
+            // a newer complete frame arrived before the previous one was shown
+            _skipped++;
+        }
+        else {
+            // the next frame comes in several packets, show the complete one before it is overwritten
+            show();
+        }
+    }
+    if (!_receiving) {
+        _receiving = true;
+        _frameReceived = received;
+    }
+
+    // pixels beyond the frame are not read (see _packet)
+    uint32_t pixel = offset / 3;
+    uint16_t count = min((int)dataLength, size - headerSize) / 3;
+    const uint8_t *data = _packet + headerSize;
+    for (uint16_t i = 0; i < count && pixel < DDP_FRAME_PIXELS; i++, pixel++, data += 3) {
+        uint32_t color = LEDMatrix::Color24bit(data[0], data[1], data[2]);
+        if (pixel < GRID_WIDTH * GRID_HEIGHT) {
+            _ledmatrix->gridAddPixel(pixel % GRID_WIDTH, pixel / GRID_WIDTH, color);
+        }
+        else {
+            _ledmatrix->setIndicator(pixel - GRID_WIDTH * GRID_HEIGHT, color);
+        }
+    }
+
+    if (flags & DDP_FLAGS_PUSH) {
+        _pushPending = true;
+        _pushReceived = _frameReceived;
+        _receiving = false;
+    }
+    return true;
+}
+
+/**
+ * @brief Check the sequence number of a packet and count the packets lost before it
+ *
+ * @param sequence sequence number (1..15, 0 if not used by the sender)
+ * @return false if the packet arrived late (behind the last sequence number)
+ */
+bool DDPReceiver::checkSequence(uint8_t sequence){
+    if (sequence == 0 || _lastSequence == 0) {
+        _lastSequence = sequence;
+        return true;
+    }
+    uint8_t ahead = (sequence + 15 - _lastSequence) % 15;
+    if (ahead == 0 || ahead >= 15 - DDP_SEQUENCE_WINDOW) {
+        return false;
+    }
+    _lost += ahead - 1;
+    _lastSequence = sequence;
+    return true;
+}
+
+/**
+ * @brief Show the complete frame
+ *
+ */
+void DDPReceiver::show(){
+    _ledmatrix->drawOnMatrixInstant();
+    _latency.add(micros() - _pushReceived);
+    _frames++;
+    _pushPending = false;
+    _lastFrame = millis();
+    if (!_active) {
+        _active = true;
+        (*_logger).logString("DDP: receiving frames from " + _udp.remoteIP().toString());
+    }
+}
@@ -0,0 +1,96 @@
+/**
+ * @file ddpreceiver.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for receiving realtime pixel frames via DDP (Distributed Display Protocol, UDP port 4048)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Packet (all values big endian):
+ *
+ *   header  (10 bytes): flags (version 1, timecode, push), sequence number (low 4 bits, 1..15, 0 = not used),
+ *                       data type, destination id (1 = display), data offset in bytes (uint32), data length (uint16)
+ *   timecode (4 bytes): only if the timecode flag is set, ignored
+ *   data              : 3 bytes red, green, blue per pixel, the grid row by row followed by the minute indicators
+ *
+ * The pixels are written into the grid of the matrix as the packets arrive,
+ * the packet with the push flag shows the frame. loopCycle() reads all
+ * waiting packets before it shows a frame, so a frame which is already
+ * outdated by a newer one is skipped instead of delaying it. A packet whose
+ * sequence number is behind the last one arrived late and is dropped, a gap
+ * in the sequence numbers is counted as lost packets.
+ *
+ * While frames arrive the receiver is active and the normal mode pauses,
+ * it resumes after the timeout without frames. During the night mode the
+ * receiver is paused: the packets are read and dropped, nothing is drawn.
+ *
+ */
+#ifndef ddpreceiver_h
+#define ddpreceiver_h
+
+#include <Arduino.h>
+#include <WiFiUdp.h>
+#include "ledmatrix.h"
+#include "latencyhistogram.h"
+#include "udplogger.h"
+
+#define DDP_PORT                    4048
+#define DDP_HEADER_SIZE             10
+#define DDP_TIMECODE_SIZE           4
+#define DDP_FLAGS_VERSION_MASK      0xC0
+#define DDP_FLAGS_VERSION_1         0x40
+#define DDP_FLAGS_TIMECODE          0x10
+#define DDP_FLAGS_QUERY             0x02
+#define DDP_FLAGS_PUSH              0x01
+#define DDP_ID_DISPLAY              1
+#define DDP_SEQUENCE_WINDOW         7       // a sequence number up to 7 behind the last one is late
+#define DDP_DEFAULT_TIMEOUT         2500    // in ms, fall back to the normal mode without frames
+#define DDP_MAX_PACKETS_PER_CYCLE   16      // bound the time of one loopCycle()
+
+#define DDP_FRAME_PIXELS            (GRID_WIDTH * GRID_HEIGHT + NUM_MIN_INDICATORS)
+
+class DDPReceiver{
+
+    public:
+        DDPReceiver(LEDMatrix *myledmatrix, UDPLogger *mylogger);
+        void begin(uint16_t port = DDP_PORT);
+        void loopCycle();
+        bool isActive();
+        void setTimeout(unsigned long timeout);
+        void setPaused(bool paused);
+        void resetStats();
+        String getJSON();
+
+    private:
+        bool handlePacket(int length);
+        bool checkSequence(uint8_t sequence);
+        void show();
+
+        LEDMatrix *_ledmatrix;
+        UDPLogger *_logger;
+        WiFiUDP _udp;
+        uint8_t _packet[DDP_HEADER_SIZE + DDP_TIMECODE_SIZE + DDP_FRAME_PIXELS * 3];  // data beyond the frame is not read
+        bool _started = false;
+        bool _paused = false;                   // packets are dropped (night mode)
+        unsigned long _timeout = DDP_DEFAULT_TIMEOUT;
+        unsigned long _lastFrame = 0;           // time (millis) the last frame was shown
+        bool _active = false;
+        uint8_t _lastSequence = 0;              // 0 if no sequence number received yet
+        bool _receiving = false;                // packets of a frame were received, push is pending
+        unsigned long _frameReceived = 0;       // time (micros) the first packet of the frame was received
+        bool _pushPending = false;              // a frame is complete, but not shown yet
+        unsigned long _pushReceived = 0;        // time (micros) the first packet of the complete frame was received
+
+        // statistics
+        uint32_t _packets = 0;
+        uint32_t _frames = 0;                   // frames shown
+        uint32_t _skipped = 0;                  // frames replaced by a newer frame before they were shown
+        uint32_t _late = 0;                     // packets dropped because they arrived after newer ones
+        uint32_t _lost = 0;                     // packets missing in the sequence
+        uint32_t _invalid = 0;
+        uint32_t _ignored = 0;                  // packets dropped while paused
+        LatencyHistogram _latency;              // time from receiving the first packet of a frame until it is shown
+};
+
+#endif
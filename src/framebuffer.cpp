@@ -0,0 +1,87 @@
+/**
+ * @file framebuffer.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Common drawing functions of all framebuffers
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "framebuffer.h"
+#include "own_font.h"
+
+/**
+ * @brief Shows a 1-digit number on the grid (5x3)
+ *
+ * @param xpos x of left top corner of digit
+ * @param ypos y of left top corner of digit
+ * @param number number to display
+ * @param color color to display (24bit)
+ */
+void Framebuffer::printNumber(uint8_t xpos, uint8_t ypos, uint8_t number, uint32_t color)
+{
+  for (int y = ypos, i = 0; y < (ypos + 5); y++, i++)
+  {
+    for (int x = xpos, k = 2; x < (xpos + 3); x++, k--)
+    {
+      if ((numbers_font[number][i] >> k) & 0x1)
+      {
+        gridAddPixel(x, y, color);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Shows a character on the grid (5x3), supports currently only 'I' and 'P'
+ *
+ * @param xpos x of left top corner of character
+ * @param ypos y of left top corner of character
+ * @param character character to display
+ * @param color color to display (24bit)
+ */
+void Framebuffer::printChar(uint8_t xpos, uint8_t ypos, char character, uint32_t color)
+{
+  int id = 0;
+  if (character == 'I')
+  {
+    id = 0;
+  }
+  else if (character == 'P')
+  {
+    id = 1;
+  }
+
+  for (int y = ypos, i = 0; y < (ypos + 5); y++, i++)
+  {
+    for (int x = xpos, k = 2; x < (xpos + 3); x++, k--)
+    {
+      if ((chars_font[id][i] >> k) & 0x1)
+      {
+        gridAddPixel(x, y, color);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Draw a point anti-aliased across the (up to) four pixels around its position
+ *
+ * @param x x position in 1/256 pixels, pixel center at integer position, has to be >= 0
+ * @param y y position in 1/256 pixels, pixel center at integer position, has to be >= 0
+ * @param color color of the point (24bit)
+ */
+void Framebuffer::drawPoint(int16_t x, int16_t y, uint32_t color)
+{
+  // split position into pixel and fraction
+  uint8_t pixelX = x >> 8;
+  uint8_t pixelY = y >> 8;
+  uint16_t fracX = x & 0xff;
+  uint16_t fracY = y & 0xff;
+
+  gridBlendPixel(pixelX, pixelY, color, (256 - fracX) * (256 - fracY) >> 8);
+  gridBlendPixel(pixelX + 1, pixelY, color, fracX * (256 - fracY) >> 8);
+  gridBlendPixel(pixelX, pixelY + 1, color, (256 - fracX) * fracY >> 8);
+  gridBlendPixel(pixelX + 1, pixelY + 1, color, fracX * fracY >> 8);
+}
@@ -0,0 +1,32 @@
+/**
+ * @file framebuffer.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Interface of a drawing target with the size of the led grid (implemented by LEDMatrix)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Games only draw through this interface in their render() function, so the
+ * game logic does not depend on the led matrix.
+ *
+ */
+#ifndef framebuffer_h
+#define framebuffer_h
+
+#include <Arduino.h>
+#include "config.h"
+
+class Framebuffer
+{
+public:
+    virtual ~Framebuffer() {}
+    virtual void gridAddPixel(uint8_t x, uint8_t y, uint32_t color) = 0;
+    virtual void gridBlendPixel(uint8_t x, uint8_t y, uint32_t color, uint16_t weight) = 0;
+    virtual void gridFlush(void) = 0;
+    void printNumber(uint8_t xpos, uint8_t ypos, uint8_t number, uint32_t color);
+    void printChar(uint8_t xpos, uint8_t ypos, char character, uint32_t color);
+    void drawPoint(int16_t x, int16_t y, uint32_t color);
+};
+
+#endif
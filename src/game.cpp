@@ -0,0 +1,309 @@
+/**
+ * @file game.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Base class of all games: fixed-timestep simulation separated from rendering
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "game.h"
+#include "gamerecord.h"
+
+/**
+ * @brief Construct a new Game:: Game object
+ *
+ */
+Game::Game(){
+
+}
+
+/**
+ * @brief Construct a new Game:: Game object
+ *
+ * @param myframebuffer pointer to Framebuffer object (e.g. LEDMatrix) the game is rendered to
+ * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
+ * @param tickTime duration of one tick of the game in ms
+ */
+Game::Game(Framebuffer *myframebuffer, UDPLogger *mylogger, uint16_t tickTime){
+    _framebuffer = myframebuffer;
+    _logger = mylogger;
+    _tickTime = tickTime;
+    _time = millis();
+}
+
+/**
+ * @brief Run main loop for one cycle: simulate all ticks which are due since the last cycle, then render if needed
+ *
+ * @return true if a new frame was rendered to the framebuffer
+ */
+bool Game::loopCycle(){
+    unsigned long now = millis();
+    if (now - _time > max((unsigned long)GAME_MAX_CATCHUP, (unsigned long)_tickTime)) {
+        // we are far behind (e.g. blocked by other tasks), do not try to catch up
+        _time = now - _tickTime;
+    }
+    while (now - _time >= _tickTime) {
+        step();
+    }
+    if (_dirty && _framebuffer != nullptr) {
+        _dirty = false;
+        render(*_framebuffer);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Simulate one tick of the game (without rendering)
+ *
+ */
+void Game::step(){
+    _time += _tickTime;
+    _ticks++;
+    update();
+}
+
+/**
+ * @brief Get current game state
+ *
+ * @return GameState game state
+ */
+GameState Game::getGameState(){
+    return _gameState;
+}
+
+/**
+ * @brief Get score of the current (or last) game
+ *
+ * @return uint32_t score
+ */
+uint32_t Game::getScore(){
+    return _score;
+}
+
+/**
+ * @brief Get level of the current (or last) game
+ *
+ * @return uint8_t level
+ */
+uint8_t Game::getLevel(){
+    return _level;
+}
+
+/**
+ * @brief Get number of ticks since the game was started
+ *
+ * @return uint32_t number of ticks
+ */
+uint32_t Game::getTicks(){
+    return _ticks;
+}
+
+/**
+ * @brief Get duration of one tick of the game
+ *
+ * @return uint16_t duration in ms
+ */
+uint16_t Game::getTickTime(){
+    return _tickTime;
+}
+
+/**
+ * @brief Get time of the current tick, use instead of millis() in the game logic
+ *
+ * @return unsigned long time in ms (same time base as millis())
+ */
+unsigned long Game::getTime(){
+    return _time;
+}
+
+/**
+ * @brief Get seed of the current (or last) game
+ *
+ * @return uint32_t seed
+ */
+uint32_t Game::getSeed(){
+    return _seed;
+}
+
+/**
+ * @brief Get variant of the current game which has to be restored for a replay (e.g. number of bots)
+ *
+ * @return uint8_t variant
+ */
+uint8_t Game::getVariant(){
+    return 0;
+}
+
+/**
+ * @brief Set function which is called on score and level changes and at the end of a game
+ *
+ * @param hook function called with the game and the event (GAME_EVENT_...)
+ */
+void Game::setEventHook(GameEventHook hook){
+    _eventHook = hook;
+}
+
+/**
+ * @brief Set recorder, which records the seed and the inputs of the next games
+ *
+ * @param recorder recorder, nullptr to stop recording
+ */
+void Game::setRecorder(GameRecorder *recorder){
+    _recorder = recorder;
+}
+
+/**
+ * @brief Set replayer, the next game is started with the recorded seed and takes the recorded inputs
+ *
+ * @param replayer replayer, nullptr to stop replaying
+ */
+void Game::setReplayer(GameReplayer *replayer){
+    _replayer = replayer;
+}
+
+/**
+ * @brief Restart the game time at the current time and seed the random generator, call at the start of a game
+ *
+ */
+void Game::startTime(){
+    _time = millis();
+    _ticks = 0;
+    _score = 0;
+    _level = 0;
+    _dirty = true;
+
+    if (_replayer != nullptr && _replayer->isStarted()) {
+        // game was restarted during the replay, the recording is over
+        _replayer = nullptr;
+    }
+    if (_replayer != nullptr) {
+        _seed = _replayer->begin();
+    }
+    else {
+        _seed = ::random(1, 0x7FFFFFFF);
+    }
+    _rng = (_seed != 0) ? _seed : 1;
+    if (_recorder != nullptr) {
+        _recorder->begin(_seed);
+    }
+}
+
+/**
+ * @brief Change game state, calls the event hook when the game ends
+ *
+ * @param state new game state
+ */
+void Game::setGameState(GameState state){
+    bool ended = (state == GAME_STATE_END && _gameState != GAME_STATE_END);
+    _gameState = state;
+    _dirty = true;
+    if (ended && _recorder != nullptr) {
+        _recorder->end(_ticks, _score);
+    }
+    if (ended && _eventHook != nullptr) {
+        _eventHook(this, GAME_EVENT_END);
+    }
+}
+
+/**
+ * @brief Set score of the current game, calls the event hook
+ *
+ * @param score new score
+ */
+void Game::setScore(uint32_t score){
+    if (score != _score) {
+        _score = score;
+        if (_eventHook != nullptr) {
+            _eventHook(this, GAME_EVENT_SCORE);
+        }
+    }
+}
+
+/**
+ * @brief Set level of the current game, calls the event hook
+ *
+ * @param level new level
+ */
+void Game::setLevel(uint8_t level){
+    if (level != _level) {
+        _level = level;
+        if (_eventHook != nullptr) {
+            _eventHook(this, GAME_EVENT_LEVEL);
+        }
+    }
+}
+
+/**
+ * @brief Request a complete new frame, call after the target was changed by others (e.g. flushed)
+ *
+ */
+void Game::redraw(){
+    invalidate();
+}
+
+/**
+ * @brief Request rendering of a new frame after the current ticks
+ *
+ */
+void Game::invalidate(){
+    _dirty = true;
+}
+
+/**
+ * @brief Take the next queued input event, use instead of _inputs.pop() in the game logic
+ *
+ * While replaying, the recorded inputs of the current tick are returned and
+ * the inputs of the players are dropped.
+ *
+ * @param event input event
+ * @return true if there was an input event
+ */
+bool Game::popInput(InputEvent &event){
+    if (_replayer != nullptr && _replayer->isStarted()) {
+        InputEvent dropped;
+        while (_inputs.pop(dropped)) {
+        }
+        return _replayer->nextInput(_ticks, _time, event);
+    }
+    if (!_inputs.pop(event)) {
+        return false;
+    }
+    if (_recorder != nullptr) {
+        _recorder->addInput(_ticks, _time, event);
+    }
+    return true;
+}
+
+/**
+ * @brief Random number of the game, games use this instead of the global random(), so a game is reproducible from its seed
+ *
+ * @param howbig upper bound (exclusive)
+ * @return long random number in [0, howbig)
+ */
+long Game::random(long howbig){
+    if (howbig <= 0) {
+        return 0;
+    }
+    // xorshift32
+    _rng ^= _rng << 13;
+    _rng ^= _rng >> 17;
+    _rng ^= _rng << 5;
+    return _rng % howbig;
+}
+
+/**
+ * @brief Random number of the game in a range
+ *
+ * @param howsmall lower bound (inclusive)
+ * @param howbig upper bound (exclusive)
+ * @return long random number in [howsmall, howbig)
+ */
+long Game::random(long howsmall, long howbig){
+    if (howsmall >= howbig) {
+        return howsmall;
+    }
+    return random(howbig - howsmall) + howsmall;
+}
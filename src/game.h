@@ -0,0 +1,115 @@
+/**
+ * @file game.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Base class of all games: fixed-timestep simulation separated from rendering
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The game logic is implemented in update(), which is called once per tick
+ * of the game. The tick has the fixed duration getTickTime(), so the game
+ * counts ticks for its timers. It must not use millis() or draw anything, but
+ * getTime() (time of the current tick) and invalidate() to request a new
+ * frame. render() draws the current state to a Framebuffer.
+ *
+ * loopCycle() runs all ticks which are due since the last call and renders
+ * once afterwards, so the display rate is independent of the game rate.
+ * A game may draw only the changes since its last frame, so whoever changes
+ * the target behind its back (flush, pictures of /leddirect or DDP) has to
+ * call redraw().
+ * step() runs a single tick without rendering, e.g. to simulate games
+ * headless at full speed.
+ *
+ * A game is reproducible from its seed and its inputs: the game logic uses
+ * the random() of the game (seeded at the start of each game) and takes the
+ * inputs with popInput(), which also feeds the recorder or the replayer
+ * (see gamerecord.h).
+ *
+ */
+#ifndef game_h
+#define game_h
+
+#include <Arduino.h>
+#include "framebuffer.h"
+#include "udplogger.h"
+#include "inputqueue.h"
+
+#define GAME_MAX_CATCHUP    200     // in ms, max. time simulated in one loopCycle(), more is dropped
+
+#define GAME_EVENT_SCORE    0       // score changed
+#define GAME_EVENT_LEVEL    1       // level changed
+#define GAME_EVENT_END      2       // game ended
+
+#define GAME_ID_TETRIS      0
+#define GAME_ID_SNAKE       1
+#define GAME_ID_PONG        2
+#define GAME_ID_BREAKOUT    3
+
+enum GameState : uint8_t {
+    GAME_STATE_READY,       // no game started yet, or score is shown after the game
+    GAME_STATE_INIT,        // new game is started with the next tick
+    GAME_STATE_RUNNING,
+    GAME_STATE_PAUSED,
+    GAME_STATE_END          // game over
+};
+
+class Game;
+class GameRecorder;
+class GameReplayer;
+typedef void (*GameEventHook)(Game *game, uint8_t event);
+
+class Game{
+
+    public:
+        Game();
+        Game(Framebuffer *myframebuffer, UDPLogger *mylogger, uint16_t tickTime);
+        virtual ~Game() {}
+        bool loopCycle();
+        void step();
+        virtual void render(Framebuffer &framebuffer) = 0;
+        virtual void redraw();
+
+        GameState getGameState();
+        uint32_t getScore();
+        uint8_t getLevel();
+        uint32_t getTicks();
+        uint16_t getTickTime();
+        unsigned long getTime();
+        uint32_t getSeed();
+        virtual uint8_t getVariant();
+        void setEventHook(GameEventHook hook);
+        void setRecorder(GameRecorder *recorder);
+        void setReplayer(GameReplayer *replayer);
+
+    protected:
+        virtual void update() = 0;
+        void startTime();
+        void setGameState(GameState state);
+        void setScore(uint32_t score);
+        void setLevel(uint8_t level);
+        void invalidate();
+        bool popInput(InputEvent &event);
+        long random(long howbig);
+        long random(long howsmall, long howbig);
+
+        Framebuffer *_framebuffer = nullptr;
+        UDPLogger *_logger = nullptr;
+        GameState _gameState = GAME_STATE_READY;
+        InputQueue _inputs;
+
+    private:
+        uint16_t _tickTime = 10;
+        unsigned long _time = 0;    // time of the current tick (in millis)
+        uint32_t _ticks = 0;
+        uint32_t _score = 0;
+        uint8_t _level = 0;
+        bool _dirty = true;
+        GameEventHook _eventHook = nullptr;
+        uint32_t _seed = 1;
+        uint32_t _rng = 1;          // state of the xorshift generator
+        GameRecorder *_recorder = nullptr;
+        GameReplayer *_replayer = nullptr;
+};
+
+#endif
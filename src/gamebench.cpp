@@ -0,0 +1,322 @@
+/**
+ * @file gamebench.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for the headless benchmark of the games (game logic without rendering)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "gamebench.h"
+#include "tetris.h"
+#include "tetrisbot.h"
+#include "snake.h"
+#include "snakebot.h"
+#include "pong.h"
+#include "breakout.h"
+
+/**
+ * @brief Construct a new GameBench:: GameBench object
+ *
+ * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
+ */
+GameBench::GameBench(UDPLogger *mylogger){
+    _logger = mylogger;
+    // the games and bots log every game, which would dominate the measured time
+    _mutedLogger.setMuted(true);
+}
+
+/**
+ * @brief Destroy the GameBench:: GameBench object
+ *
+ */
+GameBench::~GameBench(){
+    stop();
+}
+
+/**
+ * @brief Start a number of games headless, they are played by loopCycle()
+ *
+ * @param game name of the game {tetris, snake, pong, breakout}
+ * @param numGames number of games
+ * @return true if the benchmark was started
+ */
+bool GameBench::start(String game, uint16_t numGames){
+    stop();
+    _result = {};
+    _result.scoreMin = UINT32_MAX;
+
+    if (game == "tetris") {
+        _result.game = GAME_ID_TETRIS;
+        Tetris *tetris = new Tetris(nullptr, &_mutedLogger);
+        _tetrisBot = new TetrisBot(tetris, &_mutedLogger);
+        _game = tetris;
+    }
+    else if (game == "snake") {
+        _result.game = GAME_ID_SNAKE;
+        Snake *snake = new Snake(nullptr, &_mutedLogger);
+        _snakeBot = new SnakeBot(snake, &_mutedLogger);
+        _game = snake;
+    }
+    else if (game == "pong") {
+        _result.game = GAME_ID_PONG;
+        _game = new Pong(nullptr, &_mutedLogger);
+    }
+    else if (game == "breakout") {
+        _result.game = GAME_ID_BREAKOUT;
+        _game = new Breakout(nullptr, &_mutedLogger);
+    }
+    else {
+        return false;
+    }
+
+    _name = game;
+    _gamesLeft = constrain(numGames, 1, GAMEBENCH_MAX_GAMES);
+    _result.running = true;
+    startGame();
+    return true;
+}
+
+/**
+ * @brief Stop the running benchmark, the result contains the finished games
+ *
+ */
+void GameBench::stop(){
+    delete _tetrisBot;
+    delete _snakeBot;
+    delete _game;
+    _tetrisBot = nullptr;
+    _snakeBot = nullptr;
+    _game = nullptr;
+    if (_replaying) {
+        _replaying = false;
+        _replayer.close();
+    }
+    _result.running = false;
+}
+
+/**
+ * @brief Check if a benchmark is running
+ *
+ * @return true if the games are not finished yet
+ */
+bool GameBench::isRunning(){
+    return _game != nullptr;
+}
+
+/**
+ * @brief Play the running benchmark or replay for up to GAMEBENCH_CYCLE_TICKS ticks or GAMEBENCH_CYCLE_TIME,
+ * the bot is called before every tick
+ *
+ */
+void GameBench::loopCycle(){
+    if (_game == nullptr) {
+        return;
+    }
+    unsigned long cycleStart = micros();
+    for (uint16_t i = 0; i < GAMEBENCH_CYCLE_TICKS && micros() - cycleStart < GAMEBENCH_CYCLE_TIME * 1000UL; i++) {
+        if (_replaying && _replayer.isFinished(_game->getTicks())) {
+            // a recording of a game which was not finished ends at its last tick
+            finishReplay();
+            return;
+        }
+        if (_tetrisBot != nullptr) {
+            _tetrisBot->loopCycle();
+        }
+        else if (_snakeBot != nullptr) {
+            _snakeBot->loopCycle();
+        }
+        unsigned long start = micros();
+        _game->step();
+        unsigned long duration = micros() - start;
+        _result.micros += duration;
+        if (duration > _result.maxTickMicros) {
+            _result.maxTickMicros = duration;
+        }
+        _gameTicks++;
+
+        GameState state = _game->getGameState();
+        if ((state == GAME_STATE_INIT || state == GAME_STATE_RUNNING || state == GAME_STATE_PAUSED) && _gameTicks < GAMEBENCH_MAX_TICKS) {
+            continue;
+        }
+        if (_replaying) {
+            finishReplay();
+            return;
+        }
+        finishGame(*_game, _gameTicks);
+        if (--_gamesLeft == 0) {
+            stop();
+            logResult(_name);
+            return;
+        }
+        startGame();
+    }
+}
+
+/**
+ * @brief Start the next game of the running benchmark
+ *
+ */
+void GameBench::startGame(){
+    _gameTicks = 0;
+    switch (_result.game) {
+        case GAME_ID_TETRIS:
+            _tetrisBot->initGame();
+            break;
+        case GAME_ID_SNAKE:
+            _snakeBot->initGame();
+            break;
+        case GAME_ID_PONG:
+            static_cast<Pong *>(_game)->initGame(2);
+            break;
+        case GAME_ID_BREAKOUT:
+            static_cast<Breakout *>(_game)->initGame(true);
+            break;
+    }
+}
+
+/**
+ * @brief Start the replay of a recorded game headless, it is played by loopCycle()
+ *
+ * @param path path of the recording on LittleFS
+ * @return true if the replay was started
+ */
+bool GameBench::replay(String path){
+    stop();
+    if (!_replayer.open(path)) {
+        (*_logger).logString("GameBench: " + path + " is no recording");
+        return false;
+    }
+    _result = {};
+    _result.scoreMin = UINT32_MAX;
+    _result.game = _replayer.getGameId();
+
+    // start the game the same way as it was started when it was recorded
+    switch (_replayer.getGameId()) {
+        case GAME_ID_TETRIS: {
+            Tetris *tetris = new Tetris(nullptr, &_mutedLogger);
+            tetris->setReplayer(&_replayer);
+            tetris->ctrlStart();
+            _game = tetris;
+            break;
+        }
+        case GAME_ID_SNAKE: {
+            Snake *snake = new Snake(nullptr, &_mutedLogger);
+            snake->setReplayer(&_replayer);
+            snake->initGame();
+            _game = snake;
+            break;
+        }
+        case GAME_ID_PONG: {
+            Pong *pong = new Pong(nullptr, &_mutedLogger);
+            pong->setReplayer(&_replayer);
+            pong->initGame(_replayer.getVariant());
+            _game = pong;
+            break;
+        }
+        case GAME_ID_BREAKOUT: {
+            Breakout *breakout = new Breakout(nullptr, &_mutedLogger);
+            breakout->setReplayer(&_replayer);
+            breakout->initGame(_replayer.getVariant() != 0);
+            _game = breakout;
+            break;
+        }
+        default:
+            _replayer.close();
+            return false;
+    }
+
+    _name = path;
+    _replaying = true;
+    _gamesLeft = 1;
+    _gameTicks = 0;
+    _result.running = true;
+    return true;
+}
+
+/**
+ * @brief Compare the replayed game with the end of the recording and stop the replay
+ *
+ */
+void GameBench::finishReplay(){
+    bool match = _replayer.hasEnd() && _game->getTicks() == _replayer.getEndTick() && _game->getScore() == _replayer.getEndScore();
+    _result.replay = match ? GAMEBENCH_REPLAY_MATCH : GAMEBENCH_REPLAY_MISMATCH;
+    if (!match) {
+        (*_logger).logString("GameBench: replay differs from recording, tick " + String(_game->getTicks()) + " (recorded " +
+                             String(_replayer.getEndTick()) + "), score " + String(_game->getScore()) + " (recorded " +
+                             String(_replayer.getEndScore()) + ")");
+    }
+    finishGame(*_game, _gameTicks);
+    stop();
+    logResult(_name);
+}
+
+/**
+ * @brief Log the result of the last benchmark
+ *
+ * @param name name of the benchmark
+ */
+void GameBench::logResult(String name){
+    if (_result.games + _result.stuck == 0) {
+        _result.scoreMin = 0;
+    }
+    (*_logger).logString("GameBench: " + name + " " + String(_result.games) + " games (" + String(_result.stuck) + " stuck), " +
+                         String(_result.ticks) + " ticks in " + String(_result.micros / 1000) + " ms, " +
+                         String((uint32_t)((uint64_t)_result.ticks * 1000000 / max(_result.micros, 1UL))) + " ticks/s, max. " +
+                         String(_result.maxTickMicros) + " us/tick");
+}
+
+/**
+ * @brief Add the finished game to the result
+ *
+ * @param game finished game
+ * @param ticks number of ticks of the game
+ */
+void GameBench::finishGame(Game &game, uint32_t ticks){
+    _result.ticks += ticks;
+    if (ticks >= GAMEBENCH_MAX_TICKS) {
+        _result.stuck++;
+    }
+    else {
+        _result.games++;
+    }
+    uint32_t score = game.getScore();
+    _result.scoreSum += score;
+    _result.scoreMin = min(_result.scoreMin, score);
+    _result.scoreMax = max(_result.scoreMax, score);
+    _result.levelMax = max(_result.levelMax, game.getLevel());
+}
+
+/**
+ * @brief Get result of the last benchmark
+ *
+ * @return GameBenchResult result
+ */
+GameBenchResult GameBench::getResult(){
+    return _result;
+}
+
+/**
+ * @brief Get result of the last benchmark as JSON object
+ *
+ * @return String JSON object
+ */
+String GameBench::getResultJSON(){
+    uint16_t numGames = max(_result.games + _result.stuck, 1);
+    String message = "{";
+    message += "\"game\":\"" + String(_result.game) + "\"";
+    message += ",\"games\":\"" + String(_result.games) + "\"";
+    message += ",\"stuck\":\"" + String(_result.stuck) + "\"";
+    message += ",\"ticks\":\"" + String(_result.ticks) + "\"";
+    message += ",\"ticksPerSecond\":\"" + String((uint32_t)((uint64_t)_result.ticks * 1000000 / max(_result.micros, 1UL))) + "\"";
+    message += ",\"maxTickMicros\":\"" + String(_result.maxTickMicros) + "\"";
+    message += ",\"scoreAvg\":\"" + String(_result.scoreSum / numGames) + "\"";
+    message += ",\"scoreMin\":\"" + String(_result.scoreMin) + "\"";
+    message += ",\"scoreMax\":\"" + String(_result.scoreMax) + "\"";
+    message += ",\"levelMax\":\"" + String(_result.levelMax) + "\"";
+    message += ",\"replay\":\"" + String(_result.replay) + "\"";
+    message += ",\"running\":\"" + String(_result.running ? 1 : 0) + "\"";
+    message += "}";
+    return message;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file gamebench.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for the headless benchmark of the games (game logic without rendering)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The benchmark creates its own instances of a game without framebuffer and
+ * plays them with the bots (pong: two bots) as fast as possible. The time of
+ * the games is virtual (Game::step()), so a game of several minutes takes only
+ * milliseconds. A game which does not end within GAMEBENCH_MAX_TICKS is counted
+ * as stuck, so endless loops in the game logic show up in the result.
+ * start() only creates the games, loopCycle() plays them in slices of at most
+ * GAMEBENCH_CYCLE_TICKS ticks or GAMEBENCH_CYCLE_TIME, so the main loop keeps running.
+ *
+ * replay() plays a recorded game (see gamerecord.h) the same way (also in
+ * loopCycle()) and checks that it ends at the recorded tick with the recorded
+ * score, so a recording is a performance and regression test of the game logic.
+ *
+ */
+#ifndef gamebench_h
+#define gamebench_h
+
+#include <Arduino.h>
+#include "game.h"
+#include "udplogger.h"
+#include "gamerecord.h"
+
+#define GAMEBENCH_MAX_TICKS     500000  // max. number of ticks of one game
+#define GAMEBENCH_MAX_GAMES     1000
+#define GAMEBENCH_CYCLE_TICKS   2000    // max. number of ticks per loopCycle()
+#define GAMEBENCH_CYCLE_TIME    5       // in ms, max. time per loopCycle() (plus one tick)
+
+#define GAMEBENCH_REPLAY_NONE       0   // no replay, benchmark with the bots
+#define GAMEBENCH_REPLAY_MATCH      1   // replay ended at the recorded tick with the recorded score
+#define GAMEBENCH_REPLAY_MISMATCH   2
+
+class TetrisBot;
+class SnakeBot;
+
+struct GameBenchResult {
+    uint8_t game;
+    uint16_t games;             // number of finished games
+    uint16_t stuck;             // number of games which did not end within GAMEBENCH_MAX_TICKS
+    uint32_t ticks;
+    unsigned long micros;       // time of all ticks
+    unsigned long maxTickMicros;
+    uint32_t scoreSum;
+    uint32_t scoreMin;
+    uint32_t scoreMax;
+    uint8_t levelMax;
+    uint8_t replay;             // result of the replay (GAMEBENCH_REPLAY_...)
+    bool running;               // benchmark is not finished yet
+};
+
+class GameBench{
+
+    public:
+        GameBench(UDPLogger *mylogger);
+        ~GameBench();
+        bool start(String game, uint16_t numGames);
+        void stop();
+        void loopCycle();
+        bool isRunning();
+        bool replay(String path);
+        GameBenchResult getResult();
+        String getResultJSON();
+
+    private:
+        void startGame();
+        void finishGame(Game &game, uint32_t ticks);
+        void finishReplay();
+        void logResult(String name);
+
+        UDPLogger *_logger;
+        UDPLogger _mutedLogger;
+        GameBenchResult _result = {};
+
+        // state of the running benchmark
+        String _name;
+        Game *_game = nullptr;
+        TetrisBot *_tetrisBot = nullptr;
+        SnakeBot *_snakeBot = nullptr;
+        GameReplayer _replayer;
+        bool _replaying = false;
+        uint16_t _gamesLeft = 0;
+        uint32_t _gameTicks = 0;        // ticks of the current game
+};
+
+#endif
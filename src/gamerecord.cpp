@@ -0,0 +1,377 @@
+/**
+ * @file gamerecord.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementations for recording the inputs of a game to LittleFS and replaying them deterministically
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "gamerecord.h"
+
+/**
+ * @brief Construct a new GameRecorder:: GameRecorder object
+ *
+ * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
+ */
+GameRecorder::GameRecorder(UDPLogger *mylogger){
+    _logger = mylogger;
+}
+
+/**
+ * @brief Record the next games of a game, each game started overwrites the file
+ *
+ * @param game game to be recorded
+ * @param gameId id of the game (GAME_ID_...)
+ * @param path path of the recording on LittleFS
+ */
+void GameRecorder::start(Game *game, uint8_t gameId, String path){
+    stop();
+    _game = game;
+    _gameId = gameId;
+    _path = path;
+    _headerPending = false;
+    _ended = false;
+    _length = 0;
+    _game->setRecorder(this);
+}
+
+/**
+ * @brief Stop recording, a game which is still running is recorded up to the current tick
+ *
+ */
+void GameRecorder::stop(){
+    if (_game == nullptr) {
+        return;
+    }
+    if ((_headerPending || _file) && !_ended) {
+        // game was not finished (e.g. mode changed), the replay stops at this tick
+        end(_game->getTicks(), _game->getScore());
+    }
+    flush();
+    _game->setRecorder(nullptr);
+    _game = nullptr;
+}
+
+/**
+ * @brief Run main loop for one cycle: write the buffered records to the file if the buffer is half full or the commit is due
+ *
+ */
+void GameRecorder::loopCycle(){
+    if (_game == nullptr) {
+        return;
+    }
+    if (_headerPending || _ended || _length >= GAMERECORD_BUFFER_SIZE / 2 ||
+        (_length > 0 && millis() - _lastFlush >= GAMERECORD_FLUSH_INTERVAL)) {
+        flush();
+    }
+}
+
+/**
+ * @brief Start a new recording, called by the game when it starts
+ *
+ * @param seed seed of the game
+ */
+void GameRecorder::begin(uint32_t seed){
+    _seed = seed;
+    _headerPending = true;
+    _ended = false;
+    _lastTick = 0;
+    _numInputs = 0;
+    _dropped = 0;
+    _length = 0;
+}
+
+/**
+ * @brief Add an input, called by the game when it takes the input
+ *
+ * @param tick tick of the game at which the input is taken
+ * @param time time of the tick
+ * @param event input event
+ */
+void GameRecorder::addInput(uint32_t tick, unsigned long time, const InputEvent &event){
+    if (!_headerPending && !_file) {
+        return;
+    }
+    long offset = constrain((long)(event.time - time), -32768L, 32767L);
+    addRecord(tick, offset, (event.key & 0x0F) | ((event.action & 0x03) << 4) | ((event.player & 0x01) << 6));
+    _numInputs++;
+}
+
+/**
+ * @brief Add the end of the game, called by the game when it ends
+ *
+ * @param tick tick of the game at which the game ended
+ * @param score score of the game
+ */
+void GameRecorder::end(uint32_t tick, uint32_t score){
+    if ((!_headerPending && !_file) || _ended) {
+        return;
+    }
+    addRecord(tick, 0, GAMERECORD_RECORD_END);
+    addBytes(score, 4);
+    _ended = true;
+}
+
+/**
+ * @brief Add a record to the buffer
+ *
+ * @param tick tick of the record
+ * @param timeOffset time offset of the input
+ * @param type packed key, action and player of the input or GAMERECORD_RECORD_...
+ */
+void GameRecorder::addRecord(uint32_t tick, int16_t timeOffset, uint8_t type){
+    while (tick - _lastTick > 0xFFFF) {
+        addBytes(0xFFFF, 2);
+        addBytes(0, 2);
+        addBytes(GAMERECORD_RECORD_SKIP, 1);
+        _lastTick += 0xFFFF;
+    }
+    addBytes(tick - _lastTick, 2);
+    addBytes((uint16_t)timeOffset, 2);
+    addBytes(type, 1);
+    _lastTick = tick;
+}
+
+/**
+ * @brief Add a value to the buffer (little endian)
+ *
+ * @param value value
+ * @param length number of bytes
+ */
+void GameRecorder::addBytes(uint32_t value, uint8_t length){
+    if (_length + length > GAMERECORD_BUFFER_SIZE) {
+        _dropped += length;
+        return;
+    }
+    for (uint8_t i = 0; i < length; i++) {
+        _buffer[_length++] = (value >> (8 * i)) & 0xFF;
+    }
+}
+
+/**
+ * @brief Create the file of a new recording and write the buffered records, commit them if due and close the file at the end of the game
+ *
+ */
+void GameRecorder::flush(){
+    if (_headerPending) {
+        _headerPending = false;
+        if (_file) {
+            _file.close();
+        }
+        _file = LittleFS.open(_path, "w");
+        if (!_file) {
+            (*_logger).logString("GameRecorder: can not create " + _path);
+            _length = 0;
+            _ended = false;
+            return;
+        }
+        // the variant is set by the game after its start, so the header is built here and not in begin()
+        uint8_t header[GAMERECORD_HEADER_SIZE] = {
+            GAMERECORD_MAGIC & 0xFF, (GAMERECORD_MAGIC >> 8) & 0xFF, (GAMERECORD_MAGIC >> 16) & 0xFF, GAMERECORD_MAGIC >> 24,
+            _gameId, _game->getVariant(), 0, 0,
+            (uint8_t)(_seed & 0xFF), (uint8_t)((_seed >> 8) & 0xFF), (uint8_t)((_seed >> 16) & 0xFF), (uint8_t)(_seed >> 24)};
+        _file.write(header, GAMERECORD_HEADER_SIZE);
+        _lastFlush = millis();
+    }
+    if (!_file) {
+        _length = 0;
+        return;
+    }
+    if (_length > 0) {
+        _file.write(_buffer, _length);
+        _length = 0;
+    }
+    if (millis() - _lastFlush >= GAMERECORD_FLUSH_INTERVAL) {
+        _file.flush();
+        _lastFlush = millis();
+    }
+    if (_ended) {
+        _ended = false;
+        _file.close();
+        (*_logger).logString("GameRecorder: " + String(_numInputs) + " inputs recorded to " + _path +
+                             (_dropped > 0 ? ", " + String(_dropped) + " bytes lost" : ""));
+    }
+}
+
+/**
+ * @brief Construct a new GameReplayer:: GameReplayer object
+ *
+ */
+GameReplayer::GameReplayer(){
+
+}
+
+/**
+ * @brief Open a recording, the replay starts with the next start of the game it is set to (Game::setReplayer())
+ *
+ * @param path path of the recording on LittleFS
+ * @return true if the file is a valid recording
+ */
+bool GameReplayer::open(String path){
+    close();
+    _file = LittleFS.open(path, "r");
+    if (!_file) {
+        return false;
+    }
+    if (readBytes(4) != GAMERECORD_MAGIC) {
+        close();
+        return false;
+    }
+    _gameId = readBytes(1);
+    _variant = readBytes(1);
+    readBytes(2);
+    _seed = readBytes(4);
+    _started = false;
+    _hasEnd = false;
+    _recordTick = 0;
+    readRecord();
+    return true;
+}
+
+/**
+ * @brief Close the recording
+ *
+ */
+void GameReplayer::close(){
+    if (_file) {
+        _file.close();
+    }
+    _hasRecord = false;
+}
+
+/**
+ * @brief Get id of the recorded game
+ *
+ * @return uint8_t game id (GAME_ID_...)
+ */
+uint8_t GameReplayer::getGameId(){
+    return _gameId;
+}
+
+/**
+ * @brief Get variant of the recorded game (see Game::getVariant())
+ *
+ * @return uint8_t variant
+ */
+uint8_t GameReplayer::getVariant(){
+    return _variant;
+}
+
+/**
+ * @brief Check if the replay has started (game was started)
+ *
+ * @return true if started
+ */
+bool GameReplayer::isStarted(){
+    return _started;
+}
+
+/**
+ * @brief Check if the end of the recording is reached
+ *
+ * @param tick current tick of the game
+ * @return true if the recording ends at or before the tick
+ */
+bool GameReplayer::isFinished(uint32_t tick){
+    return _hasEnd && tick >= _endTick;
+}
+
+/**
+ * @brief Check if the end of the recording is read (only after all inputs are replayed)
+ *
+ * @return true if the end record is read
+ */
+bool GameReplayer::hasEnd(){
+    return _hasEnd;
+}
+
+/**
+ * @brief Get the tick at which the recorded game ended
+ *
+ * @return uint32_t tick
+ */
+uint32_t GameReplayer::getEndTick(){
+    return _endTick;
+}
+
+/**
+ * @brief Get the score of the recorded game at its end
+ *
+ * @return uint32_t score
+ */
+uint32_t GameReplayer::getEndScore(){
+    return _endScore;
+}
+
+/**
+ * @brief Start the replay, called by the game when it starts
+ *
+ * @return uint32_t recorded seed of the game
+ */
+uint32_t GameReplayer::begin(){
+    _started = true;
+    return _seed;
+}
+
+/**
+ * @brief Get the next recorded input of the current tick, called by the game instead of taking the inputs of the players
+ *
+ * @param tick current tick of the game
+ * @param time time of the current tick
+ * @param event input event
+ * @return true if there was an input
+ */
+bool GameReplayer::nextInput(uint32_t tick, unsigned long time, InputEvent &event){
+    if (!_hasRecord || _recordTick > tick) {
+        return false;
+    }
+    event.time = time + _recordOffset;
+    event.key = _recordType & 0x0F;
+    event.action = (_recordType >> 4) & 0x03;
+    event.player = (_recordType >> 6) & 0x01;
+    readRecord();
+    return true;
+}
+
+/**
+ * @brief Read ahead the next input record (and the end record)
+ *
+ * @return true if there is a next input record
+ */
+bool GameReplayer::readRecord(){
+    _hasRecord = false;
+    while (_file && _file.available() >= GAMERECORD_INPUT_SIZE) {
+        _recordTick += readBytes(2);
+        _recordOffset = (int16_t)readBytes(2);
+        _recordType = readBytes(1);
+        if (_recordType == GAMERECORD_RECORD_END) {
+            _hasEnd = true;
+            _endTick = _recordTick;
+            _endScore = readBytes(4);
+            return false;
+        }
+        if (_recordType != GAMERECORD_RECORD_SKIP) {
+            _hasRecord = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Read a value from the file (little endian)
+ *
+ * @param length number of bytes
+ * @return uint32_t value
+ */
+uint32_t GameReplayer::readBytes(uint8_t length){
+    uint8_t bytes[4] = {0};
+    _file.read(bytes, length);
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < length; i++) {
+        value |= (uint32_t)bytes[i] << (8 * i);
+    }
+    return value;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file gamerecord.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declarations for recording the inputs of a game to LittleFS and replaying them deterministically
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A game only depends on its seed and on the inputs it takes at its ticks
+ * (see game.h), so a recording contains just these:
+ *
+ *   header  (12 bytes): magic, game id, variant (e.g. number of bots), 2 reserved, seed
+ *   input   ( 5 bytes): ticks since the previous record (uint16), input time - tick time (int16),
+ *                       key | action << 4 | player << 6
+ *   end     ( 9 bytes): ticks since the previous record, 0, GAMERECORD_RECORD_END, score (uint32)
+ *
+ * All values are little endian. The recorder collects the records in RAM
+ * while the game is running and writes them in loopCycle(), so a tick never
+ * waits on the file system. To spare the flash the buffer is only written
+ * when it is half full, committed every GAMERECORD_FLUSH_INTERVAL and at the
+ * end of the game, when the file is closed. The replayer feeds the recorded inputs to the
+ * game at the same ticks instead of the inputs of the players.
+ *
+ */
+#ifndef gamerecord_h
+#define gamerecord_h
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "game.h"
+#include "inputqueue.h"
+#include "udplogger.h"
+
+#define GAMERECORD_FILE             "/lastgame.rec"
+#define GAMERECORD_MAGIC            0x31524D47  // "GMR1"
+#define GAMERECORD_HEADER_SIZE      12
+#define GAMERECORD_INPUT_SIZE       5
+#define GAMERECORD_END_SIZE         9
+#define GAMERECORD_BUFFER_SIZE      200         // in bytes, records not written yet
+#define GAMERECORD_FLUSH_INTERVAL   300000      // in ms, max. time the written records of a running game are not committed
+#define GAMERECORD_RECORD_SKIP      0xFE        // record without input (more than 65535 ticks since the previous record)
+#define GAMERECORD_RECORD_END       0xFF        // end of the game, followed by the score
+
+class GameRecorder{
+
+    public:
+        GameRecorder(UDPLogger *mylogger);
+        void start(Game *game, uint8_t gameId, String path = GAMERECORD_FILE);
+        void stop();
+        void loopCycle();
+
+        // called by the game
+        void begin(uint32_t seed);
+        void addInput(uint32_t tick, unsigned long time, const InputEvent &event);
+        void end(uint32_t tick, uint32_t score);
+
+    private:
+        void addRecord(uint32_t tick, int16_t timeOffset, uint8_t type);
+        void addBytes(uint32_t value, uint8_t length);
+        void flush();
+
+        UDPLogger *_logger;
+        Game *_game = nullptr;
+        uint8_t _gameId = 0;
+        String _path;
+        File _file;
+        uint32_t _seed = 0;
+        bool _headerPending = false;    // game was started, the file is created with the next loopCycle()
+        bool _ended = false;            // end record was added, the file is closed with the next loopCycle()
+        uint32_t _lastTick = 0;         // tick of the last record
+        uint16_t _numInputs = 0;
+        uint16_t _dropped = 0;          // bytes lost because the buffer was full
+        uint8_t _buffer[GAMERECORD_BUFFER_SIZE];
+        uint16_t _length = 0;
+        unsigned long _lastFlush = 0;   // time (millis) the file was committed
+};
+
+class GameReplayer{
+
+    public:
+        GameReplayer();
+        bool open(String path);
+        void close();
+        uint8_t getGameId();
+        uint8_t getVariant();
+        bool isStarted();
+        bool isFinished(uint32_t tick);
+        bool hasEnd();
+        uint32_t getEndTick();
+        uint32_t getEndScore();
+
+        // called by the game
+        uint32_t begin();
+        bool nextInput(uint32_t tick, unsigned long time, InputEvent &event);
+
+    private:
+        bool readRecord();
+        uint32_t readBytes(uint8_t length);
+
+        File _file;
+        uint8_t _gameId = 0;
+        uint8_t _variant = 0;
+        uint32_t _seed = 0;
+        bool _started = false;
+        bool _hasRecord = false;        // next input record was read ahead
+        uint32_t _recordTick = 0;
+        int16_t _recordOffset = 0;
+        uint8_t _recordType = 0;
+        bool _hasEnd = false;
+        uint32_t _endTick = 0;
+        uint32_t _endScore = 0;
+};
+
+#endif
@@ -0,0 +1,155 @@
+/**
+ * @file gamestats.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for the persistent high scores and statistics of the games (stored in NVS)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "gamestats.h"
+
+// NVS keys of the games, index is the game id (GAME_ID_...)
+static const char *gameNames[GAMESTATS_NUM_GAMES] = {"tetris", "snake", "pong", "breakout"};
+
+/**
+ * @brief Construct a new GameStats:: GameStats object
+ *
+ * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
+ */
+GameStats::GameStats(UDPLogger *mylogger){
+    _logger = mylogger;
+}
+
+/**
+ * @brief Load the statistics from NVS, call once in setup
+ *
+ */
+void GameStats::begin(){
+    _preferences.begin(GAMESTATS_NAMESPACE, true);
+    for (uint8_t i = 0; i < GAMESTATS_NUM_GAMES; i++) {
+        // entries of another layout (or not existing yet) start from zero
+        if (_preferences.getBytesLength(gameNames[i]) == sizeof(GameStatsEntry)) {
+            _preferences.getBytes(gameNames[i], &_entries[i], sizeof(GameStatsEntry));
+        }
+    }
+    _preferences.end();
+    _lastFlush = millis();
+}
+
+/**
+ * @brief Run main loop for one cycle: write the changed statistics to NVS if due
+ *
+ */
+void GameStats::loopCycle(){
+    if (_dirty == 0) {
+        return;
+    }
+    unsigned long sinceFlush = millis() - _lastFlush;
+    if ((_flushRequested && sinceFlush >= GAMESTATS_MIN_INTERVAL) || sinceFlush >= GAMESTATS_FLUSH_INTERVAL) {
+        flush();
+    }
+}
+
+/**
+ * @brief Add the result of a finished game, call from the GAME_EVENT_END hook of the game
+ *
+ * Only updates the statistics in RAM, the write to NVS is done later in loopCycle().
+ *
+ * @param gameId id of the game (GAME_ID_...)
+ * @param game game which ended
+ * @param bot true if the game was played by a bot
+ */
+void GameStats::addGame(uint8_t gameId, Game *game, bool bot){
+    if (gameId >= GAMESTATS_NUM_GAMES) {
+        return;
+    }
+    GameStatsEntry &entry = _entries[gameId];
+    if (bot) {
+        entry.botGames++;
+    }
+    else {
+        uint32_t score = game->getScore();
+        entry.games++;
+        entry.playTime += (uint32_t)((uint64_t)game->getTicks() * game->getTickTime() / 1000);
+        entry.scoreSum += score;
+        entry.levelMax = max(entry.levelMax, game->getLevel());
+
+        // insert into the sorted high score table
+        for (uint8_t i = 0; i < GAMESTATS_NUM_HIGHSCORES; i++) {
+            if (score > entry.highscores[i]) {
+                for (uint8_t j = GAMESTATS_NUM_HIGHSCORES - 1; j > i; j--) {
+                    entry.highscores[j] = entry.highscores[j - 1];
+                }
+                entry.highscores[i] = score;
+                (*_logger).logString("GameStats: new highscore " + String(gameNames[gameId]) + " #" + String(i + 1) + ": " + String(score));
+                break;
+            }
+        }
+        _flushRequested = true;
+    }
+    _dirty |= 1 << gameId;
+}
+
+/**
+ * @brief Clear all statistics (in RAM and NVS)
+ *
+ */
+void GameStats::reset(){
+    memset(_entries, 0, sizeof(_entries));
+    _preferences.begin(GAMESTATS_NAMESPACE, false);
+    _preferences.clear();
+    _preferences.end();
+    _dirty = 0;
+    _flushRequested = false;
+    (*_logger).logString("GameStats: reset");
+}
+
+/**
+ * @brief Get the statistics of all games as JSON object
+ *
+ * @return String JSON object
+ */
+String GameStats::getJSON(){
+    String message = "{";
+    for (uint8_t i = 0; i < GAMESTATS_NUM_GAMES; i++) {
+        GameStatsEntry &entry = _entries[i];
+        if (i > 0) {
+            message += ",";
+        }
+        message += "\"" + String(gameNames[i]) + "\":{";
+        message += "\"games\":\"" + String(entry.games) + "\"";
+        message += ",\"botGames\":\"" + String(entry.botGames) + "\"";
+        message += ",\"playTime\":\"" + String(entry.playTime) + "\"";
+        message += ",\"scoreAvg\":\"" + String(entry.scoreSum / max(entry.games, (uint32_t)1)) + "\"";
+        message += ",\"levelMax\":\"" + String(entry.levelMax) + "\"";
+        message += ",\"highscores\":[";
+        for (uint8_t j = 0; j < GAMESTATS_NUM_HIGHSCORES; j++) {
+            if (j > 0) {
+                message += ",";
+            }
+            message += "\"" + String(entry.highscores[j]) + "\"";
+        }
+        message += "]}";
+    }
+    message += "}";
+    return message;
+}
+
+/**
+ * @brief Write the changed entries to NVS
+ *
+ */
+void GameStats::flush(){
+    _preferences.begin(GAMESTATS_NAMESPACE, false);
+    for (uint8_t i = 0; i < GAMESTATS_NUM_GAMES; i++) {
+        if (_dirty & (1 << i)) {
+            _preferences.putBytes(gameNames[i], &_entries[i], sizeof(GameStatsEntry));
+        }
+    }
+    _preferences.end();
+    _dirty = 0;
+    _flushRequested = false;
+    _lastFlush = millis();
+}
@@ -0,0 +1,62 @@
+/**
+ * @file gamestats.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for the persistent high scores and statistics of the games (stored in NVS)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The results of the finished games are collected in RAM (write-behind) and
+ * written to NVS only in loopCycle(), never from the game logic: at the end of
+ * a game of a player, otherwise (e.g. games of the bots) at most every
+ * GAMESTATS_FLUSH_INTERVAL. Only the entries of the games which changed are
+ * written, so the flash wear is bounded by the number of played games.
+ *
+ */
+#ifndef gamestats_h
+#define gamestats_h
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include "game.h"
+#include "udplogger.h"
+
+#define GAMESTATS_NAMESPACE         "gamestats"
+#define GAMESTATS_FLUSH_INTERVAL    300000  // in ms, max. delay of writing changed statistics
+#define GAMESTATS_MIN_INTERVAL      10000   // in ms, min. time between two writes
+#define GAMESTATS_NUM_HIGHSCORES    5
+
+#define GAMESTATS_NUM_GAMES         4       // games with the ids GAME_ID_...
+
+struct GameStatsEntry {
+    uint32_t games;                                 // number of finished games of players
+    uint32_t botGames;                              // number of finished games of the bots (not in the high scores)
+    uint32_t playTime;                              // in s, time of all finished games of players
+    uint32_t scoreSum;
+    uint32_t highscores[GAMESTATS_NUM_HIGHSCORES];  // sorted descending
+    uint8_t levelMax;
+};
+
+class GameStats{
+
+    public:
+        GameStats(UDPLogger *mylogger);
+        void begin();
+        void loopCycle();
+        void addGame(uint8_t gameId, Game *game, bool bot);
+        void reset();
+        String getJSON();
+
+    private:
+        void flush();
+
+        UDPLogger *_logger;
+        Preferences _preferences;
+        GameStatsEntry _entries[GAMESTATS_NUM_GAMES] = {};
+        uint8_t _dirty = 0;             // bit n is set if the entry of game n is not written yet
+        bool _flushRequested = false;   // write with the next loopCycle() (game of a player ended)
+        unsigned long _lastFlush = 0;
+};
+
+#endif
@@ -0,0 +1,505 @@
+/**
+ * @file gifdecoder.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for a streaming GIF decoder, which samples every frame down to the led grid
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "gifdecoder.h"
+
+// start row and row step of the four passes of interlaced images
+const uint8_t interlaceStart[4] = {0, 4, 2, 1};
+const uint8_t interlaceStep[4] = {8, 8, 4, 2};
+
+/**
+ * @brief Construct a new GifDecoder:: GifDecoder object
+ *
+ */
+GifDecoder::GifDecoder(){
+
+}
+
+/**
+ * @brief Open a GIF file and read the header and global color table
+ *
+ * @param path path of the file on LittleFS
+ * @return true if the file is a valid GIF
+ */
+bool GifDecoder::open(String path){
+    close();
+    _file = LittleFS.open(path, "r");
+    if (!_file) {
+        return false;
+    }
+    _open = true;
+    _bufferPos = 0;
+    _bufferLen = 0;
+
+    // header "GIF87a" or "GIF89a"
+    if (readByte() != 'G' || readByte() != 'I' || readByte() != 'F') {
+        close();
+        return false;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        readByte();
+    }
+
+    // logical screen descriptor
+    int width = readUInt16();
+    int height = readUInt16();
+    int packed = readByte();
+    readByte(); // background color index
+    readByte(); // pixel aspect ratio
+    if (width <= 0 || height <= 0 || packed < 0) {
+        close();
+        return false;
+    }
+    _screenWidth = width;
+    _screenHeight = height;
+
+    _globalColorsSize = 0;
+    if (packed & 0x80) {
+        _globalColorsSize = 2 << (packed & 0x07);
+        if (!readColorTable(_globalColors, _globalColorsSize)) {
+            close();
+            return false;
+        }
+    }
+    _firstBlockOffset = 13 + 3 * _globalColorsSize;
+
+    calcSampling(_sampleX, GRID_WIDTH, _screenWidth);
+    calcSampling(_sampleY, GRID_HEIGHT, _screenHeight);
+    return rewind();
+}
+
+/**
+ * @brief Close the GIF file
+ *
+ */
+void GifDecoder::close(){
+    if (_open) {
+        _file.close();
+    }
+    _open = false;
+}
+
+/**
+ * @brief Start again with the first frame
+ *
+ * @return true if successful
+ */
+bool GifDecoder::rewind(){
+    if (!_open || !_file.seek(_firstBlockOffset)) {
+        return false;
+    }
+    _bufferPos = 0;
+    _bufferLen = 0;
+    _lastDisposal = 0;
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        for (uint8_t x = 0; x < GRID_WIDTH; x++) {
+            canvas[y][x] = 0;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Decode the next frame into the canvas
+ *
+ * @return long delay of the frame in ms, GIFDECODER_END at the end of the file or GIFDECODER_ERROR
+ */
+long GifDecoder::decodeFrame(){
+    if (!_open) {
+        return GIFDECODER_ERROR;
+    }
+    applyDisposal();
+    _delay = 0;
+    _disposal = 0;
+    _transparentIndex = -1;
+
+    while (true) {
+        int blockType = readByte();
+        switch (blockType) {
+            case 0x21: // extension
+            {
+                int label = readByte();
+                if (label == 0xF9) {
+                    // graphic control extension
+                    readByte(); // block size (4)
+                    int packed = readByte();
+                    int delay = readUInt16();
+                    int transparentIndex = readByte();
+                    readByte(); // block terminator
+                    if (packed < 0 || delay < 0 || transparentIndex < 0) {
+                        return GIFDECODER_ERROR;
+                    }
+                    _disposal = (packed >> 2) & 0x07;
+                    if (packed & 0x01) {
+                        _transparentIndex = transparentIndex;
+                    }
+                    _delay = delay * 10;
+                }
+                else if (label < 0 || !skipSubBlocks()) {
+                    return GIFDECODER_ERROR;
+                }
+            }
+            break;
+            case 0x2C: // image descriptor
+                if (!decodeImage()) {
+                    return GIFDECODER_ERROR;
+                }
+                return (_delay >= 20) ? _delay : GIFDECODER_DEFAULT_DELAY;
+            case 0x3B: // trailer
+            case -1:   // truncated file, treat like the end
+                return GIFDECODER_END;
+            default:
+                return GIFDECODER_ERROR;
+        }
+    }
+}
+
+/**
+ * @brief Read the image descriptor and decode the image data of one frame
+ *
+ * @return true if successful
+ */
+bool GifDecoder::decodeImage(){
+    int left = readUInt16();
+    int top = readUInt16();
+    int width = readUInt16();
+    int height = readUInt16();
+    int packed = readByte();
+    if (left < 0 || top < 0 || width < 0 || height < 0 || packed < 0) {
+        return false;
+    }
+
+    _colors = _globalColors;
+    if (packed & 0x80) {
+        if (!readColorTable(_localColors, 2 << (packed & 0x07))) {
+            return false;
+        }
+        _colors = _localColors;
+    }
+
+    if (_disposal == 3) {
+        // keep canvas to restore it before the next frame
+        memcpy(_savedCanvas, canvas, sizeof(canvas));
+    }
+
+    _frameLeft = left;
+    _frameTop = top;
+    _frameWidth = width;
+    _frameHeight = height;
+    _interlaced = packed & 0x40;
+    _interlacePass = 0;
+    _frameRow = 0;
+    _frameX = 0;
+    _rowsDone = 0;
+    startRow();
+
+    bool result = decodeImageData();
+
+    _lastDisposal = _disposal;
+    _lastLeft = left;
+    _lastTop = top;
+    _lastWidth = width;
+    _lastHeight = height;
+    return result;
+}
+
+/**
+ * @brief Decode the LZW compressed image data and output the pixels to the canvas
+ *
+ * @return true if successful
+ */
+bool GifDecoder::decodeImageData(){
+    int minCodeSize = readByte();
+    if (minCodeSize < 1 || minCodeSize > 11) {
+        return false;
+    }
+    uint16_t clearCode = 1 << minCodeSize;
+    uint16_t endCode = clearCode + 1;
+    uint16_t nextCode = endCode + 1;
+    int prevCode = -1;
+    uint8_t firstChar = 0;
+
+    _codeSize = minCodeSize + 1;
+    _blockRemaining = 0;
+    _bitBuffer = 0;
+    _bitCount = 0;
+    _dataEnded = false;
+    for (uint16_t i = 0; i < clearCode; i++) {
+        _prefix[i] = 0;
+        _suffix[i] = i;
+    }
+
+    while (true) {
+        int code = readCode();
+        if (code < 0 || code == endCode) {
+            break;
+        }
+        if (code == clearCode) {
+            _codeSize = minCodeSize + 1;
+            nextCode = endCode + 1;
+            prevCode = -1;
+            continue;
+        }
+        if (prevCode < 0) {
+            // first code after clear code has to be a single pixel
+            if (code >= clearCode) {
+                return false;
+            }
+            outputPixel(code);
+            firstChar = code;
+            prevCode = code;
+            continue;
+        }
+
+        int inCode = code;
+        uint16_t sp = 0;
+        if (code >= nextCode) {
+            if (code > nextCode) {
+                return false;
+            }
+            _stack[sp++] = firstChar;
+            code = prevCode;
+        }
+        while (code >= clearCode) {
+            if (sp >= GIFDECODER_MAX_CODES - 1) {
+                return false;
+            }
+            _stack[sp++] = _suffix[code];
+            code = _prefix[code];
+        }
+        firstChar = code;
+        _stack[sp++] = firstChar;
+        while (sp > 0) {
+            outputPixel(_stack[--sp]);
+        }
+
+        if (nextCode < GIFDECODER_MAX_CODES) {
+            _prefix[nextCode] = prevCode;
+            _suffix[nextCode] = firstChar;
+            nextCode++;
+            if (nextCode == (1 << _codeSize) && _codeSize < 12) {
+                _codeSize++;
+            }
+        }
+        prevCode = inCode;
+    }
+
+    // skip rest of the image data
+    if (!_dataEnded) {
+        while (_blockRemaining > 0) {
+            readByte();
+            _blockRemaining--;
+        }
+        return skipSubBlocks();
+    }
+    return true;
+}
+
+/**
+ * @brief Apply the disposal method of the previous frame to the canvas
+ *
+ */
+void GifDecoder::applyDisposal(){
+    if (_lastDisposal == 2) {
+        // restore to background (off) in the area of the previous frame
+        for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+            for (uint8_t x = 0; x < GRID_WIDTH; x++) {
+                if (_sampleX[x] >= _lastLeft && _sampleX[x] < _lastLeft + _lastWidth
+                        && _sampleY[y] >= _lastTop && _sampleY[y] < _lastTop + _lastHeight) {
+                    canvas[y][x] = 0;
+                }
+            }
+        }
+    }
+    else if (_lastDisposal == 3) {
+        // restore to previous
+        memcpy(canvas, _savedCanvas, sizeof(canvas));
+    }
+    _lastDisposal = 0;
+}
+
+/**
+ * @brief Calculate which source pixel is shown for each grid pixel of one axis.
+ * Larger images are downsampled, smaller images are centered.
+ *
+ * @param sampling array for the source coordinate of each grid coordinate
+ * @param gridSize size of the grid in this axis
+ * @param screenSize size of the image in this axis
+ */
+void GifDecoder::calcSampling(uint16_t *sampling, uint8_t gridSize, uint16_t screenSize){
+    if (screenSize >= gridSize) {
+        // sample the center of each area
+        for (uint8_t i = 0; i < gridSize; i++) {
+            sampling[i] = (uint32_t)(2 * i + 1) * screenSize / (2 * gridSize);
+        }
+    } else {
+        uint8_t offset = (gridSize - screenSize) / 2;
+        for (uint8_t i = 0; i < gridSize; i++) {
+            sampling[i] = (i >= offset && i < offset + screenSize) ? i - offset : GIFDECODER_NO_SAMPLE;
+        }
+    }
+}
+
+/**
+ * @brief Prepare the output of a new row: find the grid row and the first grid column of it
+ *
+ */
+void GifDecoder::startRow(){
+    uint16_t screenY = _frameTop + _frameRow;
+    _targetRow = -1;
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        if (_sampleY[y] == screenY) {
+            _targetRow = y;
+            break;
+        }
+    }
+    _nextTargetColumn = 0;
+    while (_nextTargetColumn < GRID_WIDTH
+            && (_sampleX[_nextTargetColumn] == GIFDECODER_NO_SAMPLE || _sampleX[_nextTargetColumn] < _frameLeft)) {
+        _nextTargetColumn++;
+    }
+}
+
+/**
+ * @brief Output the next pixel of the frame, only sampled pixels are written to the canvas
+ *
+ * @param colorIndex index of the pixel color in the active color table
+ */
+void GifDecoder::outputPixel(uint8_t colorIndex){
+    if (_rowsDone >= _frameHeight) {
+        // ignore surplus data
+        return;
+    }
+    if (_targetRow >= 0 && _nextTargetColumn < GRID_WIDTH && _frameLeft + _frameX == _sampleX[_nextTargetColumn]) {
+        if (colorIndex != _transparentIndex) {
+            canvas[_targetRow][_nextTargetColumn] = ((uint32_t)_colors[colorIndex][0] << 16)
+                                                   | ((uint32_t)_colors[colorIndex][1] << 8)
+                                                   | _colors[colorIndex][2];
+        }
+        _nextTargetColumn++;
+    }
+
+    _frameX++;
+    if (_frameX >= _frameWidth) {
+        // next row
+        _frameX = 0;
+        _rowsDone++;
+        if (_interlaced) {
+            _frameRow += interlaceStep[_interlacePass];
+            while (_frameRow >= _frameHeight && _interlacePass < 3) {
+                _interlacePass++;
+                _frameRow = interlaceStart[_interlacePass];
+            }
+        } else {
+            _frameRow++;
+        }
+        startRow();
+    }
+}
+
+/**
+ * @brief Read a color table from the file
+ *
+ * @param table table to be filled
+ * @param size number of entries
+ * @return true if successful
+ */
+bool GifDecoder::readColorTable(uint8_t table[256][3], uint16_t size){
+    for (uint16_t i = 0; i < size; i++) {
+        for (uint8_t c = 0; c < 3; c++) {
+            int value = readByte();
+            if (value < 0) {
+                return false;
+            }
+            table[i][c] = value;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Skip a sequence of data sub-blocks (until the block terminator)
+ *
+ * @return true if successful
+ */
+bool GifDecoder::skipSubBlocks(){
+    while (true) {
+        int size = readByte();
+        if (size < 0) {
+            return false;
+        }
+        if (size == 0) {
+            return true;
+        }
+        for (int i = 0; i < size; i++) {
+            readByte();
+        }
+    }
+}
+
+/**
+ * @brief Read next byte from the file (through the read-ahead buffer)
+ *
+ * @return int byte value, -1 at end of file
+ */
+int GifDecoder::readByte(){
+    if (_bufferPos >= _bufferLen) {
+        _bufferLen = _file.read(_buffer, GIFDECODER_BUFFER_SIZE);
+        _bufferPos = 0;
+        if (_bufferLen == 0) {
+            return -1;
+        }
+    }
+    return _buffer[_bufferPos++];
+}
+
+/**
+ * @brief Read next 16bit value (little endian) from the file
+ *
+ * @return int value, -1 at end of file
+ */
+int GifDecoder::readUInt16(){
+    int low = readByte();
+    int high = readByte();
+    if (low < 0 || high < 0) {
+        return -1;
+    }
+    return low | (high << 8);
+}
+
+/**
+ * @brief Read next LZW code from the image data sub-blocks
+ *
+ * @return int code, -1 at the end of the image data
+ */
+int GifDecoder::readCode(){
+    while (_bitCount < _codeSize) {
+        if (_blockRemaining == 0) {
+            int size = readByte();
+            if (size <= 0) {
+                _dataEnded = true;
+                return -1;
+            }
+            _blockRemaining = size;
+        }
+        int value = readByte();
+        if (value < 0) {
+            _dataEnded = true;
+            return -1;
+        }
+        _blockRemaining--;
+        _bitBuffer |= (uint32_t)value << _bitCount;
+        _bitCount += 8;
+    }
+    int code = _bitBuffer & ((1 << _codeSize) - 1);
+    _bitBuffer >>= _codeSize;
+    _bitCount -= _codeSize;
+    return code;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file gifdecoder.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for a streaming GIF decoder, which samples every frame down to the led grid
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The file is read sequentially through a small read-ahead buffer and every
+ * frame is decoded directly into a canvas of the size of the led grid.
+ * Images larger than the grid are downsampled (nearest neighbour), smaller
+ * images are centered. Neither the file nor a full-size frame is held in RAM,
+ * the working memory is fixed (mainly the LZW tables).
+ *
+ */
+#ifndef gifdecoder_h
+#define gifdecoder_h
+
+#include <Arduino.h>
+#include <FS.h>
+#include <LittleFS.h>
+#include "config.h"
+
+#define GIFDECODER_BUFFER_SIZE      64      // size of read-ahead buffer in bytes
+#define GIFDECODER_MAX_CODES        4096    // max. number of LZW codes (12 bit)
+#define GIFDECODER_DEFAULT_DELAY    100     // in ms, used for frames without delay
+#define GIFDECODER_NO_SAMPLE        0xFFFF
+
+#define GIFDECODER_END              -1      // returned by decodeFrame() at the end of the file
+#define GIFDECODER_ERROR            -2      // returned by decodeFrame() for invalid files
+
+class GifDecoder{
+
+    public:
+        GifDecoder();
+        bool open(String path);
+        void close();
+        bool rewind();
+        long decodeFrame();
+
+        // decoded frame sampled to the size of the led grid
+        uint32_t canvas[GRID_HEIGHT][GRID_WIDTH];
+
+    private:
+        bool decodeImage();
+        bool decodeImageData();
+        void applyDisposal();
+        void calcSampling(uint16_t *sampling, uint8_t gridSize, uint16_t screenSize);
+        void startRow();
+        void outputPixel(uint8_t colorIndex);
+        bool readColorTable(uint8_t table[256][3], uint16_t size);
+        bool skipSubBlocks();
+        int readByte();
+        int readUInt16();
+        int readCode();
+
+        File _file;
+        bool _open = false;
+
+        // read-ahead buffer
+        uint8_t _buffer[GIFDECODER_BUFFER_SIZE];
+        uint8_t _bufferPos = 0;
+        uint8_t _bufferLen = 0;
+        uint32_t _firstBlockOffset = 0;
+
+        uint16_t _screenWidth = 0;
+        uint16_t _screenHeight = 0;
+        uint16_t _sampleX[GRID_WIDTH];   // source column for every grid column
+        uint16_t _sampleY[GRID_HEIGHT];  // source row for every grid row
+
+        uint8_t _globalColors[256][3];
+        uint16_t _globalColorsSize = 0;
+        uint8_t _localColors[256][3];
+        uint8_t (*_colors)[3] = _globalColors;
+
+        // graphic control extension of current frame
+        uint16_t _delay = 0;
+        uint8_t _disposal = 0;
+        int16_t _transparentIndex = -1;
+
+        // disposal of previous frame
+        uint8_t _lastDisposal = 0;
+        uint16_t _lastLeft = 0, _lastTop = 0, _lastWidth = 0, _lastHeight = 0;
+        uint32_t _savedCanvas[GRID_HEIGHT][GRID_WIDTH];
+
+        // position of current pixel in current frame
+        uint16_t _frameLeft = 0, _frameTop = 0, _frameWidth = 0, _frameHeight = 0;
+        bool _interlaced = false;
+        uint8_t _interlacePass = 0;
+        uint16_t _frameRow = 0;      // row in frame (in order of the data)
+        uint16_t _frameX = 0;        // column in frame
+        uint16_t _rowsDone = 0;
+        int8_t _targetRow = -1;      // grid row of current row, -1 if row is not sampled
+        uint8_t _nextTargetColumn = 0;
+
+        // LZW state
+        uint16_t _prefix[GIFDECODER_MAX_CODES];
+        uint8_t _suffix[GIFDECODER_MAX_CODES];
+        uint8_t _stack[GIFDECODER_MAX_CODES];
+        uint8_t _codeSize = 0;
+        uint8_t _blockRemaining = 0;
+        bool _dataEnded = false;
+        uint32_t _bitBuffer = 0;
+        uint8_t _bitCount = 0;
+};
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file inputqueue.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for a bounded lock-free queue of timestamped input events (single producer, single consumer)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "inputqueue.h"
+
+/**
+ * @brief Construct a new InputQueue:: InputQueue object
+ *
+ */
+InputQueue::InputQueue() : _head(0), _tail(0), _dropped(0){
+
+}
+
+/**
+ * @brief Construct a new InputQueue:: InputQueue object as copy (needed to copy the games owning a queue)
+ *
+ * @param other queue to be copied, must not be in use
+ */
+InputQueue::InputQueue(const InputQueue &other) : _head(other._head.load()), _tail(other._tail.load()), _dropped(other._dropped.load()){
+    memcpy(_events, other._events, sizeof(_events));
+}
+
+/**
+ * @brief Push a new event made now (producer side)
+ *
+ * @param key key of the event (INPUT_KEY_...)
+ * @param action action of the event {TAP, PRESS, RELEASE}
+ * @param player id of player
+ * @return true if the event was queued, false if the queue is full
+ */
+bool InputQueue::push(uint8_t key, uint8_t action, uint8_t player){
+    InputEvent event;
+    event.time = millis();
+    event.key = key;
+    event.action = action;
+    event.player = player;
+    return push(event);
+}
+
+/**
+ * @brief Push an event (producer side)
+ *
+ * @param event event to be queued
+ * @return true if the event was queued, false if the queue is full
+ */
+bool InputQueue::push(const InputEvent &event){
+    uint8_t tail = _tail.load(std::memory_order_relaxed);
+    if ((uint8_t)(tail - _head.load(std::memory_order_acquire)) >= INPUT_QUEUE_SIZE) {
+        _dropped++;
+        return false;
+    }
+    _events[tail & (INPUT_QUEUE_SIZE - 1)] = event;
+    // publish the event after it is written completely
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Get the oldest event without removing it (consumer side)
+ *
+ * @param event oldest event
+ * @return true if there was an event
+ */
+bool InputQueue::peek(InputEvent &event){
+    uint8_t head = _head.load(std::memory_order_relaxed);
+    if (head == _tail.load(std::memory_order_acquire)) {
+        return false;
+    }
+    event = _events[head & (INPUT_QUEUE_SIZE - 1)];
+    return true;
+}
+
+/**
+ * @brief Remove and get the oldest event (consumer side)
+ *
+ * @param event oldest event
+ * @return true if there was an event
+ */
+bool InputQueue::pop(InputEvent &event){
+    if (!peek(event)) {
+        return false;
+    }
+    _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Remove all events (consumer side)
+ *
+ */
+void InputQueue::clear(){
+    _head.store(_tail.load(std::memory_order_acquire), std::memory_order_release);
+}
+
+/**
+ * @brief Get number of queued events
+ *
+ * @return uint8_t number of events
+ */
+uint8_t InputQueue::size(){
+    return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Get number of events which were dropped because the queue was full
+ *
+ * @return uint16_t number of dropped events
+ */
+uint16_t InputQueue::getDropped(){
+    return _dropped;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file inputqueue.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for a bounded lock-free queue of timestamped input events (single producer, single consumer)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The producers (webserver, bots) push events with the time they were made,
+ * the game pops them in order at its tick boundaries. Nothing is debounced or
+ * overwritten, an event is only lost if the queue is full (counted in getDropped()).
+ *
+ */
+#ifndef inputqueue_h
+#define inputqueue_h
+
+#include <Arduino.h>
+#include <atomic>
+
+#define INPUT_QUEUE_SIZE        32      // has to be a power of two
+
+#define INPUT_KEY_NONE          0
+#define INPUT_KEY_UP            1
+#define INPUT_KEY_DOWN          2
+#define INPUT_KEY_LEFT          3
+#define INPUT_KEY_RIGHT         4
+#define INPUT_KEY_START         5
+#define INPUT_KEY_PAUSE         6
+
+#define INPUT_ACTION_TAP        0       // short press, applied once
+#define INPUT_ACTION_PRESS      1       // key held down until release
+#define INPUT_ACTION_RELEASE    2
+
+struct InputEvent {
+    unsigned long time;     // time (millis) the input was made
+    uint8_t key;
+    uint8_t action;
+    uint8_t player;
+};
+
+class InputQueue{
+
+    public:
+        InputQueue();
+        InputQueue(const InputQueue &other);
+        bool push(uint8_t key, uint8_t action = INPUT_ACTION_TAP, uint8_t player = 0);
+        bool push(const InputEvent &event);
+        bool peek(InputEvent &event);
+        bool pop(InputEvent &event);
+        void clear();
+        uint8_t size();
+        uint16_t getDropped();
+
+    private:
+        InputEvent _events[INPUT_QUEUE_SIZE];
+        std::atomic<uint8_t> _head;     // written by consumer only
+        std::atomic<uint8_t> _tail;     // written by producer only
+        std::atomic<uint16_t> _dropped;
+};
+
+#endif
@@ -0,0 +1,148 @@
+/**
+ * @file kernels.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Built-in per-pixel kernels for LEDMatrix::gridApplyKernel()
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * A kernel is a functor which calculates the color of one pixel: color = kernel(x, y).
+ * It is constructed once per frame from the time and the parameters, so everything
+ * which does not depend on the pixel position is calculated only once per frame.
+ * The kernels are passed as template parameter, so the per-pixel call is inlined.
+ *
+ */
+#ifndef kernels_h
+#define kernels_h
+
+#include <Arduino.h>
+#include "ledmatrix.h"
+#include "config.h"
+
+#define KERNEL_GRADIENT         0
+#define KERNEL_RAINBOWSWEEP     1
+#define KERNEL_RAINBOWRING      2
+#define KERNEL_BREATHING        3
+#define KERNEL_NUM_KERNELS      4
+
+// parameters of the kernels, can be adjusted via /cmd?kernel=
+struct KernelParams
+{
+    uint8_t hue = 0;    // base hue (position on color wheel)
+    uint8_t scale = 16; // hue change per pixel (gradient: hue distance between left and right border)
+    uint8_t speed = 32; // hue/phase change per second
+};
+
+/**
+ * @brief Calc the phase of an animation at time t
+ *
+ * @param t time in ms
+ * @param speed phase change per second
+ * @return uint8_t phase (wraps around)
+ */
+inline uint8_t kernelPhase(unsigned long t, uint8_t speed)
+{
+    return (uint8_t)((uint64_t)t * speed / 1000);
+}
+
+/**
+ * @brief Horizontal gradient between two colors of the color wheel
+ *
+ */
+class GradientKernel
+{
+public:
+    GradientKernel(const KernelParams &params, unsigned long t)
+    {
+        uint8_t hue = params.hue + kernelPhase(t, params.speed);
+        uint32_t colorLeft = LEDMatrix::Wheel(hue);
+        uint32_t colorRight = LEDMatrix::Wheel(hue + params.scale);
+        for (uint8_t x = 0; x < GRID_WIDTH; x++)
+        {
+            _columnColors[x] = LEDMatrix::interpolateColor24bit(colorLeft, colorRight, (float)x / (GRID_WIDTH - 1));
+        }
+    }
+    inline uint32_t operator()(uint8_t x, uint8_t y) const
+    {
+        return _columnColors[x];
+    }
+
+private:
+    uint32_t _columnColors[GRID_WIDTH];
+};
+
+/**
+ * @brief Diagonal rainbow which moves over the grid
+ *
+ */
+class RainbowSweepKernel
+{
+public:
+    RainbowSweepKernel(const KernelParams &params, unsigned long t)
+    {
+        _hue = params.hue + kernelPhase(t, params.speed);
+        _scale = params.scale;
+    }
+    inline uint32_t operator()(uint8_t x, uint8_t y) const
+    {
+        return LEDMatrix::Wheel(_hue + (x + y) * _scale);
+    }
+
+private:
+    uint8_t _hue;
+    uint8_t _scale;
+};
+
+/**
+ * @brief Rainbow in square rings around the center of the grid (same shape as the spiral animation)
+ *
+ */
+class RainbowRingKernel
+{
+public:
+    RainbowRingKernel(const KernelParams &params, unsigned long t)
+    {
+        _hue = params.hue + kernelPhase(t, params.speed);
+        _scale = params.scale;
+    }
+    inline uint32_t operator()(uint8_t x, uint8_t y) const
+    {
+        uint8_t dx = abs(x - (GRID_WIDTH - 1) / 2);
+        uint8_t dy = abs(y - (GRID_HEIGHT - 1) / 2);
+        return LEDMatrix::Wheel(_hue + max(dx, dy) * _scale);
+    }
+
+private:
+    uint8_t _hue;
+    uint8_t _scale;
+};
+
+/**
+ * @brief All pixels in one color, brightness fades in and out
+ *
+ */
+class BreathingKernel
+{
+public:
+    BreathingKernel(const KernelParams &params, unsigned long t)
+    {
+        // triangle wave, squared for a more natural fading
+        uint8_t phase = kernelPhase(t, params.speed);
+        uint16_t level = (phase < 128) ? phase * 2 : (255 - phase) * 2;
+        level = level * level / 255;
+        uint32_t color = LEDMatrix::Wheel(params.hue);
+        _color = LEDMatrix::Color24bit((color >> 16 & 0xff) * level / 255,
+                                       (color >> 8 & 0xff) * level / 255,
+                                       (color & 0xff) * level / 255);
+    }
+    inline uint32_t operator()(uint8_t x, uint8_t y) const
+    {
+        return _color;
+    }
+
+private:
+    uint32_t _color;
+};
+
+#endif
@@ -0,0 +1,105 @@
+/**
+ * @file latencyhistogram.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for a histogram of latencies with logarithmic buckets (percentiles without storing the samples)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "latencyhistogram.h"
+
+/**
+ * @brief Construct a new LatencyHistogram:: LatencyHistogram object
+ *
+ */
+LatencyHistogram::LatencyHistogram(){
+    reset();
+}
+
+/**
+ * @brief Add a latency
+ *
+ * @param micros latency in us
+ */
+void LatencyHistogram::add(unsigned long micros){
+    uint8_t bucket = 0;
+    while (bucket < LATENCY_BUCKETS - 1 && (micros >> (bucket + 1)) > 0) {
+        bucket++;
+    }
+    _buckets[bucket]++;
+    _count++;
+    if (micros > _max) {
+        _max = micros;
+    }
+}
+
+/**
+ * @brief Remove all latencies
+ *
+ */
+void LatencyHistogram::reset(){
+    memset(_buckets, 0, sizeof(_buckets));
+    _count = 0;
+    _max = 0;
+}
+
+/**
+ * @brief Get number of latencies
+ *
+ * @return uint32_t number of latencies
+ */
+uint32_t LatencyHistogram::getCount(){
+    return _count;
+}
+
+/**
+ * @brief Get the longest latency
+ *
+ * @return unsigned long latency in us
+ */
+unsigned long LatencyHistogram::getMax(){
+    return _max;
+}
+
+/**
+ * @brief Get a percentile of the latencies
+ *
+ * @param percent percentile (e.g. 50, 99)
+ * @return unsigned long upper bound of the percentile in us, 0 if there is no latency
+ */
+unsigned long LatencyHistogram::getPercentile(uint8_t percent){
+    if (_count == 0) {
+        return 0;
+    }
+    uint32_t rank = ((uint64_t)_count * percent + 99) / 100;
+    uint32_t sum = 0;
+    for (uint8_t i = 0; i < LATENCY_BUCKETS; i++) {
+        sum += _buckets[i];
+        if (sum >= rank) {
+            if (i == LATENCY_BUCKETS - 1) {
+                // last bucket has no upper bound (it takes all longer latencies)
+                return _max;
+            }
+            // upper bound of the bucket, but never more than the longest latency
+            return min((unsigned long)((2UL << i) - 1), _max);
+        }
+    }
+    return _max;
+}
+
+/**
+ * @brief Get count, percentiles and max. as JSON object
+ *
+ * @return String JSON object
+ */
+String LatencyHistogram::getJSON(){
+    String message = "{";
+    message += "\"count\":\"" + String(_count) + "\"";
+    message += ",\"p50\":\"" + String(getPercentile(50)) + "\"";
+    message += ",\"p99\":\"" + String(getPercentile(99)) + "\"";
+    message += ",\"max\":\"" + String(_max) + "\"";
+    message += "}";
+    return message;
+}
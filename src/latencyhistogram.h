@@ -0,0 +1,40 @@
+/**
+ * @file latencyhistogram.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for a histogram of latencies with logarithmic buckets (percentiles without storing the samples)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Bucket n counts the latencies in [2^n, 2^(n+1)) us, so the percentiles are
+ * upper bounds with a resolution of a factor of two. The last bucket also
+ * counts all longer latencies, its percentiles are the longest latency.
+ * add() must be called by one task only, reading from another task is fine.
+ *
+ */
+#ifndef latencyhistogram_h
+#define latencyhistogram_h
+
+#include <Arduino.h>
+
+#define LATENCY_BUCKETS     24      // up to 2^24 us = 16.7 s
+
+class LatencyHistogram{
+
+    public:
+        LatencyHistogram();
+        void add(unsigned long micros);
+        void reset();
+        uint32_t getCount();
+        unsigned long getMax();
+        unsigned long getPercentile(uint8_t percent);
+        String getJSON();
+
+    private:
+        uint32_t _buckets[LATENCY_BUCKETS];
+        uint32_t _count = 0;
+        unsigned long _max = 0;
+};
+
+#endif
@@ -1,5 +1,4 @@
 #include "ledmatrix.h"
-#include "own_font.h"
 
 /**
  * @brief Construct a new LEDMatrix::LEDMatrix object
@@ -139,6 +138,20 @@ void LEDMatrix::setMinIndicator(uint8_t pattern, uint32_t color)
   }
 }
 
+/**
+ * @brief Set the color of a single minute indicator led
+ *
+ * @param index index of the indicator (clockwise order, same as the bits of setMinIndicator())
+ * @param color color to be displayed
+ */
+void LEDMatrix::setIndicator(uint8_t index, uint32_t color)
+{
+  if (index < NUM_MIN_INDICATORS)
+  {
+    targetindicators[index] = color;
+  }
+}
+
 /**
  * @brief "Activates" a pixel in targetgrid with color
  *
@@ -159,6 +172,27 @@ void LEDMatrix::gridAddPixel(uint8_t x, uint8_t y, uint32_t color)
   }
 }
 
+/**
+ * @brief Adds a weighted color to a pixel in targetgrid (additive, saturating at full brightness)
+ *
+ * @param x x-position of pixel
+ * @param y y-position of pixel
+ * @param color color to be added
+ * @param weight weight of the color (0 - 256, 256 = full color)
+ */
+void LEDMatrix::gridBlendPixel(uint8_t x, uint8_t y, uint32_t color, uint16_t weight)
+{
+  // limit ranges of x and y
+  if (x < GRID_WIDTH && y < GRID_HEIGHT && weight > 0)
+  {
+    uint32_t current = targetgrid[y][x];
+    uint16_t red = (current >> 16 & 0xff) + (((color >> 16 & 0xff) * weight) >> 8);
+    uint16_t green = (current >> 8 & 0xff) + (((color >> 8 & 0xff) * weight) >> 8);
+    uint16_t blue = (current & 0xff) + (((color & 0xff) * weight) >> 8);
+    targetgrid[y][x] = Color24bit(min(red, (uint16_t)255), min(green, (uint16_t)255), min(blue, (uint16_t)255));
+  }
+}
+
 /**
  * @brief "Deactivates" all pixels in targetgrid
  *
@@ -221,7 +255,7 @@ void LEDMatrix::drawOnMatrix(float factor)
   }
 
   // loop over all minute indicator leds (positioned at the end of the LED strip)
-  for (int i = 0; i < 4; i++)
+  for (int i = 0; i < NUM_MIN_INDICATORS; i++)
   {
     // Force immediate update (factor = 1.0) when target is off to ensure complete turn-off
     float indicatorFactor = (targetindicators[i] == 0) ? 1.0 : factor;
@@ -242,60 +276,6 @@ void LEDMatrix::drawOnMatrix(float factor)
   (*neomatrix).show();
 }
 
-/**
- * @brief Shows a 1-digit number on LED matrix (5x3)
- *
- * @param xpos x of left top corner of digit
- * @param ypos y of left top corner of digit
- * @param number number to display
- * @param color color to display (24bit)
- */
-void LEDMatrix::printNumber(uint8_t xpos, uint8_t ypos, uint8_t number, uint32_t color)
-{
-  for (int y = ypos, i = 0; y < (ypos + 5); y++, i++)
-  {
-    for (int x = xpos, k = 2; x < (xpos + 3); x++, k--)
-    {
-      if ((numbers_font[number][i] >> k) & 0x1)
-      {
-        gridAddPixel(x, y, color);
-      }
-    }
-  }
-}
-
-/**
- * @brief Shows a character on LED matrix (5x3), supports currently only 'I' and 'P'
- *
- * @param xpos x of left top corner of character
- * @param ypos y of left top corner of character
- * @param character character to display
- * @param color color to display (24bit)
- */
-void LEDMatrix::printChar(uint8_t xpos, uint8_t ypos, char character, uint32_t color)
-{
-  int id = 0;
-  if (character == 'I')
-  {
-    id = 0;
-  }
-  else if (character == 'P')
-  {
-    id = 1;
-  }
-
-  for (int y = ypos, i = 0; y < (ypos + 5); y++, i++)
-  {
-    for (int x = xpos, k = 2; x < (xpos + 3); x++, k--)
-    {
-      if ((chars_font[id][i] >> k) & 0x1)
-      {
-        gridAddPixel(x, y, color);
-      }
-    }
-  }
-}
-
 /**
  * @brief Set Brightness
  *
@@ -5,11 +5,13 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_NeoMatrix.h>
 #include "udplogger.h"
+#include "framebuffer.h"
 #include "config.h"
 
 #define DEFAULT_CURRENT_LIMIT 9999
+#define NUM_MIN_INDICATORS 4 // minute indicator leds at the end of the strip
 
-class LEDMatrix
+class LEDMatrix : public Framebuffer
 {
 public:
     LEDMatrix(Adafruit_NeoMatrix *mymatrix, uint8_t mybrightness, UDPLogger *mylogger);
@@ -19,12 +21,16 @@ public:
     static uint32_t interpolateColor24bit(uint32_t color1, uint32_t color2, float factor);
     void setupMatrix();
     void setMinIndicator(uint8_t pattern, uint32_t color);
-    void gridAddPixel(uint8_t x, uint8_t y, uint32_t color);
-    void gridFlush(void);
+    void setIndicator(uint8_t index, uint32_t color);
+    void gridAddPixel(uint8_t x, uint8_t y, uint32_t color) override;
+    void gridBlendPixel(uint8_t x, uint8_t y, uint32_t color, uint16_t weight) override;
+    void gridFlush(void) override;
+    template <typename Kernel>
+    void gridApplyKernel(const Kernel &kernel);
+    template <typename Kernel>
+    void gridApplyKernelMasked(const Kernel &kernel);
     void drawOnMatrixInstant();
     void drawOnMatrixSmooth(float factor);
-    void printNumber(uint8_t xpos, uint8_t ypos, uint8_t number, uint32_t color);
-    void printChar(uint8_t xpos, uint8_t ypos, char character, uint32_t color);
     void setBrightness(uint8_t mybrightness);
     void setCurrentLimit(uint16_t mycurrentLimit);
 
@@ -60,13 +66,50 @@ private:
                                                      {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}};
 
     // target representation of minutes indicator leds
-    uint32_t targetindicators[4] = {0, 0, 0, 0};
+    uint32_t targetindicators[NUM_MIN_INDICATORS] = {0, 0, 0, 0};
 
     // current representation of minutes indicator leds
-    uint32_t currentindicators[4] = {0, 0, 0, 0};
+    uint32_t currentindicators[NUM_MIN_INDICATORS] = {0, 0, 0, 0};
 
     void drawOnMatrix(float factor);
     uint16_t calcEstimatedLEDCurrent(uint32_t color);
 };
 
+/**
+ * @brief Evaluate a kernel for every pixel of the targetgrid, color = kernel(x, y)
+ *
+ * @param kernel functor (or function) returning the 24bit color of pixel x, y (see kernels.h)
+ */
+template <typename Kernel>
+void LEDMatrix::gridApplyKernel(const Kernel &kernel)
+{
+  for (uint8_t y = 0; y < GRID_HEIGHT; y++)
+  {
+    for (uint8_t x = 0; x < GRID_WIDTH; x++)
+    {
+      targetgrid[y][x] = kernel(x, y);
+    }
+  }
+}
+
+/**
+ * @brief Evaluate a kernel only for the pixels of the targetgrid which are already on (recolor drawn shapes)
+ *
+ * @param kernel functor (or function) returning the 24bit color of pixel x, y (see kernels.h)
+ */
+template <typename Kernel>
+void LEDMatrix::gridApplyKernelMasked(const Kernel &kernel)
+{
+  for (uint8_t y = 0; y < GRID_HEIGHT; y++)
+  {
+    for (uint8_t x = 0; x < GRID_WIDTH; x++)
+    {
+      if (targetgrid[y][x] != 0)
+      {
+        targetgrid[y][x] = kernel(x, y);
+      }
+    }
+  }
+}
+
 #endif
\ No newline at end of file
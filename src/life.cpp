@@ -0,0 +1,235 @@
+/**
+ * @file life.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for the cellular automaton animation (Game of Life and variants)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "life.h"
+
+// Conway is listed twice to be chosen more often
+const Life::Rule Life::_rules[Life::_numRules] = {
+    {"Conway B3/S23",           (1 << 3),                                   (1 << 2) | (1 << 3)},
+    {"Conway B3/S23",           (1 << 3),                                   (1 << 2) | (1 << 3)},
+    {"HighLife B36/S23",        (1 << 3) | (1 << 6),                        (1 << 2) | (1 << 3)},
+    {"Morley B368/S245",        (1 << 3) | (1 << 6) | (1 << 8),             (1 << 2) | (1 << 4) | (1 << 5)},
+    {"DayNight B3678/S34678",   (1 << 3) | (1 << 6) | (1 << 7) | (1 << 8), (1 << 3) | (1 << 4) | (1 << 6) | (1 << 7) | (1 << 8)}
+};
+
+/**
+ * @brief Construct a new Life:: Life object
+ *
+ */
+Life::Life(){
+
+}
+
+/**
+ * @brief Construct a new Life:: Life object
+ *
+ * @param myledmatrix pointer to LEDMatrix object, need to provide gridAddPixel(x, y, col), gridFlush()
+ * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
+ */
+Life::Life(LEDMatrix *myledmatrix, UDPLogger *mylogger){
+    _ledmatrix = myledmatrix;
+    _logger = mylogger;
+}
+
+/**
+ * @brief Initialize the animation with a new random field
+ *
+ */
+void Life::initGame(){
+    seed();
+    printField();
+}
+
+/**
+ * @brief Run main loop for one cycle (= one generation)
+ *
+ */
+void Life::loopCycle(){
+    nextGeneration();
+
+    uint32_t hash = hashGeneration();
+    if (hash == 0 || isRepeating(hash)) {
+        // extinct, still life or short cycle -> show it for a few generations, then reseed
+        _stagnantCount++;
+    }
+    else {
+        // only consecutive stagnant generations count
+        _stagnantCount = 0;
+    }
+    if (_stagnantCount > LIFE_STAGNATION_STEPS || _generation >= LIFE_MAX_GENERATIONS) {
+        (*_logger).logString("Life: reseed after " + String(_generation) + " generations");
+        seed();
+    }
+    printField();
+}
+
+/**
+ * @brief Fill the field randomly and choose a new rule and color
+ *
+ */
+void Life::seed(){
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        uint16_t row = 0;
+        for (uint8_t x = 0; x < GRID_WIDTH; x++) {
+            if (random(100) < LIFE_SEED_DENSITY) {
+                row |= (1 << x);
+            }
+        }
+        _rows[y] = row;
+        _bornRows[y] = row;
+    }
+    for (uint8_t i = 0; i < LIFE_HISTORY; i++) {
+        _history[i] = 0;
+    }
+    _historyIndex = 0;
+    _stagnantCount = 0;
+    _generation = 0;
+    _rule = random(_numRules);
+    _hue = random(256);
+    (*_logger).logString("Life: seed with rule " + String(_rules[_rule].name));
+}
+
+/**
+ * @brief Calculate the next generation of the whole field.
+ *
+ * The eight neighbours of all cells of one row are summed up at once in four
+ * bit planes (bit-sliced counter), the rule is then applied to the whole row.
+ *
+ */
+void Life::nextGeneration(){
+    uint16_t next[GRID_HEIGHT];
+    const Rule &rule = _rules[_rule];
+
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        uint16_t above = _rows[(y + GRID_HEIGHT - 1) % GRID_HEIGHT];
+        uint16_t row = _rows[y];
+        uint16_t below = _rows[(y + 1) % GRID_HEIGHT];
+
+        uint16_t neighbours[8] = {westNeighbours(above), above, eastNeighbours(above),
+                                  westNeighbours(row), eastNeighbours(row),
+                                  westNeighbours(below), below, eastNeighbours(below)};
+
+        // bit planes of the neighbour count (s0 = 1s, s1 = 2s, s2 = 4s, s3 = 8s)
+        uint16_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for (uint8_t i = 0; i < 8; i++) {
+            uint16_t carry0 = s0 & neighbours[i];
+            s0 ^= neighbours[i];
+            uint16_t carry1 = s1 & carry0;
+            s1 ^= carry0;
+            uint16_t carry2 = s2 & carry1;
+            s2 ^= carry1;
+            s3 |= carry2;
+        }
+
+        uint16_t born = 0;
+        uint16_t survive = 0;
+        for (uint8_t n = 0; n <= 8; n++) {
+            if (!(((rule.birth | rule.survive) >> n) & 1)) {
+                continue;
+            }
+            uint16_t count = ((n & 1) ? s0 : ~s0) & ((n & 2) ? s1 : ~s1)
+                           & ((n & 4) ? s2 : ~s2) & ((n & 8) ? s3 : ~s3);
+            if ((rule.birth >> n) & 1) {
+                born |= count;
+            }
+            if ((rule.survive >> n) & 1) {
+                survive |= count;
+            }
+        }
+
+        next[y] = ((row & survive) | (~row & born)) & LIFE_ROW_MASK;
+        _bornRows[y] = next[y] & ~row;
+    }
+
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        _rows[y] = next[y];
+    }
+    _generation++;
+}
+
+/**
+ * @brief Calculate a hash (FNV-1a) of the current generation
+ *
+ * @return uint32_t hash, 0 if no cell is alive
+ */
+uint32_t Life::hashGeneration(){
+    uint32_t hash = 2166136261UL;
+    uint16_t population = 0;
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        population |= _rows[y];
+        hash = (hash ^ (_rows[y] & 0xff)) * 16777619UL;
+        hash = (hash ^ (_rows[y] >> 8)) * 16777619UL;
+    }
+    if (population == 0) {
+        return 0;
+    }
+    return hash;
+}
+
+/**
+ * @brief Check if the generation was already seen within the last LIFE_HISTORY generations
+ * and add it to the history
+ *
+ * @param hash hash of the current generation
+ * @return true if the generation repeats (still life or cycle)
+ */
+bool Life::isRepeating(uint32_t hash){
+    bool found = false;
+    for (uint8_t i = 0; i < LIFE_HISTORY; i++) {
+        if (_history[i] == hash) {
+            found = true;
+            break;
+        }
+    }
+    _history[_historyIndex] = hash;
+    _historyIndex = (_historyIndex + 1) % LIFE_HISTORY;
+    return found;
+}
+
+/**
+ * @brief Draw current field to the targetgrid of the led matrix,
+ * the fading between generations is done by the smoothing of LEDMatrix
+ *
+ */
+void Life::printField(){
+    uint32_t colorAlive = LEDMatrix::Wheel(_hue + _generation / 4);
+    uint32_t colorBorn = LEDMatrix::interpolateColor24bit(colorAlive, 0xFFFFFF, 0.4);
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        for (uint8_t x = 0; x < GRID_WIDTH; x++) {
+            uint32_t color = 0;
+            if ((_bornRows[y] >> x) & 1) {
+                color = colorBorn;
+            } else if ((_rows[y] >> x) & 1) {
+                color = colorAlive;
+            }
+            (*_ledmatrix).gridAddPixel(x, y, color);
+        }
+    }
+}
+
+/**
+ * @brief Get the west neighbours of all cells of a row (with wrap around)
+ *
+ * @param row bitmask of the row
+ * @return uint16_t bitmask, bit x contains cell x-1
+ */
+uint16_t Life::westNeighbours(uint16_t row){
+    return ((row << 1) | (row >> (GRID_WIDTH - 1))) & LIFE_ROW_MASK;
+}
+
+/**
+ * @brief Get the east neighbours of all cells of a row (with wrap around)
+ *
+ * @param row bitmask of the row
+ * @return uint16_t bitmask, bit x contains cell x+1
+ */
+uint16_t Life::eastNeighbours(uint16_t row){
+    return ((row >> 1) | (row << (GRID_WIDTH - 1))) & LIFE_ROW_MASK;
+}
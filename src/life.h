@@ -0,0 +1,72 @@
+/**
+ * @file life.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for the cellular automaton animation (Game of Life and variants)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The field is stored as one bitmask per row (bit x = cell x), so a whole row
+ * is computed at once with bit-parallel neighbour counting. The field wraps
+ * around on all sides (torus).
+ *
+ */
+#ifndef life_h
+#define life_h
+
+#include <Arduino.h>
+#include "ledmatrix.h"
+#include "udplogger.h"
+#include "config.h"
+
+#define LIFE_ROW_MASK ((uint16_t)((1 << GRID_WIDTH) - 1))
+
+#define LIFE_SEED_DENSITY       35    // percentage of living cells after seeding
+#define LIFE_HISTORY            8     // number of generation hashes kept for cycle detection (max. detected period)
+#define LIFE_STAGNATION_STEPS   6     // generations a still life or cycle is shown before reseeding
+#define LIFE_MAX_GENERATIONS    400   // reseed after this number of generations in any case
+#define LIFE_SMOOTHING_FACTOR   0.3   // smoothing factor for the cross-fade of the cells
+
+class Life{
+
+    // birth and survive rules as bitmasks over the number of neighbours (bit n = n neighbours)
+    struct Rule {
+        const char *name;
+        uint16_t birth;
+        uint16_t survive;
+    };
+
+    public:
+        Life();
+        Life(LEDMatrix *myledmatrix, UDPLogger *mylogger);
+        void initGame();
+        void loopCycle();
+
+    private:
+        void seed();
+        void nextGeneration();
+        uint32_t hashGeneration();
+        bool isRepeating(uint32_t hash);
+        void printField();
+
+        static uint16_t westNeighbours(uint16_t row);
+        static uint16_t eastNeighbours(uint16_t row);
+
+        LEDMatrix *_ledmatrix;
+        UDPLogger *_logger;
+
+        uint16_t _rows[GRID_HEIGHT];
+        uint16_t _bornRows[GRID_HEIGHT];
+        uint32_t _history[LIFE_HISTORY];
+        uint8_t _historyIndex = 0;
+        uint8_t _stagnantCount = 0;
+        uint16_t _generation = 0;
+        uint8_t _rule = 0;
+        uint8_t _hue = 0;
+
+        static const uint8_t _numRules = 5;
+        static const Rule _rules[_numRules];   // shared by all instances, not part of the mode state
+};
+
+#endif
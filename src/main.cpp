@@ -28,13 +28,13 @@
 #include <WiFi.h>
 #include <WiFiUdp.h>
 #include <ArduinoOTA.h>
-#include <WebServer.h>
 #include <LittleFS.h>  // Add LittleFS support for ESP32
-#include "Base64.h" // copied from https://github.com/Xander-Electronics/Base64
 #include <DNSServer.h>
 #include <WiFiManager.h>             //https://github.com/tzapu/WiFiManager WiFi Configuration Magic
+#include <ESPAsyncWebServer.h>       //https://github.com/me-no-dev/ESPAsyncWebServer (include after WiFiManager, both define HTTP_GET etc.)
 #include <EEPROM.h>                  //from ESP8266 Arduino Core (automatically installed when ESP8266 was installed via Boardmanager)
 #include <ESP_DoubleResetDetector.h> //https://github.com/khoih-prog/ESP_DoubleResetDetector
+#include <mutex>
 
 // ----------------------------------------------------------------------------------
 //                                        CONSTANTS
@@ -52,6 +52,10 @@
 // number of colors in colors array
 #define NUM_COLORS 7
 
+// number of pixels of a picture for /leddirect: grid, optionally followed by the minute indicators
+#define LEDDIRECT_GRID_PIXELS (GRID_WIDTH * GRID_HEIGHT)
+#define LEDDIRECT_FRAME_PIXELS (LEDDIRECT_GRID_PIXELS + NUM_MIN_INDICATORS)
+
 // own datatype for matrix movement (snake and spiral)
 enum direction
 {
@@ -62,7 +66,7 @@ enum direction
 };
 
 // own datatype for state machine states
-#define NUM_STATES 6
+#define NUM_STATES 11
 enum ClockState
 {
   st_clock,
@@ -70,22 +74,37 @@ enum ClockState
   st_spiral,
   st_tetris,
   st_snake,
-  st_pingpong
+  st_pingpong,
+  st_life,
+  st_particles,
+  st_player,
+  st_kernel,
+  st_breakout
 };
-const String stateNames[] = {"Clock", "DiClock", "Spiral", "Tetris", "Snake", "PingPong"};
+const String stateNames[] = {"Clock", "DiClock", "Spiral", "Tetris", "Snake", "PingPong", "Life", "Particles", "Player", "Kernel", "Breakout"};
 // PERIODS for each state (different for stateAutoChange or Manual mode)
 const uint16_t PERIODS[2][NUM_STATES] = {{PERIOD_TIMEVISUUPDATE, // stateAutoChange = 0
                                           PERIOD_TIMEVISUUPDATE,
                                           PERIOD_ANIMATION,
                                           PERIOD_TETRIS,
                                           PERIOD_SNAKE,
-                                          PERIOD_PONG},
+                                          PERIOD_PONG,
+                                          PERIOD_LIFE,
+                                          PERIOD_PARTICLES,
+                                          PERIOD_PLAYER,
+                                          PERIOD_KERNEL,
+                                          PERIOD_BREAKOUT},
                                          {PERIOD_TIMEVISUUPDATE, // stateAutoChange = 1
                                           PERIOD_TIMEVISUUPDATE,
                                           PERIOD_ANIMATION,
-                                          PERIOD_ANIMATION,
-                                          PERIOD_ANIMATION,
-                                          PERIOD_PONG}};
+                                          PERIOD_TETRIS,
+                                          PERIOD_SNAKE,
+                                          PERIOD_PONG,
+                                          PERIOD_LIFE,
+                                          PERIOD_PARTICLES,
+                                          PERIOD_PLAYER,
+                                          PERIOD_KERNEL,
+                                          PERIOD_BREAKOUT}};
 
 // ports
 const unsigned int localPort = 2390;
@@ -111,11 +130,28 @@ const char WebserverURL[] = "www.wordclock.local";
 #include "otafunctions.h"
 #include "udplogger.h"
 #include "ledmatrix.h"
+#include "kernels.h"
 #include "animationfunctions.h"
 #include "ntp_client_plus.h"
 #include "tetris.h"
+#include "tetrisbot.h"
 #include "snake.h"
+#include "snakebot.h"
 #include "pong.h"
+#include "pongnet.h"
+#include "breakout.h"
+#include "gamebench.h"
+#include "gamestats.h"
+#include "gamerecord.h"
+#include "commandqueue.h"
+#include "latencyhistogram.h"
+#include "pixelstream.h"
+#include "ddpreceiver.h"
+#include "changebus.h"
+#include "life.h"
+#include "particles.h"
+#include "animplayer.h"
+#include "modearena.h"
 #include "wordclockfunctions.h"
 #include "LittleFS_helper.h"
 
@@ -123,8 +159,23 @@ const char WebserverURL[] = "www.wordclock.local";
 //                                        GLOBAL VARIABLES
 // ----------------------------------------------------------------------------------
 
-// Webserver
-WebServer server(HTTPPort);
+// Webserver (async, the handlers run in the task of the TCP stack)
+AsyncWebServer server(HTTPPort);
+CommandQueue commandQueue;         // commands of the handlers, executed in the main loop
+LatencyHistogram commandLatency;   // time from receiving a command until it is executed in the main loop
+LatencyHistogram handlerLatency;   // time of the request handlers
+AsyncWebSocket ws("/ws");          // persistent control channel of the web UI (commands in, state out)
+std::atomic<bool> wsStateRequested(false); // a client connected, send the state with the next cycle
+String wsLastState;                // last state sent to the clients
+AsyncEventSource events("/events"); // server-sent events of the changed settings
+std::atomic<bool> eventsStateRequested(false); // a client connected, send all settings with the next cycle
+ChangeBus changeBus;               // changed settings, collected only while a client of "/events" is connected
+// answers of "/data" per key, built by the main loop (publishDataSnapshot()) and only copied by the handler
+#define NUM_DATA_KEYS 5
+const char *const dataKeys[NUM_DATA_KEYS] = {"mode", "bench", "stats", "ddp", "http"};
+String dataSnapshots[NUM_DATA_KEYS];
+std::mutex dataSnapshotMutex;
+long lastDataSnapshot = 0;
 
 // DNS Server
 DNSServer DnsServer;
@@ -151,10 +202,17 @@ bool spiralDir = false;
 long lastheartbeat = millis();      // time of last heartbeat sending
 long lastStep = millis();           // time of last animation step
 long lastLEDdirect = 0;             // time of last direct LED command (=> fall back to normal mode after timeout)
+bool externalPicture = false;       // a picture of /leddirect or DDP is shown, the current mode pauses
+uint32_t ledDirectFrame[LEDDIRECT_FRAME_PIXELS];   // picture of the last direct LED command (grid row by row, minute indicators)
+int ledDirectPixels = 0;                           // number of pixels in ledDirectFrame
+std::atomic<bool> ledDirectPending(false);         // picture is received, but not drawn yet
+PixelStream ledDirectStream(ledDirectFrame, LEDDIRECT_FRAME_PIXELS); // decoder of the received picture
+AsyncWebServerRequest *ledDirectReceiver = nullptr; // request which writes ledDirectFrame (only used by the handlers)
 long lastStateChange = millis();    // time of last state change
 long lastNTPUpdate = millis();      // time of last NTP update
 long lastAnimationStep = millis();  // time of last Matrix update
 long lastNightmodeCheck = millis(); // time of last nightmode check
+long lastWebSocketState = 0;        // time of last state check of the websocket clients
 long buttonPressStart = 0;          // time of push button press start
 
 // Create necessary global objects
@@ -162,9 +220,39 @@ UDPLogger logger;
 WiFiUDP NTPUDP;
 NTPClientPlus ntp = NTPClientPlus(NTPUDP, "pool.ntp.org", 1, true);
 LEDMatrix ledmatrix = LEDMatrix(&matrix, brightness, &logger);
-Tetris mytetris = Tetris(&ledmatrix, &logger);
-Snake mysnake = Snake(&ledmatrix, &logger);
-Pong mypong = Pong(&ledmatrix, &logger);
+PongNet mypongnet(nullptr, &logger);
+GameBench mygamebench = GameBench(&logger);
+GameStats mygamestats = GameStats(&logger);
+GameRecorder mygamerecorder = GameRecorder(&logger);
+DDPReceiver myddp = DDPReceiver(&ledmatrix, &logger);
+
+// game and bot of a mode live together in the mode arena
+struct TetrisMode
+{
+  Tetris game;
+  TetrisBot bot;
+  TetrisMode(LEDMatrix *myledmatrix, UDPLogger *mylogger) : game(myledmatrix, mylogger), bot(&game, mylogger) {}
+};
+struct SnakeMode
+{
+  Snake game;
+  SnakeBot bot;
+  SnakeMode(LEDMatrix *myledmatrix, UDPLogger *mylogger) : game(myledmatrix, mylogger), bot(&game, mylogger) {}
+};
+
+// state of the current mode, only one mode is alive at a time (created in entryAction, destroyed in exitAction)
+ModeArena<ModeArenaSize<sizeof(TetrisMode), sizeof(SnakeMode), sizeof(Pong), sizeof(Breakout), sizeof(Life), sizeof(Particles), sizeof(AnimationPlayer)>::value> modeArena;
+const size_t modeStateSize = sizeof(TetrisMode) + sizeof(SnakeMode) + sizeof(Pong) + sizeof(Breakout) + sizeof(Life) + sizeof(Particles) + sizeof(AnimationPlayer);
+Tetris *mytetris = nullptr;
+TetrisBot *mytetrisbot = nullptr;
+Snake *mysnake = nullptr;
+SnakeBot *mysnakebot = nullptr;
+Pong *mypong = nullptr;
+Breakout *mybreakout = nullptr;
+Life *mylife = nullptr;
+Particles *myparticles = nullptr;
+AnimationPlayer *myplayer = nullptr;
+String playerFile = ANIMPLAYER_DEFAULT_FILE; // animation file of the player mode
 
 float filterFactor = DEFAULT_SMOOTHING_FACTOR; // stores smoothing factor for led transition
 uint8_t currentState = st_clock;               // stores current state
@@ -172,8 +260,9 @@ bool stateAutoChange = false;                  // stores state of automatic stat
 bool nightMode = false;                        // stores state of nightmode
 uint32_t maincolor_clock = colors24bit[1];     // color of the clock and digital clock
 uint32_t secondcolor_clock = colors24bit[5];   // color of the clock and digital clock
-uint32_t maincolor_snake = colors24bit[1];     // color of the random snake animation
 bool apmode = false;                           // stores if WiFi AP mode is active
+uint8_t kernelType = KERNEL_RAINBOWSWEEP;      // kernel shown in kernel mode
+KernelParams kernelParams;                     // parameters of the kernel in kernel mode
 
 // nightmode settings
 int nightModeStartHour = 23;
@@ -183,6 +272,69 @@ int nightModeEndMin = 0;
 
 DoubleResetDetector *drd;
 
+/**
+ * @brief Event hook of the games: add the finished games to the statistics
+ *
+ * @param game game which triggered the event
+ * @param event GAME_EVENT_...
+ */
+void gameEventHook(Game *game, uint8_t event)
+{
+  if (event != GAME_EVENT_END)
+  {
+    return;
+  }
+  switch (currentState)
+  {
+  case st_tetris:
+    mygamestats.addGame(GAME_ID_TETRIS, game, stateAutoChange);
+    break;
+  case st_snake:
+    mygamestats.addGame(GAME_ID_SNAKE, game, stateAutoChange);
+    break;
+  case st_pingpong:
+    mygamestats.addGame(GAME_ID_PONG, game, stateAutoChange);
+    break;
+  case st_breakout:
+    mygamestats.addGame(GAME_ID_BREAKOUT, game, stateAutoChange);
+    break;
+  }
+}
+
+/**
+ * @brief Get the game of the current mode
+ *
+ * @return Game* game, nullptr if the current mode is no game
+ */
+Game *getCurrentGame()
+{
+  switch (currentState)
+  {
+  case st_tetris:
+    return mytetris;
+  case st_snake:
+    return mysnake;
+  case st_pingpong:
+    return mypong;
+  case st_breakout:
+    return mybreakout;
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Let the game of the current mode draw a complete frame, call after the grid was changed by others
+ *
+ */
+void redrawCurrentGame()
+{
+  Game *game = getCurrentGame();
+  if (game != nullptr)
+  {
+    game->redraw();
+  }
+}
+
 /**
  * @brief Write any type to EEPROM
  */
@@ -245,7 +397,10 @@ void setNightmode(bool on)
 {
   ledmatrix.gridFlush();
   ledmatrix.drawOnMatrixInstant();
+  redrawCurrentGame();
   nightMode = on;
+  myddp.setPaused(on);
+  changeBus.notify(CHANGE_NIGHTMODE);
 }
 
 /**
@@ -306,41 +461,108 @@ void entryAction(uint8_t state)
     spiral(true, spiralDir, GRID_WIDTH - 4);
     break;
   case st_tetris:
+  {
     filterFactor = 1.0; // no smoothing
+    TetrisMode *mode = modeArena.create<TetrisMode>(&ledmatrix, &logger);
+    mytetris = &mode->game;
+    mytetrisbot = &mode->bot;
+    mytetris->setEventHook(gameEventHook);
     if (stateAutoChange)
     {
-      randomtetris(true);
+      mytetrisbot->initGame();
     }
     else
     {
-      mytetris.ctrlStart();
+      mygamerecorder.start(mytetris, GAME_ID_TETRIS);
+      mytetris->ctrlStart();
     }
     break;
+  }
   case st_snake:
+  {
+    filterFactor = 1.0; // no smoothing
+    SnakeMode *mode = modeArena.create<SnakeMode>(&ledmatrix, &logger);
+    mysnake = &mode->game;
+    mysnakebot = &mode->bot;
+    mysnake->setEventHook(gameEventHook);
     if (stateAutoChange)
     {
-      randomsnake(true, 8, colors24bit[1], -1);
+      mysnakebot->initGame();
     }
     else
     {
-      filterFactor = 1.0; // no smoothing
-      mysnake.initGame();
+      mygamerecorder.start(mysnake, GAME_ID_SNAKE);
+      mysnake->initGame();
     }
     break;
+  }
   case st_pingpong:
+    filterFactor = 1.0; // no smoothing, the ball is anti-aliased
+    mypong = modeArena.create<Pong>(&ledmatrix, &logger);
+    mypong->setEventHook(gameEventHook);
+    mypongnet.setPong(mypong);
     if (stateAutoChange)
     {
-      mypong.initGame(2);
+      mypong->initGame(2);
     }
     else
     {
-      filterFactor = 1.0; // no smoothing
-      mypong.initGame(1);
+      mygamerecorder.start(mypong, GAME_ID_PONG);
+      mypong->initGame(1);
     }
     break;
+  case st_life:
+    filterFactor = LIFE_SMOOTHING_FACTOR; // cross-fade between generations
+    mylife = modeArena.create<Life>(&ledmatrix, &logger);
+    mylife->initGame();
+    break;
+  case st_particles:
+    filterFactor = PARTICLES_SMOOTHING_FACTOR;
+    myparticles = modeArena.create<Particles>(&ledmatrix, &logger);
+    myparticles->initGame();
+    break;
+  case st_player:
+    filterFactor = 1.0; // no smoothing
+    myplayer = modeArena.create<AnimationPlayer>(&ledmatrix, &logger);
+    myplayer->setFile(playerFile);
+    myplayer->initGame();
+    break;
+  case st_kernel:
+    filterFactor = 1.0; // no smoothing, the kernels are smooth by themselves
+    break;
+  case st_breakout:
+    filterFactor = 1.0; // no smoothing, the ball is anti-aliased
+    mybreakout = modeArena.create<Breakout>(&ledmatrix, &logger);
+    mybreakout->setEventHook(gameEventHook);
+    if (!stateAutoChange)
+    {
+      mygamerecorder.start(mybreakout, GAME_ID_BREAKOUT);
+    }
+    mybreakout->initGame(stateAutoChange);
+    break;
   }
 }
 
+/**
+ * @brief call exit action of the current state: destroy the state of the mode
+ *
+ */
+void exitAction()
+{
+  mygamerecorder.stop();
+  mypongnet.setPong(nullptr);
+  mytetris = nullptr;
+  mytetrisbot = nullptr;
+  mysnake = nullptr;
+  mysnakebot = nullptr;
+  mypong = nullptr;
+  mybreakout = nullptr;
+  mylife = nullptr;
+  myparticles = nullptr;
+  myplayer = nullptr;
+  modeArena.destroy();
+}
+
 /**
  * @brief execute a state change to given newState
  *
@@ -356,70 +578,137 @@ void stateChange(uint8_t newState)
   // first clear matrix
   ledmatrix.gridFlush();
   // set new state
+  exitAction();
   currentState = newState;
   entryAction(currentState);
+  changeBus.notify(CHANGE_MODE);
   logger.logString("State change to: " + stateNames[currentState]);
   delay(5);
   logger.logString("FreeMemory=" + String(ESP.getFreeHeap()));
 }
 
+/**
+ * @brief Start receiving a picture for /leddirect into ledDirectFrame
+ *
+ * Only one request at a time writes the frame, and only after the main loop drew the previous picture.
+ *
+ * @param request request
+ * @param binary true for raw bytes (3 per pixel), false for base64 (4 bytes per pixel)
+ * @return true if the request may write the frame
+ */
+bool beginLEDDirect(AsyncWebServerRequest *request, bool binary)
+{
+  if (ledDirectReceiver != nullptr || ledDirectPending)
+  {
+    return false;
+  }
+  ledDirectReceiver = request;
+  // release the frame if the request is aborted before the picture is complete
+  request->onDisconnect([request]()
+                        { if (ledDirectReceiver == request) ledDirectReceiver = nullptr; });
+  ledDirectStream.begin(binary ? 3 : 4, !binary);
+  return true;
+}
+
+/**
+ * @brief Decode the body of a POST request to /leddirect (called for each received part of the body)
+ *
+ * The body is decoded straight into ledDirectFrame, it is never stored as a whole.
+ *
+ * @param request request
+ * @param data received part of the body
+ * @param len length of the part
+ * @param index position of the part in the body
+ * @param total length of the body
+ */
+void handleLEDDirectBody(AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total)
+{
+  bool binary = request->contentType() == "application/octet-stream";
+  if (index == 0)
+  {
+    // a binary picture has a fixed size, reject others before reading the body
+    if (binary && total != LEDDIRECT_GRID_PIXELS * 3 && total != LEDDIRECT_FRAME_PIXELS * 3)
+    {
+      return;
+    }
+    beginLEDDirect(request, binary);
+  }
+  if (ledDirectReceiver == request)
+  {
+    ledDirectStream.write(data, len);
+  }
+}
+
 /**
  * @brief Handler for POST requests to /leddirect.
  *
  * Allows the control of all LEDs from external source.
  * It will overwrite the normal program for 5 seconds.
- * A 11x11 picture can be sent as base64 encoded string to be displayed on matrix.
+ * The picture contains the pixels of the grid row by row, optionally followed by the minute indicators.
+ * It is sent either as raw body (Content-Type: application/octet-stream, 3 bytes red, green, blue per pixel)
+ * or base64 encoded (4 bytes per pixel, the 4th is ignored) as body or as the only form parameter.
+ * The picture is decoded here and drawn by the main loop.
  *
+ * @param request request
  */
-void handleLEDDirect()
+void handleLEDDirect(AsyncWebServerRequest *request)
 {
-  if (server.method() != HTTP_POST)
+  unsigned long start = micros();
+  if (request->method() != HTTP_POST)
   {
-    server.send(405, "text/plain", "Method Not Allowed");
+    request->send(405, "text/plain", "Method Not Allowed");
+    handlerLatency.add(micros() - start);
+    return;
+  }
+  if (ledDirectReceiver != request && request->params() == 1 && beginLEDDirect(request, false))
+  {
+    // base64 picture as form parameter
+    const String &data = request->getParam(0)->value();
+    ledDirectStream.write((const uint8_t *)data.c_str(), data.length());
+  }
+
+  if (ledDirectReceiver != request)
+  {
+    // another picture is received or not drawn yet (or the size is wrong), the new one is dropped
+    bool busy = ledDirectReceiver != nullptr || ledDirectPending;
+    request->send(busy ? 503 : 400, "text/plain", busy ? "Service Unavailable" : "Bad Request");
+  }
+  else if (!ledDirectStream.isComplete() || (ledDirectStream.getPixels() != LEDDIRECT_GRID_PIXELS && ledDirectStream.getPixels() != LEDDIRECT_FRAME_PIXELS))
+  {
+    ledDirectReceiver = nullptr;
+    request->send(400, "text/plain", "Bad Request");
   }
   else
   {
-    String message = "POST data was:\n";
-    /*logger.logString(message);
-    delay(10);
-    for (uint8_t i = 0; i < server.args(); i++) {
-      message += " " + server.argName(i) + ": " + server.arg(i) + "\n";
-      logger.logString(server.arg(i));
-      delay(10);
-    }*/
-    if (server.args() == 1)
-    {
-      String data = String(server.arg(0));
-      int dataLength = data.length();
-      // char byteArray[dataLength];
-      // data.toCharArray(byteArray, dataLength);
-
-      // base64 decoding
-      char base64data[dataLength];
-      data.toCharArray(base64data, dataLength);
-      int base64dataLen = dataLength;
-      int decodedLength = Base64.decodedLength(base64data, base64dataLen);
-      char byteArray[decodedLength];
-      Base64.decode(byteArray, base64data, base64dataLen);
-
-      /*for(int i = 0; i < 10; i++){
-        logger.logString(String((int)(byteArray[i])));
-        delay(10);
-      }*/
-
-      for (int i = 0; i < dataLength; i += 4)
-      {
-        uint8_t red = byteArray[i];       // red
-        uint8_t green = byteArray[i + 1]; // green
-        uint8_t blue = byteArray[i + 2];  // blue
-        ledmatrix.gridAddPixel((i / 4) % GRID_WIDTH, (i / 4) / GRID_HEIGHT, LEDMatrix::Color24bit(red, green, blue));
-      }
-      ledmatrix.drawOnMatrixInstant();
+    ledDirectReceiver = nullptr;
+    ledDirectPixels = ledDirectStream.getPixels();
+    ledDirectPending = true;
+    request->send(200, "text/plain", "OK");
+  }
+  handlerLatency.add(micros() - start);
+}
 
-      lastLEDdirect = millis();
-    }
-    server.send(200, "text/plain", message);
+/**
+ * @brief Draw the last picture received via /leddirect, called in the main loop
+ *
+ */
+void drawLEDDirect()
+{
+  if (!ledDirectPending)
+  {
+    return;
+  }
+  for (int i = 0; i < LEDDIRECT_GRID_PIXELS; i++)
+  {
+    ledmatrix.gridAddPixel(i % GRID_WIDTH, i / GRID_WIDTH, ledDirectFrame[i]);
   }
+  for (int i = LEDDIRECT_GRID_PIXELS; i < ledDirectPixels; i++)
+  {
+    ledmatrix.setIndicator(i - LEDDIRECT_GRID_PIXELS, ledDirectFrame[i]);
+  }
+  ledmatrix.drawOnMatrixInstant();
+  lastLEDdirect = millis();
+  ledDirectPending = false;
 }
 
 /**
@@ -470,22 +759,20 @@ void handleButton()
 }
 
 /**
- * @brief Handler for handling commands sent to "/cmd" url
+ * @brief Execute a command sent to "/cmd" url, called in the main loop
  *
+ * @param name name of the parameter
+ * @param value value of the parameter
  */
-void handleCommand()
+void executeCommand(const String &name, const String &value)
 {
-  // receive command and handle accordingly
-  for (uint8_t i = 0; i < server.args(); i++)
-  {
-    Serial.print(server.argName(i));
-    Serial.print(F(": "));
-    Serial.println(server.arg(i));
-  }
+  Serial.print(name);
+  Serial.print(F(": "));
+  Serial.println(value);
 
-  if (server.argName(0) == "led") // the parameter which was sent to this server is led color
+  if (name == "led") // the parameter which was sent to this server is led color
   {
-    String colorstr = server.arg(0) + "-";
+    String colorstr = value + "-";
     String redstr = split(colorstr, '-', 0);
     String greenstr = split(colorstr, '-', 1);
     String bluestr = split(colorstr, '-', 2);
@@ -504,10 +791,11 @@ void handleCommand()
     // Save colors to EEPROM
     writeEEPROM<uint32_t>(ADR_MAINCOLOR_CLOCK, maincolor_clock);
     writeEEPROM<uint32_t>(ADR_SECONDCOLOR_CLOCK, secondcolor_clock);
+    changeBus.notify(CHANGE_COLOR);
   }
-  else if (server.argName(0) == "mode") // the parameter which was sent to this server is mode change
+  else if (name == "mode") // the parameter which was sent to this server is mode change
   {
-    String modestr = server.arg(0);
+    String modestr = value;
     logger.logString("Mode change via Webserver to: " + modestr);
     // set current mode/state accordant sent mode
     if (modestr == "clock")
@@ -534,19 +822,79 @@ void handleCommand()
     {
       stateChange(st_pingpong);
     }
+    else if (modestr == "life")
+    {
+      stateChange(st_life);
+    }
+    else if (modestr == "particles")
+    {
+      stateChange(st_particles);
+    }
+    else if (modestr == "player")
+    {
+      stateChange(st_player);
+    }
+    else if (modestr == "kernel")
+    {
+      stateChange(st_kernel);
+    }
+    else if (modestr == "breakout")
+    {
+      stateChange(st_breakout);
+    }
+  }
+  else if (name == "animation")
+  {
+    String filestr = value;
+    logger.logString("Animation file change via Webserver to: " + filestr);
+    playerFile = filestr.startsWith("/") ? filestr : "/" + filestr;
+    stateChange(st_player);
   }
-  else if (server.argName(0) == "nightmode")
+  else if (name == "kernel")
   {
-    String modestr = server.arg(0);
+    // format: <name> or <name>-<hue>-<scale>-<speed>
+    String kernelstr = value + "-";
+    logger.logString("Kernel change via Webserver to: " + kernelstr);
+    String namestr = split(kernelstr, '-', 0);
+    if (namestr == "gradient")
+    {
+      kernelType = KERNEL_GRADIENT;
+    }
+    else if (namestr == "rainbow")
+    {
+      kernelType = KERNEL_RAINBOWSWEEP;
+    }
+    else if (namestr == "ring")
+    {
+      kernelType = KERNEL_RAINBOWRING;
+    }
+    else if (namestr == "breathing")
+    {
+      kernelType = KERNEL_BREATHING;
+    }
+    if (split(kernelstr, '-', 1).length() > 0)
+    {
+      kernelParams.hue = split(kernelstr, '-', 1).toInt();
+      kernelParams.scale = split(kernelstr, '-', 2).toInt();
+      kernelParams.speed = split(kernelstr, '-', 3).toInt();
+    }
+    if (currentState != st_kernel)
+    {
+      stateChange(st_kernel);
+    }
+  }
+  else if (name == "nightmode")
+  {
+    String modestr = value;
     logger.logString("Nightmode change via Webserver to: " + modestr);
     if (modestr == "1")
       setNightmode(true);
     else
       setNightmode(false);
   }
-  else if (server.argName(0) == "setting")
+  else if (name == "setting")
   {
-    String timestr = server.arg(0) + "-";
+    String timestr = value + "-";
     logger.logString("Nightmode setting change via Webserver to: " + timestr);
     nightModeStartHour = split(timestr, '-', 0).toInt();
     nightModeStartMin = split(timestr, '-', 1).toInt();
@@ -562,127 +910,448 @@ void handleCommand()
     logger.logString("Nightmode ends at: " + String(nightModeEndHour) + ":" + String(nightModeEndMin));
     logger.logString("Brightness: " + String(brightness));
     ledmatrix.setBrightness(brightness);
+    changeBus.notify(CHANGE_NIGHTMODE | CHANGE_BRIGHTNESS);
   }
-  else if (server.argName(0) == "stateautochange")
+  else if (name == "stateautochange")
   {
-    String modestr = server.arg(0);
+    String modestr = value;
     logger.logString("stateAutoChange change via Webserver to: " + modestr);
     if (modestr == "1")
       stateAutoChange = true;
     else
       stateAutoChange = false;
+    changeBus.notify(CHANGE_MODE);
   }
-  else if (server.argName(0) == "tetris")
+  else if (name == "tetris" && mytetris != nullptr)
   {
-    String cmdstr = server.arg(0);
+    String cmdstr = value;
     logger.logString("Tetris cmd via Webserver to: " + cmdstr);
     if (cmdstr == "up")
     {
-      mytetris.ctrlUp();
+      mytetris->ctrlUp();
     }
     else if (cmdstr == "left")
     {
-      mytetris.ctrlLeft();
+      mytetris->ctrlLeft();
     }
     else if (cmdstr == "right")
     {
-      mytetris.ctrlRight();
+      mytetris->ctrlRight();
+    }
+    else if (cmdstr == "leftpress")
+    {
+      mytetris->ctrlPress(INPUT_KEY_LEFT);
+    }
+    else if (cmdstr == "leftrelease")
+    {
+      mytetris->ctrlRelease(INPUT_KEY_LEFT);
+    }
+    else if (cmdstr == "rightpress")
+    {
+      mytetris->ctrlPress(INPUT_KEY_RIGHT);
+    }
+    else if (cmdstr == "rightrelease")
+    {
+      mytetris->ctrlRelease(INPUT_KEY_RIGHT);
     }
     else if (cmdstr == "down")
     {
-      mytetris.ctrlDown();
+      mytetris->ctrlDown();
     }
     else if (cmdstr == "play")
     {
-      mytetris.ctrlStart();
+      mytetris->ctrlStart();
     }
     else if (cmdstr == "pause")
     {
-      mytetris.ctrlPlayPause();
+      mytetris->ctrlPlayPause();
     }
   }
-  else if (server.argName(0) == "snake")
+  else if (name == "snake" && mysnake != nullptr)
   {
-    String cmdstr = server.arg(0);
+    String cmdstr = value;
     logger.logString("Snake cmd via Webserver to: " + cmdstr);
     if (cmdstr == "up")
     {
-      mysnake.ctrlUp();
+      mysnake->ctrlUp();
     }
     else if (cmdstr == "left")
     {
-      mysnake.ctrlLeft();
+      mysnake->ctrlLeft();
     }
     else if (cmdstr == "right")
     {
-      mysnake.ctrlRight();
+      mysnake->ctrlRight();
     }
     else if (cmdstr == "down")
     {
-      mysnake.ctrlDown();
+      mysnake->ctrlDown();
     }
     else if (cmdstr == "new")
     {
-      mysnake.initGame();
+      mysnake->initGame();
     }
   }
-  else if (server.argName(0) == "pong")
+  else if (name == "pong" && mypong != nullptr)
   {
-    String cmdstr = server.arg(0);
+    String cmdstr = value;
     logger.logString("Pong cmd via Webserver to: " + cmdstr);
     if (cmdstr == "up")
     {
-      mypong.ctrlUp(1);
+      mypong->ctrlUp(1);
     }
     else if (cmdstr == "down")
     {
-      mypong.ctrlDown(1);
+      mypong->ctrlDown(1);
+    }
+    else if (cmdstr == "new")
+    {
+      mypong->initGame(1);
+    }
+  }
+  else if (name == "breakout" && mybreakout != nullptr)
+  {
+    String cmdstr = value;
+    logger.logString("Breakout cmd via Webserver to: " + cmdstr);
+    if (cmdstr == "left")
+    {
+      mybreakout->ctrlLeft();
+    }
+    else if (cmdstr == "right")
+    {
+      mybreakout->ctrlRight();
+    }
+    else if (cmdstr == "leftpress")
+    {
+      mybreakout->ctrlPress(INPUT_KEY_LEFT);
+    }
+    else if (cmdstr == "leftrelease")
+    {
+      mybreakout->ctrlRelease(INPUT_KEY_LEFT);
+    }
+    else if (cmdstr == "rightpress")
+    {
+      mybreakout->ctrlPress(INPUT_KEY_RIGHT);
+    }
+    else if (cmdstr == "rightrelease")
+    {
+      mybreakout->ctrlRelease(INPUT_KEY_RIGHT);
     }
     else if (cmdstr == "new")
     {
-      mypong.initGame(1);
+      mybreakout->initGame(false);
     }
   }
-  server.send(204, "text/plain", "No Content"); // this page doesn't send back content --> 204
+  else if (name == "bench")
+  {
+    // headless benchmark of the game logic, e.g. bench=tetris-100, played in loop(), result via /data?key=bench
+    String cmdstr = value + "-";
+    logger.logString("Bench cmd via Webserver to: " + cmdstr);
+    mygamebench.start(split(cmdstr, '-', 0), split(cmdstr, '-', 1).toInt());
+  }
+  else if (name == "replay")
+  {
+    // headless replay of a recorded game (default: last game of a player), played in loop(), result via /data?key=bench
+    String filestr = value;
+    logger.logString("Replay cmd via Webserver to: " + filestr);
+    if (filestr.length() == 0)
+    {
+      filestr = GAMERECORD_FILE;
+    }
+    mygamebench.replay(filestr.startsWith("/") ? filestr : "/" + filestr);
+  }
+  else if (name == "stats")
+  {
+    String cmdstr = value;
+    logger.logString("Stats cmd via Webserver to: " + cmdstr);
+    if (cmdstr == "reset")
+    {
+      mygamestats.reset();
+    }
+  }
+  else if (name == "ddp")
+  {
+    // realtime frames via DDP: ddp=timeout-<ms> (fall back to the normal mode), ddp=reset (statistics via /data?key=ddp)
+    String cmdstr = value + "-";
+    logger.logString("DDP cmd via Webserver to: " + cmdstr);
+    if (split(cmdstr, '-', 0) == "timeout")
+    {
+      myddp.setTimeout(max(split(cmdstr, '-', 1).toInt(), 100L));
+    }
+    else if (split(cmdstr, '-', 0) == "reset")
+    {
+      myddp.resetStats();
+    }
+  }
+}
+
+/**
+ * @brief Get a 24bit color as "r-g-b" (format of the led command)
+ *
+ * @param color 24bit color
+ * @return String color
+ */
+String colorToString(uint32_t color)
+{
+  return String((color >> 16) & 0xFF) + "-" + String((color >> 8) & 0xFF) + "-" + String(color & 0xFF);
+}
+
+/**
+ * @brief Get the mode settings as members of a JSON object (without braces)
+ *
+ * @param changes CHANGE_... flags of the settings to be included (default: all)
+ * @return String JSON members
+ */
+String getModeJSON(uint8_t changes = CHANGE_ALL)
+{
+  String message = "";
+  if (changes & CHANGE_MODE)
+  {
+    message += ",";
+    message += "\"mode\":\"" + stateNames[currentState] + "\"";
+    message += ",";
+    message += "\"modeid\":\"" + String(currentState) + "\"";
+    message += ",";
+    message += "\"stateAutoChange\":\"" + String(stateAutoChange) + "\"";
+  }
+  if (changes & CHANGE_NIGHTMODE)
+  {
+    message += ",";
+    message += "\"nightMode\":\"" + String(nightMode) + "\"";
+    message += ",";
+    message += "\"nightModeStart\":\"" + leadingZero2Digit(nightModeStartHour) + "-" + leadingZero2Digit(nightModeStartMin) + "\"";
+    message += ",";
+    message += "\"nightModeEnd\":\"" + leadingZero2Digit(nightModeEndHour) + "-" + leadingZero2Digit(nightModeEndMin) + "\"";
+  }
+  if (changes & CHANGE_BRIGHTNESS)
+  {
+    message += ",";
+    message += "\"brightness\":\"" + String(brightness) + "\"";
+  }
+  if (changes & CHANGE_COLOR)
+  {
+    message += ",";
+    message += "\"color\":\"" + colorToString(maincolor_clock) + "\"";
+    message += ",";
+    message += "\"secondColor\":\"" + colorToString(secondcolor_clock) + "\"";
+  }
+  return message.substring(1); // without the leading comma
+}
+
+/**
+ * @brief Send the changed settings as JSON delta to the clients of "/events", called in the main loop
+ *
+ * The changes are collected by the change bus only while a client is connected.
+ *
+ */
+void sendEvents()
+{
+  changeBus.setSubscriptions(events.count() > 0 ? CHANGE_ALL : 0);
+  uint8_t changes = changeBus.take();
+  if (eventsStateRequested.exchange(false))
+  {
+    // new client: all settings
+    changes = CHANGE_ALL;
+  }
+  if (changes == 0)
+  {
+    return;
+  }
+  String message = "{" + getModeJSON(changes) + "}";
+  events.send(message.c_str(), "state", millis());
+}
+
+/**
+ * @brief Event handler of the websocket "/ws"
+ *
+ * A text message "name=value" is the same command as "/cmd?name=value" and is
+ * queued for the main loop the same way (single producer: both handlers run in
+ * the task of the TCP stack). The state is sent by the main loop (sendWebSocketState()).
+ *
+ * @param server websocket
+ * @param client client which triggered the event
+ * @param type type of the event
+ * @param arg frame info (WS_EVT_DATA)
+ * @param data payload
+ * @param len length of the payload
+ */
+void handleWebSocketEvent(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len)
+{
+  if (type == WS_EVT_CONNECT)
+  {
+    wsStateRequested = true;
+    return;
+  }
+  if (type != WS_EVT_DATA)
+  {
+    return;
+  }
+  unsigned long start = micros();
+  AwsFrameInfo *info = (AwsFrameInfo *)arg;
+  // commands are short, fragmented or binary messages are ignored
+  if (!info->final || info->index != 0 || info->len != len || info->opcode != WS_TEXT || len > COMMAND_NAME_SIZE + COMMAND_VALUE_SIZE)
+  {
+    return;
+  }
+  char message[COMMAND_NAME_SIZE + COMMAND_VALUE_SIZE + 1];
+  memcpy(message, data, len);
+  message[len] = '\0';
+  char *separator = strchr(message, '=');
+  if (separator == nullptr)
+  {
+    return;
+  }
+  *separator = '\0';
+  commandQueue.push(message, separator + 1, start);
+  handlerLatency.add(micros() - start);
+}
+
+/**
+ * @brief Send the state of the current game to the websocket clients if it changed, called in the main loop
+ *
+ * The settings are pushed by "/events" (sendEvents()).
+ *
+ */
+void sendWebSocketState()
+{
+  if (millis() - lastWebSocketState < PERIOD_WEBSOCKETSTATE)
+  {
+    return;
+  }
+  lastWebSocketState = millis();
+  ws.cleanupClients();
+  if (ws.count() == 0)
+  {
+    wsLastState = "";
+    return;
+  }
+  String message = "{";
+  message += "\"modeid\":\"" + String(currentState) + "\"";
+  Game *game = getCurrentGame();
+  if (game != nullptr)
+  {
+    message += ",";
+    message += "\"gameState\":\"" + String(game->getGameState()) + "\"";
+    message += ",";
+    message += "\"score\":\"" + String(game->getScore()) + "\"";
+    message += ",";
+    message += "\"level\":\"" + String(game->getLevel()) + "\"";
+  }
+  message += "}";
+  bool requested = wsStateRequested.exchange(false);
+  if (requested || message != wsLastState)
+  {
+    ws.textAll(message);
+    wsLastState = message;
+  }
+}
+
+/**
+ * @brief Handler for handling commands sent to "/cmd" url
+ *
+ * The command is queued and executed by the main loop, the request is answered immediately.
+ *
+ * @param request request
+ */
+void handleCommand(AsyncWebServerRequest *request)
+{
+  unsigned long start = micros();
+  if (request->params() == 0)
+  {
+    request->send(400, "text/plain", "Bad Request");
+  }
+  else if (!commandQueue.push(request->getParam(0)->name(), request->getParam(0)->value(), start))
+  {
+    request->send(503, "text/plain", "Service Unavailable");
+  }
+  else
+  {
+    request->send(204, "text/plain", "No Content"); // this page doesn't send back content --> 204
+  }
+  handlerLatency.add(micros() - start);
+}
+
+/**
+ * @brief Execute all queued commands of the webserver, called in the main loop
+ *
+ * @return true if a command was executed
+ */
+bool handleCommands()
+{
+  Command command;
+  bool executed = false;
+  while (commandQueue.pop(command))
+  {
+    executeCommand(command.name, command.value);
+    commandLatency.add(micros() - command.received);
+    executed = true;
+  }
+  return executed;
+}
+
+/**
+ * @brief Build the answers of "/data" from the current state, called in the main loop
+ *
+ * The state is changed by the main loop only, so the JSON is consistent. The
+ * handler runs in the task of the TCP stack and copies the finished answer.
+ *
+ */
+void publishDataSnapshot()
+{
+  String snapshots[NUM_DATA_KEYS];
+  snapshots[0] = "{" + getModeJSON() + "}";
+  snapshots[1] = "{\"bench\":" + mygamebench.getResultJSON() + "}";
+  snapshots[2] = "{\"stats\":" + mygamestats.getJSON() + "}";
+  snapshots[3] = "{\"ddp\":" + myddp.getJSON() + "}";
+  snapshots[4] = "{\"commandLatency\":" + commandLatency.getJSON() + ",\"handlerLatency\":" + handlerLatency.getJSON() +
+                 ",\"commandsDropped\":\"" + String(commandQueue.getDropped()) + "\"}";
+  // the lock is only held to hand over the strings (no copies)
+  std::lock_guard<std::mutex> lock(dataSnapshotMutex);
+  for (uint8_t i = 0; i < NUM_DATA_KEYS; i++)
+  {
+    dataSnapshots[i] = std::move(snapshots[i]);
+  }
+  lastDataSnapshot = millis();
 }
 
 /**
  * @brief Handler for GET requests
  *
+ * @param request request
  */
-void handleDataRequest()
+void handleDataRequest(AsyncWebServerRequest *request)
 {
+  unsigned long start = micros();
   // receive data request and handle accordingly
-  for (uint8_t i = 0; i < server.args(); i++)
+  for (uint8_t i = 0; i < request->params(); i++)
   {
-    Serial.print(server.argName(i));
+    Serial.print(request->getParam(i)->name());
     Serial.print(F(": "));
-    Serial.println(server.arg(i));
+    Serial.println(request->getParam(i)->value());
   }
 
-  if (server.argName(0) == "key") // the parameter which was sent to this server is led color
+  if (request->params() > 0 && request->getParam(0)->name() == "key") // the parameter which was sent to this server is led color
   {
-    String message = "{";
-    String keystr = server.arg(0);
-    if (keystr == "mode")
+    // the state belongs to the main loop, only its last snapshot is sent
+    String message = "{}";
+    String keystr = request->getParam(0)->value();
     {
-      message += "\"mode\":\"" + stateNames[currentState] + "\"";
-      message += ",";
-      message += "\"modeid\":\"" + String(currentState) + "\"";
-      message += ",";
-      message += "\"stateAutoChange\":\"" + String(stateAutoChange) + "\"";
-      message += ",";
-      message += "\"nightMode\":\"" + String(nightMode) + "\"";
-      message += ",";
-      message += "\"nightModeStart\":\"" + leadingZero2Digit(nightModeStartHour) + "-" + leadingZero2Digit(nightModeStartMin) + "\"";
-      message += ",";
-      message += "\"nightModeEnd\":\"" + leadingZero2Digit(nightModeEndHour) + "-" + leadingZero2Digit(nightModeEndMin) + "\"";
-      message += ",";
-      message += "\"brightness\":\"" + String(brightness) + "\"";
+      std::lock_guard<std::mutex> lock(dataSnapshotMutex);
+      for (uint8_t i = 0; i < NUM_DATA_KEYS; i++)
+      {
+        if (keystr == dataKeys[i])
+        {
+          message = dataSnapshots[i];
+        }
+      }
     }
-    message += "}";
-    server.send(200, "application/json", message);
+    request->send(200, "application/json", message);
+  }
+  else
+  {
+    request->send(400, "text/plain", "Bad Request");
   }
+  handlerLatency.add(micros() - start);
 }
 
 // ----------------------------------------------------------------------------------
@@ -701,6 +1370,9 @@ void setup()
   // Init EEPROM
   EEPROM.begin(EEPROM_SIZE);
 
+  // load high scores and statistics of the games from NVS
+  mygamestats.begin();
+
   // configure button pin as input
   pinMode(BUTTONPIN, INPUT_PULLUP);
   pinMode(LED_BUILTIN, OUTPUT);
@@ -813,12 +1485,25 @@ void setup()
 
   server.on("/cmd", handleCommand);                    // process commands
   server.on("/data", handleDataRequest);               // process datarequests
-  server.on("/leddirect", HTTP_POST, handleLEDDirect); // Call the 'handleLEDDirect' function when a POST request is made to URI "/leddirect"
+  server.on("/leddirect", HTTP_POST, handleLEDDirect, nullptr, handleLEDDirectBody); // Call the 'handleLEDDirect' function when a POST request is made to URI "/leddirect"
+  ws.onEvent(handleWebSocketEvent);                    // commands and state of the web UI
+  server.addHandler(&ws);
+  events.onConnect([](AsyncEventSourceClient *client)
+                   { eventsStateRequested = true; }); // changed settings of the web UI
+  server.addHandler(&events);
+  mypongnet.begin(server);                            // WebSocket input channel for pong players
+  publishDataSnapshot();
   server.begin();
 
+  // realtime frames of external controllers (DDP)
+  myddp.begin();
+
   // create UDP Logger to send logging messages via UDP multicast
   logger = UDPLogger(WiFi.localIP(), logMulticastIP, logMulticastPort);
   logger.setName("Wordclock 2.0");
+
+  logger.logString("Mode arena: " + String(modeArena.size()) + " bytes for the state of all modes, " +
+                   String(modeStateSize - modeArena.size()) + " bytes less than separate objects");
   logger.logString("Start program\n");
   delay(10);
   logger.logString("Sketchname: " + String(__FILE__));
@@ -873,12 +1558,8 @@ void setup()
   delay(500);
 
   // init all animation modes
-  // init snake
-  randomsnake(true, 8, colors24bit[1], -1);
   // init spiral
   spiral(true, spiralDir, GRID_WIDTH - 4);
-  // init random tetris
-  randomtetris(true);
 
   // show countdown
   /*for(int i = 9; i > 0; i--){
@@ -939,8 +1620,26 @@ void loop()
   // handle OTA
   handleOTA();
 
-  // handle Webserver
-  server.handleClient();
+  // execute the commands and draw the pictures received by the webserver
+  bool commandsExecuted = handleCommands();
+  drawLEDDirect();
+  myddp.loopCycle();
+  mypongnet.loopCycle();
+  sendWebSocketState();
+  sendEvents();
+
+  // write finished games to NVS and recorded inputs to LittleFS (outside of the game loops)
+  mygamestats.loopCycle();
+  mygamerecorder.loopCycle();
+
+  // play the next slice of a running benchmark
+  mygamebench.loopCycle();
+
+  // answers of "/data": regularly and right after commands changed the state
+  if (commandsExecuted || millis() - lastDataSnapshot > PERIOD_DATASNAPSHOT)
+  {
+    publishDataSnapshot();
+  }
 
   if (AUTO_RESTART_ENABLED && ((millis() > AUTO_RESTART_MILLIS) && (ntp.getHours24() == AUTO_RESTART_HOUR)))
   {
@@ -964,8 +1663,16 @@ void loop()
     }
   }
 
+  // the mode resumes after the timeout of the pictures of /leddirect and DDP, the game draws over the last picture
+  bool pictureShown = (millis() - lastLEDdirect <= TIMEOUT_LEDDIRECT) || myddp.isActive();
+  if (externalPicture && !pictureShown)
+  {
+    redrawCurrentGame();
+  }
+  externalPicture = pictureShown;
+
   // handle mode behaviours (trigger loopCycles of different modes depending on current mode)
-  if (!nightMode && (millis() - lastStep > PERIODS[stateAutoChange][currentState]) && (millis() - lastLEDdirect > TIMEOUT_LEDDIRECT))
+  if (!nightMode && (millis() - lastStep > PERIODS[stateAutoChange][currentState]) && !externalPicture)
   {
     switch (currentState)
     {
@@ -1011,11 +1718,11 @@ void loop()
     {
       if (stateAutoChange)
       {
-        randomtetris(false);
+        mytetrisbot->loopCycle();
       }
-      else
+      if (mytetris->loopCycle())
       {
-        mytetris.loopCycle();
+        ledmatrix.drawOnMatrixInstant();
       }
     }
     break;
@@ -1024,24 +1731,70 @@ void loop()
     {
       if (stateAutoChange)
       {
-        ledmatrix.gridFlush();
-        int res = randomsnake(false, 8, maincolor_snake, -1);
-        if (res)
-        {
-          // init snake for next run
-          randomsnake(true, 8, maincolor_snake, -1);
-        }
-      }
-      else
-      {
-        mysnake.loopCycle();
+        mysnakebot->loopCycle();
       }
+      mysnake->loopCycle();
     }
     break;
     // state pingpong
     case st_pingpong:
     {
-      mypong.loopCycle();
+      // draw every new frame, PERIOD_MATRIXUPDATE would add up to 100ms input latency
+      if (mypong->loopCycle())
+      {
+        ledmatrix.drawOnMatrixInstant();
+        mypong->frameShown();
+      }
+    }
+    break;
+    // state life
+    case st_life:
+    {
+      mylife->loopCycle();
+    }
+    break;
+    // state particles
+    case st_particles:
+    {
+      myparticles->loopCycle();
+      // draw every frame, PERIOD_MATRIXUPDATE is too slow for the particle movement
+      ledmatrix.drawOnMatrixSmooth(filterFactor);
+    }
+    break;
+    // state player
+    case st_player:
+    {
+      myplayer->loopCycle();
+    }
+    break;
+    // state kernel
+    case st_kernel:
+    {
+      switch (kernelType)
+      {
+      case KERNEL_GRADIENT:
+        ledmatrix.gridApplyKernel(GradientKernel(kernelParams, millis()));
+        break;
+      case KERNEL_RAINBOWSWEEP:
+        ledmatrix.gridApplyKernel(RainbowSweepKernel(kernelParams, millis()));
+        break;
+      case KERNEL_RAINBOWRING:
+        ledmatrix.gridApplyKernel(RainbowRingKernel(kernelParams, millis()));
+        break;
+      case KERNEL_BREATHING:
+        ledmatrix.gridApplyKernel(BreathingKernel(kernelParams, millis()));
+        break;
+      }
+      ledmatrix.drawOnMatrixInstant();
+    }
+    break;
+    // state breakout
+    case st_breakout:
+    {
+      if (mybreakout->loopCycle())
+      {
+        ledmatrix.drawOnMatrixInstant();
+      }
     }
     break;
     }
@@ -1060,10 +1813,16 @@ void loop()
   handleButton();
 
   // handle state changes
-  if (stateAutoChange && (millis() - lastStateChange > PERIOD_STATECHANGE) && !nightMode)
+  if (stateAutoChange && (millis() - lastStateChange > PERIOD_STATECHANGE) && !nightMode && !myddp.isActive())
   {
     // increment state variable and trigger state change
-    stateChange((currentState + 1) % NUM_STATES);
+    uint8_t nextState = (currentState + 1) % NUM_STATES;
+    if (nextState == st_player && !LittleFS.exists(playerFile))
+    {
+      // skip player if there is no animation file
+      nextState = (nextState + 1) % NUM_STATES;
+    }
+    stateChange(nextState);
 
     // save last automatic state change
     lastStateChange = millis();
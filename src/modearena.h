@@ -0,0 +1,88 @@
+/**
+ * @file modearena.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Static memory shared by the states of the modes (games, animations), only one of them is alive at a time
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The object of a mode is constructed in the arena (placement new) when the
+ * mode is entered and destroyed when it is left. The arena has the size of
+ * the largest mode (ModeArenaSize<sizeof(A), sizeof(B), ...>::value), which
+ * is checked at compile time for every object created in it.
+ *
+ */
+#ifndef modearena_h
+#define modearena_h
+
+#include <Arduino.h>
+#include <new>
+#include <utility>
+
+#define MODE_ARENA_ALIGN    8
+
+// max. of the given sizes, use as ModeArenaSize<sizeof(A), sizeof(B), ...>::value
+template <size_t First, size_t... Rest>
+struct ModeArenaSize {
+    static const size_t rest = ModeArenaSize<Rest...>::value;
+    static const size_t value = (First > rest) ? First : rest;
+};
+
+template <size_t Last>
+struct ModeArenaSize<Last> {
+    static const size_t value = Last;
+};
+
+template <size_t Size>
+class ModeArena{
+
+    public:
+        ModeArena() {}
+        ~ModeArena() { destroy(); }
+
+        /**
+         * @brief Destroy the current object and construct a new one in the arena
+         *
+         * @param args arguments of the constructor
+         * @return T* pointer to the new object, valid until the next create() or destroy()
+         */
+        template <class T, class... Args>
+        T *create(Args&&... args) {
+            static_assert(sizeof(T) <= Size, "ModeArena: object does not fit into the arena, add it to the size calculation");
+            static_assert(alignof(T) <= MODE_ARENA_ALIGN, "ModeArena: object needs a larger alignment");
+            destroy();
+            T *object = new (_storage) T(std::forward<Args>(args)...);
+            _destructor = &destroyObject<T>;
+            return object;
+        }
+
+        /**
+         * @brief Destroy the current object (if any)
+         *
+         */
+        void destroy() {
+            if (_destructor != nullptr) {
+                _destructor(_storage);
+                _destructor = nullptr;
+            }
+        }
+
+        /**
+         * @brief Get size of the arena
+         *
+         * @return size_t size in bytes
+         */
+        static constexpr size_t size() { return Size; }
+
+    private:
+        template <class T>
+        static void destroyObject(void *object) {
+            static_cast<T *>(object)->~T();
+        }
+
+        alignas(MODE_ARENA_ALIGN) uint8_t _storage[Size];
+        void (*_destructor)(void *) = nullptr;
+};
+
+#endif
@@ -0,0 +1,252 @@
+/**
+ * @file particles.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for the particle animations (rain, fireworks, sparkle)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "particles.h"
+
+// directions of the fireworks burst (cos/sin scaled by 64, steps of 30 deg)
+const int8_t burstDirections[12][2] = {{64, 0}, {55, 32}, {32, 55}, {0, 64}, {-32, 55}, {-55, 32},
+                                       {-64, 0}, {-55, -32}, {-32, -55}, {0, -64}, {32, -55}, {55, -32}};
+
+/**
+ * @brief Construct a new Particles:: Particles object
+ *
+ */
+Particles::Particles(){
+
+}
+
+/**
+ * @brief Construct a new Particles:: Particles object
+ *
+ * @param myledmatrix pointer to LEDMatrix object, need to provide gridBlendPixel(x, y, col, weight), gridFlush()
+ * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
+ */
+Particles::Particles(LEDMatrix *myledmatrix, UDPLogger *mylogger){
+    _ledmatrix = myledmatrix;
+    _logger = mylogger;
+}
+
+/**
+ * @brief Initialize the animation, every call starts the next effect
+ *
+ */
+void Particles::initGame(){
+    startEffect((_effect + 1) % PARTICLE_NUM_EFFECTS);
+}
+
+/**
+ * @brief Run main loop for one cycle (= one tick of the particle simulation)
+ *
+ */
+void Particles::loopCycle(){
+    if (millis() - _effectStart > PARTICLES_EFFECT_DURATION) {
+        startEffect((_effect + 1) % PARTICLE_NUM_EFFECTS);
+    }
+
+    unsigned long start = micros();
+    spawnParticles();
+    updateParticles();
+    printParticles();
+    _updateMicros += micros() - start;
+    _updateCount++;
+    if (_numParticles > _peakParticles) {
+        _peakParticles = _numParticles;
+    }
+}
+
+/**
+ * @brief Clear all particles and start the given effect
+ *
+ * @param effect effect to be started {RAIN, FIREWORKS, SPARKLE}
+ */
+void Particles::startEffect(uint8_t effect){
+    if (_updateCount > 0) {
+        unsigned long avgMicros = _updateMicros / _updateCount;
+        (*_logger).logString("Particles: avg. update " + String(avgMicros) + " us/frame (" +
+                             String(avgMicros * 3 / 1000) + "% at 30 fps), peak " + String(_peakParticles) + " particles");
+    }
+    _updateMicros = 0;
+    _updateCount = 0;
+    _peakParticles = 0;
+
+    _effect = effect;
+    _numParticles = 0;
+    _effectStart = millis();
+    switch (_effect) {
+        case PARTICLE_EFFECT_FIREWORKS:
+            _gravity = 3;
+            break;
+        default:
+            _gravity = 0;
+            break;
+    }
+    (*_logger).logString("Particles: start effect " + String(_effect));
+}
+
+/**
+ * @brief Get a free particle from the pool
+ *
+ * @return Particle* pointer to the new particle, nullptr if the pool is exhausted
+ */
+Particles::Particle *Particles::addParticle(){
+    if (_numParticles >= PARTICLES_MAX) {
+        return nullptr;
+    }
+    Particle *p = &_pool[_numParticles++];
+    p->vx = 0;
+    p->vy = 0;
+    p->type = PARTICLE_TYPE_DEFAULT;
+    return p;
+}
+
+/**
+ * @brief Spawn new particles depending on the current effect
+ *
+ */
+void Particles::spawnParticles(){
+    Particle *p;
+    switch (_effect) {
+        case PARTICLE_EFFECT_RAIN:
+            if (random(3) == 0 && (p = addParticle()) != nullptr) {
+                p->x = random(GRID_WIDTH) * PARTICLES_FP_ONE + random(-64, 64);
+                p->y = -PARTICLES_FP_ONE;
+                p->vy = random(60, 110);
+                p->color = LEDMatrix::Color24bit(30, 70 + random(80), 255);
+                p->life = p->maxLife = 255;
+            }
+            break;
+        case PARTICLE_EFFECT_FIREWORKS:
+        {
+            // only start a new rocket if the sky is (almost) empty
+            bool rocketActive = false;
+            for (uint8_t i = 0; i < _numParticles; i++) {
+                if (_pool[i].type == PARTICLE_TYPE_ROCKET) {
+                    rocketActive = true;
+                }
+            }
+            if (!rocketActive && _numParticles < 8 && random(15) == 0 && (p = addParticle()) != nullptr) {
+                p->x = random(2, GRID_WIDTH - 2) * PARTICLES_FP_ONE;
+                p->y = GRID_HEIGHT * PARTICLES_FP_ONE;
+                p->vx = random(-8, 9);
+                p->vy = -random(95, 120);
+                p->color = LEDMatrix::Color24bit(255, 200, 120);
+                p->life = p->maxLife = 255;
+                p->type = PARTICLE_TYPE_ROCKET;
+            }
+        }
+        break;
+        case PARTICLE_EFFECT_SPARKLE:
+            if (_numParticles < 20 && random(2) == 0 && (p = addParticle()) != nullptr) {
+                p->x = random(GRID_WIDTH) * PARTICLES_FP_ONE;
+                p->y = random(GRID_HEIGHT) * PARTICLES_FP_ONE;
+                p->color = (random(4) == 0) ? LEDMatrix::Color24bit(255, 255, 255) : LEDMatrix::Wheel(random(256));
+                p->life = p->maxLife = random(15, 40);
+                p->type = PARTICLE_TYPE_TWINKLE;
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Move all particles one tick and remove dead particles from the pool
+ *
+ */
+void Particles::updateParticles(){
+    uint8_t i = 0;
+    while (i < _numParticles) {
+        Particle &p = _pool[i];
+        p.vy += _gravity;
+        p.x += p.vx;
+        p.y += p.vy;
+        p.life--;
+
+        bool dead = (p.life == 0)
+                    || (p.y > (GRID_HEIGHT + 1) * PARTICLES_FP_ONE)
+                    || (p.x < -PARTICLES_FP_ONE) || (p.x > GRID_WIDTH * PARTICLES_FP_ONE);
+
+        if (p.type == PARTICLE_TYPE_ROCKET && p.vy >= -8) {
+            // rocket reached its highest point
+            Particle rocket = p;
+            // remove rocket first, so that the pool has space for the burst
+            _pool[i] = _pool[--_numParticles];
+            explodeRocket(rocket);
+            continue;
+        }
+
+        if (dead) {
+            // remove particle by moving the last particle of the pool to its place
+            _pool[i] = _pool[--_numParticles];
+        } else {
+            i++;
+        }
+    }
+}
+
+/**
+ * @brief Create the burst of a fireworks rocket
+ *
+ * @param rocket the exploding rocket
+ */
+void Particles::explodeRocket(const Particle &rocket){
+    uint8_t hue = random(256);
+    int16_t speed = random(36, 56);
+    for (uint8_t d = 0; d < 12; d++) {
+        Particle *p = addParticle();
+        if (p == nullptr) {
+            return;
+        }
+        p->x = rocket.x;
+        p->y = rocket.y;
+        p->vx = burstDirections[d][0] * speed / 64;
+        p->vy = burstDirections[d][1] * speed / 64;
+        p->color = LEDMatrix::Wheel(hue + random(24));
+        p->life = p->maxLife = random(25, 45);
+    }
+}
+
+/**
+ * @brief Draw all particles anti-aliased (bilinear) and additively to the targetgrid
+ *
+ */
+void Particles::printParticles(){
+    (*_ledmatrix).gridFlush();
+    for (uint8_t i = 0; i < _numParticles; i++) {
+        const Particle &p = _pool[i];
+
+        // brightness of particle (0 - 256)
+        uint16_t brightness;
+        if (p.type == PARTICLE_TYPE_TWINKLE) {
+            // fade in and out
+            uint8_t age = p.maxLife - p.life;
+            brightness = (uint16_t)(min(age, p.life) * 512 / p.maxLife);
+        } else if (p.type == PARTICLE_TYPE_DEFAULT && p.maxLife < 255) {
+            // fade out
+            brightness = (uint16_t)p.life * 256 / p.maxLife;
+        } else {
+            brightness = 256;
+        }
+
+        // split position into cell and fraction, the cell center is at the integer position
+        int16_t cellX = p.x >> 8;
+        int16_t cellY = p.y >> 8;
+        uint16_t fracX = p.x & 0xff;
+        uint16_t fracY = p.y & 0xff;
+
+        uint16_t w00 = (256 - fracX) * (256 - fracY) >> 8;
+        uint16_t w10 = fracX * (256 - fracY) >> 8;
+        uint16_t w01 = (256 - fracX) * fracY >> 8;
+        uint16_t w11 = fracX * fracY >> 8;
+
+        (*_ledmatrix).gridBlendPixel(cellX, cellY, p.color, w00 * brightness >> 8);
+        (*_ledmatrix).gridBlendPixel(cellX + 1, cellY, p.color, w10 * brightness >> 8);
+        (*_ledmatrix).gridBlendPixel(cellX, cellY + 1, p.color, w01 * brightness >> 8);
+        (*_ledmatrix).gridBlendPixel(cellX + 1, cellY + 1, p.color, w11 * brightness >> 8);
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @file particles.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for the particle animations (rain, fireworks, sparkle)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * All particles live in a fixed pool (no heap allocation). Positions and
+ * velocities are fixed-point values in 1/256 of a cell, particles are drawn
+ * additively and anti-aliased across the four neighbouring LEDs.
+ *
+ */
+#ifndef particles_h
+#define particles_h
+
+#include <Arduino.h>
+#include "ledmatrix.h"
+#include "udplogger.h"
+#include "config.h"
+
+#define PARTICLES_MAX               64      // capacity of the particle pool
+#define PARTICLES_FP_ONE            256     // fixed-point representation of one cell
+#define PARTICLES_EFFECT_DURATION   15000   // in ms, time after which the next effect is started
+#define PARTICLES_SMOOTHING_FACTOR  0.7     // smoothing factor for the led transition (leaves short trails)
+
+#define PARTICLE_EFFECT_RAIN        0
+#define PARTICLE_EFFECT_FIREWORKS   1
+#define PARTICLE_EFFECT_SPARKLE     2
+#define PARTICLE_NUM_EFFECTS        3
+
+#define PARTICLE_TYPE_DEFAULT       0
+#define PARTICLE_TYPE_ROCKET        1
+#define PARTICLE_TYPE_TWINKLE       2
+
+class Particles{
+
+    friend class ParticlesTest;     // native tests (test/test_particles) inspect the pool
+
+    struct Particle {
+        int16_t x, y;       // position in 1/256 cells
+        int16_t vx, vy;     // velocity in 1/256 cells per tick
+        uint32_t color;
+        uint8_t life;       // remaining lifetime in ticks
+        uint8_t maxLife;
+        uint8_t type;
+    };
+
+    public:
+        Particles();
+        Particles(LEDMatrix *myledmatrix, UDPLogger *mylogger);
+        void initGame();
+        void loopCycle();
+
+    private:
+        void startEffect(uint8_t effect);
+        void spawnParticles();
+        void updateParticles();
+        void explodeRocket(const Particle &rocket);
+        void printParticles();
+        Particle *addParticle();
+
+        LEDMatrix *_ledmatrix;
+        UDPLogger *_logger;
+
+        Particle _pool[PARTICLES_MAX];
+        uint8_t _numParticles = 0;
+        uint8_t _effect = PARTICLE_EFFECT_SPARKLE;
+        int16_t _gravity = 0;
+        unsigned long _effectStart = 0;
+
+        // statistics of update costs, logged on effect change
+        unsigned long _updateMicros = 0;
+        unsigned long _updateCount = 0;
+        uint8_t _peakParticles = 0;
+};
+
+#endif
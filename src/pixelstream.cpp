@@ -0,0 +1,120 @@
+/**
+ * @file pixelstream.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for decoding a stream of pixel bytes (raw or base64) straight into a frame
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "pixelstream.h"
+
+/**
+ * @brief Construct a new PixelStream:: PixelStream object
+ *
+ * @param frame frame the pixels are stored in (24bit colors)
+ * @param size number of pixels of the frame
+ */
+PixelStream::PixelStream(uint32_t *frame, uint16_t size){
+    _frame = frame;
+    _size = size;
+}
+
+/**
+ * @brief Start a new stream
+ *
+ * @param bytesPerPixel number of bytes of a pixel (red, green, blue, further bytes are ignored)
+ * @param base64 true if the data is base64 encoded
+ * @param firstPixel index of the pixel in the frame the data starts with
+ */
+void PixelStream::begin(uint8_t bytesPerPixel, bool base64, uint16_t firstPixel){
+    _bytesPerPixel = constrain(bytesPerPixel, 3, PIXELSTREAM_MAX_BYTES_PER_PIXEL);
+    _base64 = base64;
+    _pixel = firstPixel;
+    _pixels = 0;
+    _numBytes = 0;
+    _bits = 0;
+    _numBits = 0;
+    _padding = false;
+    _error = false;
+}
+
+/**
+ * @brief Decode the next chunk of the data into the frame
+ *
+ * @param data data
+ * @param length length of the data
+ */
+void PixelStream::write(const uint8_t *data, size_t length){
+    for (size_t i = 0; i < length && !_error; i++) {
+        if (!_base64) {
+            addByte(data[i]);
+            continue;
+        }
+        uint8_t c = data[i];
+        uint8_t value;
+        if (c >= 'A' && c <= 'Z') value = c - 'A';
+        else if (c >= 'a' && c <= 'z') value = c - 'a' + 26;
+        else if (c >= '0' && c <= '9') value = c - '0' + 52;
+        else if (c == '+') value = 62;
+        else if (c == '/') value = 63;
+        else if (c == '\r' || c == '\n') continue;
+        else if (c == '=') {
+            _padding = true;
+            continue;
+        }
+        else {
+            _error = true;
+            break;
+        }
+        if (_padding) {
+            // data after the padding
+            _error = true;
+            break;
+        }
+        _bits = (_bits << 6) | value;
+        _numBits += 6;
+        if (_numBits >= 8) {
+            _numBits -= 8;
+            addByte((_bits >> _numBits) & 0xFF);
+        }
+    }
+}
+
+/**
+ * @brief Get the number of pixels stored in the frame
+ *
+ * @return uint16_t number of pixels
+ */
+uint16_t PixelStream::getPixels(){
+    return _pixels;
+}
+
+/**
+ * @brief Check if the data was valid and ended after a complete pixel
+ *
+ * @return true if all data was decoded into complete pixels within the frame
+ */
+bool PixelStream::isComplete(){
+    return !_error && _numBytes == 0;
+}
+
+/**
+ * @brief Add a decoded byte, store the pixel if it is complete
+ *
+ * @param value byte
+ */
+void PixelStream::addByte(uint8_t value){
+    if (_pixel >= _size) {
+        // more data than pixels in the frame
+        _error = true;
+        return;
+    }
+    _bytes[_numBytes++] = value;
+    if (_numBytes == _bytesPerPixel) {
+        _frame[_pixel++] = ((uint32_t)_bytes[0] << 16) | ((uint32_t)_bytes[1] << 8) | _bytes[2];
+        _pixels++;
+        _numBytes = 0;
+    }
+}
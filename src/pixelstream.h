@@ -0,0 +1,49 @@
+/**
+ * @file pixelstream.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for decoding a stream of pixel bytes (raw or base64) straight into a frame
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The data can be written in chunks of any size (e.g. as the body of a
+ * request arrives). A pixel is stored in the frame as soon as its bytes are
+ * complete, so there is no buffer besides the bytes of one pixel: the memory
+ * does not depend on the length of the data, data beyond the frame is an error.
+ *
+ */
+#ifndef pixelstream_h
+#define pixelstream_h
+
+#include <Arduino.h>
+
+#define PIXELSTREAM_MAX_BYTES_PER_PIXEL 4   // red, green, blue, (unused)
+
+class PixelStream{
+
+    public:
+        PixelStream(uint32_t *frame, uint16_t size);
+        void begin(uint8_t bytesPerPixel, bool base64, uint16_t firstPixel = 0);
+        void write(const uint8_t *data, size_t length);
+        uint16_t getPixels();
+        bool isComplete();
+
+    private:
+        void addByte(uint8_t value);
+
+        uint32_t *_frame;
+        uint16_t _size;                 // number of pixels of the frame
+        uint8_t _bytesPerPixel = 3;
+        bool _base64 = false;
+        uint16_t _pixel = 0;            // index of the next pixel in the frame
+        uint16_t _pixels = 0;           // number of pixels stored
+        uint8_t _bytes[PIXELSTREAM_MAX_BYTES_PER_PIXEL];
+        uint8_t _numBytes = 0;          // bytes of the next pixel received so far
+        uint32_t _bits = 0;             // base64: bits not decoded yet
+        uint8_t _numBits = 0;
+        bool _padding = false;          // base64: end of the data ('=') was received
+        bool _error = false;
+};
+
+#endif
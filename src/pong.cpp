@@ -23,69 +23,111 @@ Pong::Pong(){
 /**
  * @brief Construct a new Pong:: Pong object
  * 
- * @param myledmatrix pointer to LEDMatrix object, need to provide gridAddPixel(x, y, col), gridFlush()
+ * @param myledmatrix pointer to LEDMatrix object, the game is rendered to
  * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
  */
-Pong::Pong(LEDMatrix *myledmatrix, UDPLogger *mylogger){
-    _ledmatrix = myledmatrix;
-    _logger = mylogger;
-    _gameState = GAME_STATE_END;
+Pong::Pong(LEDMatrix *myledmatrix, UDPLogger *mylogger) : Game(myledmatrix, mylogger, PONG_TICK_TIME){
+
 }
 
 /**
- * @brief Run main loop for one cycle
- * 
+ * @brief Simulate one tick (PONG_TICK_TIME) of the game
+ *
  */
-void Pong::loopCycle(){
+void Pong::update(){
     switch(_gameState) {
         case GAME_STATE_INIT:
             initGame(2);
             break;
         case GAME_STATE_RUNNING:
-            updateBall();
-            updateGame();
+            tick();
+            invalidate();
             break;
-        case GAME_STATE_END:
+        default:
             break;
     }
 }
 
 /**
- * @brief Trigger control: UP for given player
+ * @brief Trigger control: UP for given player (one paddle step)
  * 
  * @param playerid id of player {0, 1}
  */
 void Pong::ctrlUp(uint8_t playerid){
-    if (millis() > _lastButtonClick + DEBOUNCE_TIME) {
-        _playerMovement[playerid] = PADDLE_MOVE_DOWN; // need to swap direction as field is rotated 180deg
-        _lastButtonClick = millis();
-    }
+    pushInput({millis(), INPUT_KEY_UP, INPUT_ACTION_TAP, playerid});
 }
 
 /**
- * @brief Trigger control: DOWN for given player
+ * @brief Trigger control: DOWN for given player (one paddle step)
  * 
  * @param playerid id of player {0, 1}
  */
 void Pong::ctrlDown(uint8_t playerid){
-    if (millis() > _lastButtonClick + DEBOUNCE_TIME) {
-        _playerMovement[playerid] = PADDLE_MOVE_UP; // need to swap direction as field is rotated 180deg
-        _lastButtonClick = millis();
-    }
+    pushInput({millis(), INPUT_KEY_DOWN, INPUT_ACTION_TAP, playerid});
 }
 
 /**
- * @brief Trigger control: NONE for given player
+ * @brief Trigger control: NONE for given player (cancels pending paddle steps)
  * 
  * @param playerid id of player {0, 1}
  */
 void Pong::ctrlNone(uint8_t playerid){
-    if (millis() > _lastButtonClick + DEBOUNCE_TIME) {
-        _playerMovement[playerid] = PADDLE_MOVE_NONE;
-        _lastButtonClick = millis();
+    pushInput({millis(), INPUT_KEY_NONE, INPUT_ACTION_TAP, playerid});
+}
+
+/**
+ * @brief Queue a timestamped input of given player. The key is held until the next input
+ * and applied at the tick matching the time of the input plus PONG_INPUT_DELAY.
+ * 
+ * @param playerid id of player {0, 1}
+ * @param time time (millis) the input was made
+ * @param key key {UP, DOWN, NONE}
+ */
+void Pong::queueInput(uint8_t playerid, unsigned long time, uint8_t key){
+    pushInput({time, key, INPUT_ACTION_PRESS, playerid});
+}
+
+/**
+ * @brief Queue an input event, it is taken over with the next tick
+ * 
+ * @param event input event
+ */
+void Pong::pushInput(const InputEvent &event){
+    if (event.player < PLAYER_AMOUNT && !_inputs.push(event)) {
+        (*_logger).logString("Pong: input queue full, " + String(_inputs.getDropped()) + " inputs dropped");
     }
 }
 
+/**
+ * @brief Get average time between input and the frame showing the paddle move
+ * 
+ * @param playerid id of player {0, 1}
+ * @return unsigned long latency in ms
+ */
+unsigned long Pong::getAvgInputLatency(uint8_t playerid){
+    return (_latencyCount[playerid] > 0) ? _latencySum[playerid] / _latencyCount[playerid] : 0;
+}
+
+/**
+ * @brief Get maximum time between input and the frame showing the paddle move
+ * 
+ * @param playerid id of player {0, 1}
+ * @return unsigned long latency in ms
+ */
+unsigned long Pong::getMaxInputLatency(uint8_t playerid){
+    return _latencyMax[playerid];
+}
+
+/**
+ * @brief Get number of inputs which arrived too late for their tick
+ * 
+ * @param playerid id of player {0, 1}
+ * @return uint16_t number of late inputs
+ */
+uint16_t Pong::getLateInputs(uint8_t playerid){
+    return _lateInputs[playerid];
+}
+
 /**
  * @brief Initialize a new game
  * 
@@ -94,82 +136,211 @@ void Pong::ctrlNone(uint8_t playerid){
 void Pong::initGame(uint8_t numBots)
 {
     (*_logger).logString("Pong: init with " + String(numBots) + " Bots");
-    resetLEDs();
-    _lastButtonClick = millis();
+    startTime();
+    _inputs.clear();
 
     _numBots = numBots;
 
-    _ball.x = 1;
-    _ball.y = (Y_MAX/2) - (PADDLE_WIDTH/2) + 1;
-    _ball_old.x = _ball.x;
-    _ball_old.y = _ball.y;
-    _ballMovement[0] =  1;
-    _ballMovement[1] = -1;
-    _ballDelay = BALL_DELAY_MAX;
-
-    for(uint8_t i=0; i<PADDLE_WIDTH; i++) {
-        _paddles[PLAYER_1][i].x = 0;
-        _paddles[PLAYER_1][i].y = (Y_MAX/2) - (PADDLE_WIDTH/2) + i;
-        _paddles[PLAYER_2][i].x = X_MAX - 1;
-        _paddles[PLAYER_2][i].y = _paddles[PLAYER_1][i].y;
+    _ballSpeed = BALL_SPEED_START;
+    _ball.x = 1 * PONG_FP_ONE;
+    _ball.y = ((Y_MAX/2) - (PADDLE_WIDTH/2) + 1) * PONG_FP_ONE;
+    _ball.vx = _ballSpeed;
+    _ball.vy = -_ballSpeed;
+
+    for(uint8_t p=0; p<PLAYER_AMOUNT; p++) {
+        _paddles[p] = (Y_MAX/2) - (PADDLE_WIDTH/2);
+        _tapSteps[p] = 0;
+        _botAim[p] = 0;
+        _nextPaddleTick[p] = 0;
+        _scheduledHead[p] = 0;
+        _scheduledCount[p] = 0;
+        _heldMovement[p] = PADDLE_MOVE_NONE;
+        _latencyPending[p] = false;
+        _latencyMoved[p] = false;
+        _latencySum[p] = 0;
+        _latencyMax[p] = 0;
+        _latencyCount[p] = 0;
+        _lateInputs[p] = 0;
     }
 
-    _gameState = GAME_STATE_RUNNING;
+    _paddleHits = 0;
+    setGameState(GAME_STATE_RUNNING);
 }
 
 /**
- * @brief Update ball position
+ * @brief Move ball and paddles for one tick
  * 
  */
-void Pong::updateBall()
+void Pong::tick()
 {
-    bool hitBall = false;
-    if ((millis() - _lastBallUpdate) < _ballDelay) {
-        return;
+    takeInputs();
+    applyInputs();
+    updateBall();
+    if (_gameState == GAME_STATE_RUNNING) {
+        updatePaddles();
     }
-    _lastBallUpdate = millis();
-    toggleLed(_ball.x, _ball.y, LED_TYPE_OFF);
+}
 
-    // collision detection for player 1
-    if (_ballMovement[0] == -1 && _ball.x == 1) {
-        for(uint8_t i=0; i<PADDLE_WIDTH; i++) {
-        if (_paddles[PLAYER_1][i].y == _ball.y) {
-            hitBall = true;
-            break;
+/**
+ * @brief Take over all queued input events: taps are added to the pending paddle steps,
+ * held inputs are scheduled for the tick matching their timestamp
+ * 
+ */
+void Pong::takeInputs()
+{
+    InputEvent event;
+    while (popInput(event)) {
+        if (event.action == INPUT_ACTION_PRESS) {
+            scheduleInput(event);
+        }
+        // need to swap direction as field is rotated 180deg
+        else if (event.key == INPUT_KEY_UP && _tapSteps[event.player] > -Y_MAX) {
+            _tapSteps[event.player]--;
+        }
+        else if (event.key == INPUT_KEY_DOWN && _tapSteps[event.player] < Y_MAX) {
+            _tapSteps[event.player]++;
         }
+        else if (event.key == INPUT_KEY_NONE) {
+            _tapSteps[event.player] = 0;
         }
     }
+}
 
-    // collision detection for player 2
-    if (_ballMovement[0] == 1 && _ball.x == X_MAX-2) {
-        for(uint8_t i=0; i<PADDLE_WIDTH; i++) {
-        if (_paddles[PLAYER_2][i].y == _ball.y) {
-            hitBall = true;
-            break;
+/**
+ * @brief Schedule a held input at the first tick at or after the time of the input plus PONG_INPUT_DELAY
+ * 
+ * @param event input event
+ */
+void Pong::scheduleInput(const InputEvent &event)
+{
+    uint8_t p = event.player;
+    // need to swap direction as field is rotated 180deg
+    uint8_t movement = PADDLE_MOVE_NONE;
+    if (event.key == INPUT_KEY_UP) {
+        movement = PADDLE_MOVE_DOWN;
+    }
+    else if (event.key == INPUT_KEY_DOWN) {
+        movement = PADDLE_MOVE_UP;
+    }
+
+    // current tick is simulated at getTime()
+    long delta = (long)(event.time + PONG_INPUT_DELAY - getTime());
+    uint32_t tick = getTicks();
+    if (delta > 0) {
+        tick += (delta + PONG_TICK_TIME - 1) / PONG_TICK_TIME;
+    }
+    else if (delta <= -PONG_TICK_TIME) {
+        // the matching tick is already over
+        _lateInputs[p]++;
+    }
+
+    uint8_t count = _scheduledCount[p];
+    if (count > 0) {
+        // keep queue in order of ticks, the newest input wins if the queue is full
+        ScheduledInput &last = _scheduled[p][(_scheduledHead[p] + count - 1) % PONG_INPUT_QUEUE_SIZE];
+        if (tick < last.tick) {
+            tick = last.tick;
         }
+        if (count >= PONG_INPUT_QUEUE_SIZE) {
+            last.movement = movement;
+            return;
         }
     }
+    ScheduledInput &input = _scheduled[p][(_scheduledHead[p] + count) % PONG_INPUT_QUEUE_SIZE];
+    input.tick = tick;
+    input.time = event.time;
+    input.movement = movement;
+    _scheduledCount[p]++;
+}
 
-    if (hitBall == true) {
-        _ballMovement[0] *= -1;
-        if (_ballDelay > BALL_DELAY_MIN) {
-        _ballDelay -= BALL_DELAY_STEP;
+/**
+ * @brief Apply all scheduled inputs which are due in the current tick
+ * 
+ */
+void Pong::applyInputs()
+{
+    for(uint8_t p=0; p<PLAYER_AMOUNT; p++) {
+        while (_scheduledCount[p] > 0 && _scheduled[p][_scheduledHead[p]].tick <= getTicks()) {
+            const ScheduledInput &input = _scheduled[p][_scheduledHead[p]];
+            if (input.movement != PADDLE_MOVE_NONE && input.movement != _heldMovement[p]) {
+                // react immediately instead of waiting for the next paddle step
+                _nextPaddleTick[p] = getTicks();
+                _latencyStart[p] = input.time;
+                _latencyPending[p] = true;
+            }
+            _heldMovement[p] = input.movement;
+            _scheduledHead[p] = (_scheduledHead[p] + 1) % PONG_INPUT_QUEUE_SIZE;
+            _scheduledCount[p]--;
         }
     }
+}
 
-    _ball.x += _ballMovement[0];
-    _ball.y += _ballMovement[1];
+/**
+ * @brief Move ball for one tick, reflect it on the walls and paddles
+ * 
+ */
+void Pong::updateBall()
+{
+    FpBall oldBall = _ball;
+    _ball.move();
+
+    // paddles are checked at the plane the ball center reaches when touching the paddle
+    bool hitBall = false;
+    if (_ball.vx < 0) {
+        hitBall = checkPaddleHit(PLAYER_1, 1 * PONG_FP_ONE, oldBall);
+    }
+    else {
+        hitBall = checkPaddleHit(PLAYER_2, (X_MAX - 2) * PONG_FP_ONE, oldBall);
+    }
+
+    // reflect on top and bottom wall
+    fpReflectRange(_ball.y, _ball.vy, 0, (Y_MAX - 1) * PONG_FP_ONE);
 
-    if (_ball.x <=0 || _ball.x >= X_MAX-1) {
+    if (!hitBall && (_ball.x <= 0 || _ball.x >= (X_MAX - 1) * PONG_FP_ONE)) {
+        _ball.x = constrain(_ball.x, 0, (X_MAX - 1) * PONG_FP_ONE);
         endGame();
-        return;
+    }
+}
+
+/**
+ * @brief Check if the ball crossed the paddle plane during the last tick and hit the paddle.
+ * On a hit the ball is reflected, the angle depends on where the paddle was hit.
+ * 
+ * @param playerId id of player {0, 1}
+ * @param planeX x position (1/256 cells) of the ball center when touching the paddle
+ * @param oldBall ball before this tick
+ * @return true if the paddle was hit
+ */
+bool Pong::checkPaddleHit(uint8_t playerId, int16_t planeX, const FpBall &oldBall)
+{
+    if (!fpCrossed(oldBall.x, _ball.x, planeX)) {
+        return false;
+    }
+
+    // y position of the ball at the moment it crossed the plane
+    int16_t crossY = fpCrossingAt(oldBall.x, _ball.x, oldBall.y, _ball.y, planeX);
+    int16_t paddleCenter = (_paddles[playerId] + PADDLE_WIDTH/2) * PONG_FP_ONE;
+    int16_t offset = crossY - paddleCenter;
+    const int16_t halfPaddle = PADDLE_WIDTH * PONG_FP_ONE / 2;
+    if (offset < -halfPaddle || offset > halfPaddle) {
+        return false;
     }
 
-    if (_ball.y <= 0 || _ball.y >= Y_MAX-1) {
-        _ballMovement[1] *= -1;
+    if (_ballSpeed < BALL_SPEED_MAX) {
+        _ballSpeed = min(_ballSpeed + BALL_SPEED_STEP, BALL_SPEED_MAX);
     }
+    fpReflect(_ball.x, _ball.vx, planeX);
+    _ball.vx = (playerId == PLAYER_1) ? _ballSpeed : -_ballSpeed;
 
-    toggleLed(_ball.x, _ball.y, LED_TYPE_BALL);
+    // hit at the edge of the paddle deflects by 45deg, part of the old vertical speed is kept
+    int16_t vy = _ball.vy / 4 + (int32_t)_ballSpeed * offset / halfPaddle;
+    _ball.vy = constrain(vy, -_ballSpeed * 3 / 2, _ballSpeed * 3 / 2);
+
+    // the bot of the other player aims at a new position of its paddle, so the ball will be deflected
+    _botAim[1 - playerId] = random(-PONG_FP_ONE, PONG_FP_ONE + 1);
+    _paddleHits++;
+    setScore(_paddleHits);
+    return true;
 }
 
 /**
@@ -178,48 +349,37 @@ void Pong::updateBall()
  */
 void Pong::endGame()
 {
-    (*_logger).logString("Pong: Game ended");
-    _gameState = GAME_STATE_END;
-    toggleLed(_ball.x, _ball.y, LED_TYPE_BALL_RED);
+    (*_logger).logString("Pong: Game ended after " + String(getTicks() * PONG_TICK_TIME / 1000) + " s, " + String(_paddleHits) + " paddle hits");
+    for(uint8_t p=0; p<PLAYER_AMOUNT; p++) {
+        if (_latencyCount[p] > 0) {
+            (*_logger).logString("Pong: player " + String(p) + " input latency avg " + String(getAvgInputLatency(p)) + " ms, max " +
+                                 String(_latencyMax[p]) + " ms, " + String(_lateInputs[p]) + " late inputs");
+        }
+    }
+    setGameState(GAME_STATE_END);
 }
 
 /**
- * @brief Update paddle position and check for game over
+ * @brief Move paddles one step (every PONG_PADDLE_TICKS)
  * 
  */
-void Pong::updateGame()
+void Pong::updatePaddles()
 {
-    if ((millis() - _lastDrawUpdate) < GAME_DELAY) {
-        return;
-    }
-    _lastDrawUpdate = millis();
-
-    // turn off paddle LEDs
     for(uint8_t p=0; p<PLAYER_AMOUNT; p++) {
-        for(uint8_t i=0; i<PADDLE_WIDTH; i++) {
-        toggleLed(_paddles[p][i].x, _paddles[p][i].y, LED_TYPE_OFF);
+        if (getTicks() < _nextPaddleTick[p]) {
+            continue;
         }
-    }
-
-    // move _paddles
-    for(uint8_t p=0; p<PLAYER_AMOUNT; p++) {
+        _nextPaddleTick[p] = getTicks() + PONG_PADDLE_TICKS;
         uint8_t movement = getPlayerMovement(p);
-        if (movement == PADDLE_MOVE_UP && _paddles[p][PADDLE_WIDTH-1].y < (Y_MAX-1)) {
-        for(uint8_t i=0; i<PADDLE_WIDTH; i++) {
-            _paddles[p][i].y++;
+        uint8_t oldY = _paddles[p];
+        if (movement == PADDLE_MOVE_UP && _paddles[p] + PADDLE_WIDTH - 1 < (Y_MAX-1)) {
+            _paddles[p]++;
         }
+        if (movement == PADDLE_MOVE_DOWN && _paddles[p] > 0) {
+            _paddles[p]--;
         }
-        if (movement == PADDLE_MOVE_DOWN && _paddles[p][0].y > 0) {
-        for(uint8_t i=0; i<PADDLE_WIDTH; i++) {
-            _paddles[p][i].y--;
-        }
-        }
-    }
-
-    // show paddle LEDs
-    for(uint8_t p=0; p<PLAYER_AMOUNT; p++) {
-        for(uint8_t i=0; i<PADDLE_WIDTH; i++) {
-        toggleLed(_paddles[p][i].x, _paddles[p][i].y, LED_TYPE_PADDLE);
+        if (_latencyPending[p] && _paddles[p] != oldY) {
+            _latencyMoved[p] = true;
         }
     }
 }
@@ -234,61 +394,97 @@ uint8_t Pong::getPlayerMovement(uint8_t playerId)
 {
     uint8_t action = PADDLE_MOVE_NONE;
     if(playerId < _numBots){
-        // bot moves paddle
-        int8_t ydir = _ball_old.y - _ball.y;
-        int8_t diff = _paddles[playerId][PADDLE_WIDTH/2].y - _ball.y + ydir * 0.5;
-        // no movement if ball moves away from paddle or no difference between ball and paddle
-        if(diff == 0 || (_ballMovement[0] > 0 && playerId == 0) || (_ballMovement[0] < 0 && playerId == 1)){
-            action = PADDLE_MOVE_NONE;
+        // bot moves paddle, no movement if ball moves away from paddle
+        if((_ball.vx > 0 && playerId == PLAYER_1) || (_ball.vx < 0 && playerId == PLAYER_2)){
+            return PADDLE_MOVE_NONE;
         }
-        else if(diff > 0){
-            action = PADDLE_MOVE_DOWN; 
-        }
-        else{
+        int16_t planeX = (playerId == PLAYER_1) ? 1 * PONG_FP_ONE : (X_MAX - 2) * PONG_FP_ONE;
+        int16_t target = predictBallY(planeX) + _botAim[playerId];
+        int16_t diff = target - (_paddles[playerId] + PADDLE_WIDTH/2) * PONG_FP_ONE;
+        if(diff > PONG_FP_ONE / 2){
             action = PADDLE_MOVE_UP;
         }
+        else if(diff < -PONG_FP_ONE / 2){
+            action = PADDLE_MOVE_DOWN;
+        }
+    }
+    else if(_heldMovement[playerId] != PADDLE_MOVE_NONE){
+        action = _heldMovement[playerId];
+    }
+    else if(_tapSteps[playerId] > 0){
+        action = PADDLE_MOVE_UP;
+        _tapSteps[playerId]--;
     }
-    else{
-        action = _playerMovement[playerId];
-        _playerMovement[playerId] = PADDLE_MOVE_NONE;
+    else if(_tapSteps[playerId] < 0){
+        action = PADDLE_MOVE_DOWN;
+        _tapSteps[playerId]++;
     }
     return action;
 }
 
 /**
- * @brief Clear the led matrix (turn all leds off)
+ * @brief Predict the y position of the ball when it reaches the given x position (including reflections on the walls)
  * 
+ * @param planeX x position in 1/256 cells
+ * @return int16_t y position in 1/256 cells
  */
-void Pong::resetLEDs()
+int16_t Pong::predictBallY(int16_t planeX)
 {
-    (*_ledmatrix).gridFlush();
+    if (_ball.vx == 0) {
+        return _ball.y;
+    }
+    int32_t ticks = (int32_t)(planeX - _ball.x) / _ball.vx;
+    const int32_t maxY = (Y_MAX - 1) * PONG_FP_ONE;
+    // unfold the reflections: position on a line with period 2 * maxY
+    int32_t y = ((_ball.y + (int32_t)_ball.vy * ticks) % (2 * maxY) + 2 * maxY) % (2 * maxY);
+    return (y > maxY) ? 2 * maxY - y : y;
 }
 
 /**
- * @brief Turn on LED on matrix
+ * @brief Get variant of the game for a replay
  * 
- * @param x x position of led
- * @param y y position of led
- * @param type type of pixel {PADDLE, BALL_RED, BALL, OFF}
+ * @return uint8_t number of bots
  */
-void Pong::toggleLed(uint8_t x, uint8_t y, uint8_t type)
+uint8_t Pong::getVariant()
 {
-    uint32_t color;
+    return _numBots;
+}
 
-    switch(type) {
-        case LED_TYPE_PADDLE:
-            color = LEDMatrix::Color24bit(0, 80, 80);
-            break;
-        case LED_TYPE_BALL_RED:
-            color = LEDMatrix::Color24bit(120, 0, 0);
-            break;
-        case LED_TYPE_BALL:
-            color = LEDMatrix::Color24bit(0, 100, 0);
-            break;
-        case LED_TYPE_OFF:
-            color = LEDMatrix::Color24bit(0, 0, 0);
-            break;
+/**
+ * @brief Draw paddles and ball
+ * 
+ * @param framebuffer target of drawing
+ */
+void Pong::render(Framebuffer &framebuffer)
+{
+    framebuffer.gridFlush();
+    if (_gameState == GAME_STATE_READY) {
+        return;
+    }
+    for(uint8_t p=0; p<PLAYER_AMOUNT; p++) {
+        uint8_t x = (p == PLAYER_1) ? 0 : X_MAX - 1;
+        for(uint8_t i=0; i<PADDLE_WIDTH; i++) {
+            framebuffer.gridAddPixel(x, _paddles[p] + i, PONG_COLOR_PADDLE);
+        }
     }
+    framebuffer.drawPoint(_ball.x, _ball.y, _gameState == GAME_STATE_END ? PONG_COLOR_BALL_END : PONG_COLOR_BALL);
+}
 
-    (*_ledmatrix).gridAddPixel(x, y, color);
-}
\ No newline at end of file
+/**
+ * @brief Notify that the last rendered frame is shown on the LEDs, ends the latency
+ * measurement of all paddle moves in this frame
+ * 
+ */
+void Pong::frameShown()
+{
+    for(uint8_t p=0; p<PLAYER_AMOUNT; p++) {
+        if (_latencyMoved[p]) {
+            unsigned long latency = millis() - _latencyStart[p];
+            _latencySum[p] += latency;
+            _latencyCount[p]++;
+            _latencyMax[p] = max(_latencyMax[p], latency);
+            _latencyPending[p] = false;
+            _latencyMoved[p] = false;
+        }
+    }
+}
@@ -9,6 +9,13 @@
  * 
  * main code from https://elektro.turanis.de/html/prj041/index.html 
  * 
+ * The game is simulated with a fixed timestep (PONG_TICK_TIME), independent of
+ * how often loopCycle() is called. Position and velocity of the ball are
+ * fixed-point values in 1/256 of a cell, the ball is drawn anti-aliased.
+ * All inputs go through an InputQueue and are taken over at the tick boundaries.
+ * Held inputs (queueInput()) are applied at the tick matching their timestamp,
+ * the time until the paddle move is shown (frameShown()) is measured per player.
+ * 
  */
 
 #ifndef pong_h
@@ -17,16 +24,21 @@
 #include <Arduino.h>
 #include "ledmatrix.h"
 #include "udplogger.h"
-
-#define DEBOUNCE_TIME 10  // in ms
+#include "inputqueue.h"
+#include "game.h"
+#include "collision2d.h"
 
 #define X_MAX GRID_WIDTH
 #define Y_MAX GRID_HEIGHT
 
-#define GAME_DELAY 80         // in ms
-#define BALL_DELAY_MAX   350  // in ms
-#define BALL_DELAY_MIN    50  // in ms
-#define BALL_DELAY_STEP    5  // in ms
+#define PONG_FP_ONE          COLLISION_FP_ONE  // fixed-point representation of one cell (Q8.8)
+#define PONG_TICK_TIME        10  // in ms, fixed timestep of the simulation
+#define PONG_PADDLE_TICKS      8  // ticks per paddle step (= 80ms)
+#define BALL_SPEED_START       8  // horizontal speed in 1/256 cells per tick (~ 1 cell per 320ms)
+#define BALL_SPEED_MAX        48  // horizontal speed in 1/256 cells per tick (~ 1 cell per 53ms), has to be < 1 cell
+#define BALL_SPEED_STEP        2  // speedup per paddle hit
+#define PONG_INPUT_DELAY      30  // in ms, delay of timestamped inputs (jitter buffer), late inputs are applied with next tick
+#define PONG_INPUT_QUEUE_SIZE  8  // max. number of pending timestamped inputs per player
 
 #define PLAYER_AMOUNT 2
 #define PLAYER_1 0
@@ -38,53 +50,70 @@
 #define PADDLE_MOVE_UP    1
 #define PADDLE_MOVE_DOWN  2
 
-#define LED_TYPE_OFF      1
-#define LED_TYPE_PADDLE   2
-#define LED_TYPE_BALL     3
-#define LED_TYPE_BALL_RED 4
-
-#define GAME_STATE_RUNNING 1
-#define GAME_STATE_END     2
-#define GAME_STATE_INIT    3
+#define PONG_COLOR_PADDLE   0x005050
+#define PONG_COLOR_BALL     0x006400
+#define PONG_COLOR_BALL_END 0x780000
 
-class Pong{
+class Pong : public Game{
 
-    struct Coords {
-        uint8_t x;
-        uint8_t y;
+    struct ScheduledInput {
+        uint32_t tick;          // tick at which the input is applied
+        unsigned long time;     // time (millis) the input was made
+        uint8_t movement;
     };
 
     public:
         Pong();
         Pong(LEDMatrix *myledmatrix, UDPLogger *mylogger);
-        void loopCycle();
         void initGame(uint8_t numBots);
+        void render(Framebuffer &framebuffer) override;
+        void frameShown();
+        uint8_t getVariant() override;
         void ctrlUp(uint8_t playerid);
         void ctrlDown(uint8_t playerid);
         void ctrlNone(uint8_t playerid);
+        void queueInput(uint8_t playerid, unsigned long time, uint8_t key);
+        unsigned long getAvgInputLatency(uint8_t playerid);
+        unsigned long getMaxInputLatency(uint8_t playerid);
+        uint16_t getLateInputs(uint8_t playerid);
     
+    protected:
+        void update() override;
+
     private:
-        LEDMatrix *_ledmatrix;
-        UDPLogger *_logger;
-        uint8_t _gameState;
         uint8_t _numBots;
-        uint8_t _playerMovement[PLAYER_AMOUNT];
-        Coords _paddles[PLAYER_AMOUNT][PADDLE_WIDTH];
-        Coords _ball;
-        Coords _ball_old;
-        int _ballMovement[2];
-        unsigned int _ballDelay;
-        unsigned long _lastDrawUpdate = 0;
-        unsigned long _lastBallUpdate = 0;
-        unsigned long _lastButtonClick = 0;
-        
+        int8_t _tapSteps[PLAYER_AMOUNT];    // pending paddle steps of tapped inputs (> 0: UP, < 0: DOWN)
+        uint8_t _paddles[PLAYER_AMOUNT];    // y position of the lowest paddle pixel
+        FpBall _ball;                       // position and velocity in 1/256 cells (per tick)
+        int16_t _ballSpeed;                 // horizontal speed in 1/256 cells per tick
+        int16_t _botAim[PLAYER_AMOUNT];     // offset of paddle center to the predicted ball position
+        uint16_t _paddleHits = 0;
+        uint32_t _nextPaddleTick[PLAYER_AMOUNT];
+
+        // inputs, timestamped held inputs are scheduled per player, and latency statistics
+        ScheduledInput _scheduled[PLAYER_AMOUNT][PONG_INPUT_QUEUE_SIZE];
+        uint8_t _scheduledHead[PLAYER_AMOUNT];
+        uint8_t _scheduledCount[PLAYER_AMOUNT];
+        uint8_t _heldMovement[PLAYER_AMOUNT];
+        unsigned long _latencyStart[PLAYER_AMOUNT];
+        bool _latencyPending[PLAYER_AMOUNT];
+        bool _latencyMoved[PLAYER_AMOUNT];
+        unsigned long _latencySum[PLAYER_AMOUNT];
+        unsigned long _latencyMax[PLAYER_AMOUNT];
+        uint16_t _latencyCount[PLAYER_AMOUNT];
+        uint16_t _lateInputs[PLAYER_AMOUNT];
 
+        void tick();
+        void pushInput(const InputEvent &event);
+        void takeInputs();
+        void scheduleInput(const InputEvent &event);
+        void applyInputs();
         void updateBall();
+        bool checkPaddleHit(uint8_t playerId, int16_t planeX, const FpBall &oldBall);
         void endGame();
-        void updateGame();
+        void updatePaddles();
         uint8_t getPlayerMovement(uint8_t playerId);
-        void resetLEDs();
-        void toggleLed(uint8_t x, uint8_t y, uint8_t type);
+        int16_t predictBallY(int16_t planeX);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,295 @@
+/**
+ * @file pongnet.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for the WebSocket input channel of the pong game (two players on their phones)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "pongnet.h"
+
+/**
+ * @brief Construct a new PongNet:: PongNet object
+ *
+ * @param mypong pointer to Pong object, need to provide queueInput(), initGame() and the latency getters, can be nullptr
+ * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
+ */
+PongNet::PongNet(Pong *mypong, UDPLogger *mylogger) : _head(0), _tail(0), _dropped(0){
+    _pong = mypong;
+    _logger = mylogger;
+    for (uint8_t p = 0; p < PLAYER_AMOUNT; p++) {
+        _players[p].client = PONGNET_NO_CLIENT;
+        _players[p].synced = false;
+    }
+}
+
+/**
+ * @brief Add the WebSocket to the webserver
+ *
+ * @param server async webserver
+ */
+void PongNet::begin(AsyncWebServer &server){
+    _socket.onEvent([this](AsyncWebSocket *, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len) {
+        onEvent(client, type, arg, data, len);
+    });
+    server.addHandler(&_socket);
+    (*_logger).logString("PongNet: WebSocket on " + String(PONGNET_PATH));
+}
+
+/**
+ * @brief Set the pong game the inputs are passed to
+ *
+ * @param mypong pointer to Pong object, nullptr if there is no game
+ */
+void PongNet::setPong(Pong *mypong){
+    _pong = mypong;
+}
+
+/**
+ * @brief Run main loop for one cycle: handle the queued messages and send clock syncs
+ *
+ */
+void PongNet::loopCycle(){
+    uint8_t head = _head.load(std::memory_order_relaxed);
+    while (head != _tail.load(std::memory_order_acquire)) {
+        Message &message = _messages[head & (PONGNET_QUEUE_SIZE - 1)];
+        if (message.disconnected) {
+            handleDisconnect(message.client, message.received);
+        }
+        else {
+            handleMessage(message.client, message.text, message.received);
+        }
+        _head.store(++head, std::memory_order_release);
+    }
+
+    if (millis() - _lastSync >= PONGNET_SYNC_PERIOD) {
+        _lastSync = millis();
+        _socket.cleanupClients();
+        uint16_t dropped = _dropped;
+        if (dropped != _droppedLogged) {
+            (*_logger).logString("PongNet: " + String(dropped - _droppedLogged) + " messages dropped, queue full");
+            _droppedLogged = dropped;
+        }
+        for (int8_t p = 0; p < PLAYER_AMOUNT; p++) {
+            if (_players[p].client != PONGNET_NO_CLIENT) {
+                String message = "sync-" + String(millis());
+                _socket.text(_players[p].client, message);
+                if (_pong != nullptr) {
+                    sendStatus(p);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Handle WebSocket events (task of the TCP stack), the messages are queued for loopCycle()
+ *
+ * @param client client which triggered the event
+ * @param type type of the event
+ * @param arg frame info (WS_EVT_DATA)
+ * @param data payload
+ * @param len length of the payload
+ */
+void PongNet::onEvent(AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len){
+    if (type == WS_EVT_DISCONNECT) {
+        pushMessage(client->id(), true, nullptr, 0);
+        return;
+    }
+    if (type != WS_EVT_DATA) {
+        return;
+    }
+    AwsFrameInfo *info = (AwsFrameInfo *)arg;
+    // messages are short, fragmented or binary messages are ignored
+    if (!info->final || info->index != 0 || info->len != len || info->opcode != WS_TEXT || len >= PONGNET_MESSAGE_SIZE) {
+        return;
+    }
+    pushMessage(client->id(), false, data, len);
+}
+
+/**
+ * @brief Queue an event of a client (producer side)
+ *
+ * @param client client id
+ * @param disconnected true if the client left
+ * @param text text of the message
+ * @param length length of the text (less than PONGNET_MESSAGE_SIZE)
+ * @return true if the message was queued, false if the queue is full
+ */
+bool PongNet::pushMessage(uint32_t client, bool disconnected, const uint8_t *text, size_t length){
+    uint8_t tail = _tail.load(std::memory_order_relaxed);
+    if ((uint8_t)(tail - _head.load(std::memory_order_acquire)) >= PONGNET_QUEUE_SIZE) {
+        _dropped++;
+        return false;
+    }
+    Message &message = _messages[tail & (PONGNET_QUEUE_SIZE - 1)];
+    message.client = client;
+    message.disconnected = disconnected;
+    message.received = millis();
+    memcpy(message.text, text, length);
+    message.text[length] = '\0';
+    // publish the message after it is written completely
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Free the paddle of a client which left
+ *
+ * @param client client id
+ * @param received time the client left
+ */
+void PongNet::handleDisconnect(uint32_t client, unsigned long received){
+    int8_t player = getPlayer(client);
+    if (player < 0) {
+        return;
+    }
+    (*_logger).logString("PongNet: player " + String(player) + " left");
+    if (_pong != nullptr) {
+        _pong->queueInput(player, received, INPUT_KEY_NONE);
+    }
+    _players[player].client = PONGNET_NO_CLIENT;
+}
+
+/**
+ * @brief Handle a text message of a client
+ *
+ * @param client client id
+ * @param message message (see protocol in pongnet.h)
+ * @param received time the message was received
+ */
+void PongNet::handleMessage(uint32_t client, String message, unsigned long received){
+    int first = message.indexOf('-');
+    int second = (first >= 0) ? message.indexOf('-', first + 1) : -1;
+    String cmd = (first >= 0) ? message.substring(0, first) : message;
+    unsigned long value1 = (first >= 0) ? strtoul(message.substring(first + 1, second).c_str(), NULL, 10) : 0;
+    String field2 = (second >= 0) ? message.substring(second + 1) : "";
+
+    if (cmd == "join") {
+        int8_t player = joinPlayer(client);
+        String answer = (player >= 0) ? "id-" + String(player) : "full";
+        _socket.text(client, answer);
+        return;
+    }
+
+    int8_t player = getPlayer(client);
+    if (player < 0) {
+        return;
+    }
+    if (cmd == "sync" && field2.length() > 0) {
+        handleSync(player, value1, strtoul(field2.c_str(), NULL, 10), received);
+        return;
+    }
+    if (_pong == nullptr) {
+        return;
+    }
+    if (cmd == "in" && field2.length() > 0) {
+        handleInput(player, value1, field2.charAt(0), received);
+    }
+    else if (cmd == "new") {
+        bool twoPlayers = true;
+        for (uint8_t p = 0; p < PLAYER_AMOUNT; p++) {
+            twoPlayers &= (_players[p].client != PONGNET_NO_CLIENT);
+        }
+        // players with id lower than number of bots are played by the bot
+        _pong->initGame(twoPlayers ? 0 : 1);
+    }
+}
+
+/**
+ * @brief Get the player (paddle) of a client
+ *
+ * @param client client id
+ * @return int8_t player id, -1 if the client has no paddle
+ */
+int8_t PongNet::getPlayer(uint32_t client){
+    for (int8_t p = 0; p < PLAYER_AMOUNT; p++) {
+        if (_players[p].client == client) {
+            return p;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Assign a free paddle to a client, player 2 first as it is the human player in a game against the bot
+ *
+ * @param client client id
+ * @return int8_t player id, -1 if both paddles are taken
+ */
+int8_t PongNet::joinPlayer(uint32_t client){
+    int8_t player = getPlayer(client);
+    if (player >= 0) {
+        return player;
+    }
+    for (int8_t p = PLAYER_AMOUNT - 1; p >= 0; p--) {
+        if (_players[p].client == PONGNET_NO_CLIENT) {
+            _players[p].client = client;
+            _players[p].synced = false;
+            _players[p].syncCount = 0;
+            (*_logger).logString("PongNet: client " + String(client) + " joined as player " + String(p));
+            return p;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Update the clock offset of a client from the answer to a sync message.
+ * The sample with the lowest round trip time (within PONGNET_SYNC_WINDOW syncs) is used.
+ *
+ * @param player player id
+ * @param serverTime server time when the sync was sent
+ * @param clientTime client time when the sync was received
+ * @param received server time when the answer was received
+ */
+void PongNet::handleSync(int8_t player, unsigned long serverTime, unsigned long clientTime, unsigned long received){
+    Player &p = _players[player];
+    unsigned long rtt = received - serverTime;
+    if (!p.synced || rtt <= p.rtt || ++p.syncCount >= PONGNET_SYNC_WINDOW) {
+        p.rtt = rtt;
+        p.clockOffset = (long)(clientTime - (serverTime + rtt / 2));
+        p.syncCount = 0;
+        p.synced = true;
+    }
+}
+
+/**
+ * @brief Pass the input of a client to the game, with the input time converted to server time
+ *
+ * @param player player id
+ * @param clientTime client time when the input was made
+ * @param dir direction u (up), d (down), n (none)
+ * @param received server time when the input was received
+ */
+void PongNet::handleInput(int8_t player, unsigned long clientTime, char dir, unsigned long received){
+    unsigned long time = received;
+    if (_players[player].synced) {
+        time = clientTime - _players[player].clockOffset;
+        if ((long)(time - received) > 0) {
+            // offset estimation is off, the input can't be from after its reception
+            time = received;
+        }
+    }
+    uint8_t key = INPUT_KEY_NONE;
+    if (dir == 'u') {
+        key = INPUT_KEY_UP;
+    }
+    else if (dir == 'd') {
+        key = INPUT_KEY_DOWN;
+    }
+    _pong->queueInput(player, time, key);
+}
+
+/**
+ * @brief Send the measured latencies to the client of a player
+ *
+ * @param player player id
+ */
+void PongNet::sendStatus(int8_t player){
+    String message = "lat-" + String(_pong->getAvgInputLatency(player)) + "-" + String(_pong->getMaxInputLatency(player)) + "-" +
+                     String(_players[player].synced ? _players[player].rtt : 0) + "-" + String(_pong->getLateInputs(player));
+    _socket.text(_players[player].client, message);
+}
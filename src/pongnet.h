@@ -0,0 +1,99 @@
+/**
+ * @file pongnet.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for the WebSocket input channel of the pong game (two players on their phones)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Protocol (text messages, fields separated by '-'):
+ *
+ *   client -> server
+ *     join             request a paddle, answered with id-<player> or full
+ *     new              start a new game (two players if both paddles are taken)
+ *     in-<time>-<dir>  paddle input made at client time <time> (ms), dir = u (up), d (down), n (none)
+ *     sync-<s>-<c>     answer to sync, <s> = server time of the sync, <c> = client time when it was received
+ *
+ *   server -> client
+ *     id-<player>                      assigned paddle
+ *     sync-<s>                         clock synchronisation request (every PONGNET_SYNC_PERIOD)
+ *     lat-<avg>-<max>-<rtt>-<late>     measured input-to-frame latency and round trip time in ms
+ *
+ * Without a pong game (setPong(nullptr), pong mode not active) clients can
+ * join, but their inputs are ignored.
+ *
+ * The client clock offset is estimated from the sync answer with the lowest
+ * round trip time, so the input timestamps can be converted to server time.
+ *
+ * The WebSocket runs on the async webserver (path PONGNET_PATH). Its events
+ * arrive in the task of the TCP stack, they are only queued there with the
+ * time they were received (single producer, single consumer like the
+ * CommandQueue) and handled by loopCycle() in the main loop.
+ *
+ */
+#ifndef pongnet_h
+#define pongnet_h
+
+#include <Arduino.h>
+#include <atomic>
+#include <ESPAsyncWebServer.h>
+#include "pong.h"
+#include "udplogger.h"
+
+#define PONGNET_PATH            "/pong"
+#define PONGNET_SYNC_PERIOD     1000    // in ms
+#define PONGNET_SYNC_WINDOW     10      // number of syncs after which the clock offset is renewed
+#define PONGNET_NO_CLIENT       0       // ids of the clients start with 1
+#define PONGNET_QUEUE_SIZE      16      // has to be a power of two
+#define PONGNET_MESSAGE_SIZE    32      // max. length of a message + 1, longer messages are ignored
+
+class PongNet{
+
+    struct Player {
+        uint32_t client;        // WebSocket client id, PONGNET_NO_CLIENT if free
+        bool synced;
+        long clockOffset;       // client time - server time in ms
+        unsigned long rtt;      // round trip time of the sync the offset is taken from
+        uint8_t syncCount;
+    };
+
+    // event of a client, queued by the WebSocket handler
+    struct Message {
+        uint32_t client;
+        bool disconnected;      // client left, no text
+        unsigned long received; // time (millis) the message was received
+        char text[PONGNET_MESSAGE_SIZE];
+    };
+
+    public:
+        PongNet(Pong *mypong, UDPLogger *mylogger);
+        void begin(AsyncWebServer &server);
+        void loopCycle();
+        void setPong(Pong *mypong);
+
+    private:
+        void onEvent(AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len);
+        bool pushMessage(uint32_t client, bool disconnected, const uint8_t *text, size_t length);
+        void handleDisconnect(uint32_t client, unsigned long received);
+        void handleMessage(uint32_t client, String message, unsigned long received);
+        int8_t getPlayer(uint32_t client);
+        int8_t joinPlayer(uint32_t client);
+        void handleSync(int8_t player, unsigned long serverTime, unsigned long clientTime, unsigned long received);
+        void handleInput(int8_t player, unsigned long clientTime, char dir, unsigned long received);
+        void sendStatus(int8_t player);
+
+        AsyncWebSocket _socket = AsyncWebSocket(PONGNET_PATH);
+        Pong *_pong;
+        UDPLogger *_logger;
+        Player _players[PLAYER_AMOUNT];
+        unsigned long _lastSync = 0;
+
+        Message _messages[PONGNET_QUEUE_SIZE];
+        std::atomic<uint8_t> _head;     // written by consumer only
+        std::atomic<uint8_t> _tail;     // written by producer only
+        std::atomic<uint16_t> _dropped;
+        uint16_t _droppedLogged = 0;
+};
+
+#endif
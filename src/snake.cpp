@@ -23,20 +23,18 @@ Snake::Snake(){
 /**
  * @brief Construct a new Snake:: Snake object
  * 
- * @param myledmatrix pointer to LEDMatrix object, need to provide gridAddPixel(x, y, col), gridFlush()
+ * @param myledmatrix pointer to LEDMatrix object, the game is rendered to
  * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
  */
-Snake::Snake(LEDMatrix *myledmatrix, UDPLogger *mylogger){
-    _logger = mylogger;
-    _ledmatrix = myledmatrix;
-    _gameState = GAME_STATE_END;
+Snake::Snake(LEDMatrix *myledmatrix, UDPLogger *mylogger) : Game(myledmatrix, mylogger, GAME_DELAY){
+
 }
 
 /**
- * @brief Run main loop for one cycle
- * 
+ * @brief Simulate one tick (GAME_DELAY) of the game, the snake moves one cell per tick
+ *
  */
-void Snake::loopCycle()
+void Snake::update()
 {
   switch(_gameState)
   {
@@ -46,7 +44,7 @@ void Snake::loopCycle()
     case GAME_STATE_RUNNING:
       updateGame();
       break;
-    case GAME_STATE_END:
+    default:
       break;
   }
 }
@@ -56,11 +54,7 @@ void Snake::loopCycle()
  * 
  */
 void Snake::ctrlUp(){
-    if (millis() > _lastButtonClick + DEBOUNCE_TIME && _gameState == GAME_STATE_RUNNING) {
-        (*_logger).logString("Snake: UP");
-        _userDirection = DIRECTION_DOWN; // need to swap direction as field is rotated 180deg
-        _lastButtonClick = millis();
-    }
+    pushInput(INPUT_KEY_UP);
 }
 
 /**
@@ -68,11 +62,7 @@ void Snake::ctrlUp(){
  * 
  */
 void Snake::ctrlDown(){
-    if (millis() > _lastButtonClick + DEBOUNCE_TIME && _gameState == GAME_STATE_RUNNING) {
-        (*_logger).logString("Snake: DOWN");
-        _userDirection = DIRECTION_UP; // need to swap direction as field is rotated 180deg
-        _lastButtonClick = millis();
-    }
+    pushInput(INPUT_KEY_DOWN);
 }
 
 /**
@@ -80,11 +70,7 @@ void Snake::ctrlDown(){
  * 
  */
 void Snake::ctrlRight(){
-    if (millis() > _lastButtonClick + DEBOUNCE_TIME && _gameState == GAME_STATE_RUNNING) {
-        (*_logger).logString("Snake: RIGHT");
-        _userDirection = DIRECTION_LEFT; // need to swap direction as field is rotated 180deg
-        _lastButtonClick = millis();
-    }
+    pushInput(INPUT_KEY_RIGHT);
 }
 
 /**
@@ -92,20 +78,94 @@ void Snake::ctrlRight(){
  * 
  */
 void Snake::ctrlLeft(){
-    if (millis() > _lastButtonClick + DEBOUNCE_TIME && _gameState == GAME_STATE_RUNNING) {
-        (*_logger).logString("Snake: LEFT");
-        _userDirection = DIRECTION_RIGHT; // need to swap direction as field is rotated 180deg
-        _lastButtonClick = millis();
+    pushInput(INPUT_KEY_LEFT);
+}
+
+/**
+ * @brief Queue an input event, it is applied with one of the next steps of the snake
+ * 
+ * @param key key of the event (INPUT_KEY_...)
+ */
+void Snake::pushInput(uint8_t key){
+    if (!_inputs.push(key)) {
+        (*_logger).logString("Snake: input queue full, " + String(_inputs.getDropped()) + " inputs dropped");
     }
 }
 
 /**
- * @brief Clear the led matrix (turn all leds off)
+ * @brief Apply the next queued input which changes the direction (one turn per step, so fast inputs are not lost)
  * 
  */
-void Snake::resetLEDs()
-{
-    (*_ledmatrix).gridFlush();
+void Snake::applyNextInput(){
+    InputEvent event;
+    while (popInput(event)) {
+        uint8_t direction = DIRECTION_NONE;
+        // need to swap direction as field is rotated 180deg
+        switch (event.key) {
+            case INPUT_KEY_UP:
+                direction = DIRECTION_DOWN;
+                break;
+            case INPUT_KEY_DOWN:
+                direction = DIRECTION_UP;
+                break;
+            case INPUT_KEY_RIGHT:
+                direction = DIRECTION_LEFT;
+                break;
+            case INPUT_KEY_LEFT:
+                direction = DIRECTION_RIGHT;
+                break;
+        }
+        if (direction != DIRECTION_NONE && direction != _userDirection) {
+            _userDirection = direction;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Get current direction of the snake (in field coordinates, see updateGame())
+ * 
+ * @return uint8_t direction (DIRECTION_...)
+ */
+uint8_t Snake::getDirection(){
+    return _userDirection;
+}
+
+/**
+ * @brief Get number of cells occupied by the snake
+ * 
+ * @return uint8_t length
+ */
+uint8_t Snake::getLength(){
+    return _length;
+}
+
+/**
+ * @brief Get number of next steps in which the tail stays in place
+ * 
+ * @return uint8_t pending growth
+ */
+uint8_t Snake::getGrowth(){
+    return _growth;
+}
+
+/**
+ * @brief Get cell index of a body part
+ * 
+ * @param index index of body part (0 = head, getLength() - 1 = tail)
+ * @return uint8_t cell index (y * X_MAX + x)
+ */
+uint8_t Snake::getBodyCell(uint8_t index){
+    return _body[(_headIndex + MAX_TAIL_LENGTH - index) % MAX_TAIL_LENGTH];
+}
+
+/**
+ * @brief Get cell index of the food
+ * 
+ * @return uint8_t cell index (y * X_MAX + x), NO_FOOD if there is no food
+ */
+uint8_t Snake::getFood(){
+    return _food;
 }
 
 /**
@@ -115,170 +175,240 @@ void Snake::resetLEDs()
 void Snake::initGame()
 {
     (*_logger).logString("Snake: init");
-    resetLEDs();
-    _head.x = 0;
-    _head.y = 0;
-    _food.x = -1;
-    _food.y = -1;
-    _wormLength = MIN_TAIL_LENGTH;
+    startTime();
     _userDirection = DIRECTION_LEFT;
-    _lastButtonClick = millis();
+    _inputs.clear();
 
-    for(int i=0; i<MAX_TAIL_LENGTH; i++) {
-        _tail[i].x = -1;
-        _tail[i].y = -1;
-    }
+    memset(_occupied, 0, sizeof(_occupied));
+    _headIndex = 0;
+    _body[_headIndex] = 0;
+    _length = 1;
+    _growth = MIN_TAIL_LENGTH - 1;
+    setOccupied(_body[_headIndex], true);
+    _blood = NO_FOOD;
+    _redraw = true;
+
+    setGameState(GAME_STATE_RUNNING);
     updateFood();
-    _gameState = GAME_STATE_RUNNING;
 }
 
 /**
- * @brief Update game representation
+ * @brief Move the snake by one cell
  * 
  */
 void Snake::updateGame()
 {
-  if ((millis() - _lastDrawUpdate) > GAME_DELAY) {
-    (*_logger).logString("Snake: update game");
-    toggleLed(_tail[_wormLength-1].x, _tail[_wormLength-1].y, LED_TYPE_OFF);
+  {
+    applyNextInput();
+    uint8_t head = _body[_headIndex];
+    int x = head % X_MAX;
+    int y = head / X_MAX;
     switch(_userDirection) {
       case DIRECTION_RIGHT:
-        if (_head.x > 0) {
-          _head.x--;
-        }
+        x--;
         break;
       case DIRECTION_LEFT:
-        if (_head.x < X_MAX-1) {
-          _head.x++;
-        }
+        x++;
         break;
       case DIRECTION_DOWN:
-        if (_head.y > 0) {
-          _head.y--;
-        }
+        y--;
         break;
       case DIRECTION_UP:
-        if (_head.y < Y_MAX-1) {
-          _head.y++;
-        }
+        y++;
         break;
     }
 
-    if (isCollision() == true) {
-      endGame();
+    // collision with border
+    if (x < 0 || x >= X_MAX || y < 0 || y >= Y_MAX) {
+      endGame(head);
       return;
     }
+    uint8_t newHead = y * X_MAX + x;
+    bool eat = (newHead == _food);
 
-    updateTail();
+    // move tail first, the head may follow into the cell which is freed
+    if (eat) {
+      // tail stays in place, snake grows by one
+    } else if (_growth > 0) {
+      _growth--;
+    } else {
+      uint8_t tail = _body[(_headIndex + MAX_TAIL_LENGTH - _length + 1) % MAX_TAIL_LENGTH];
+      setOccupied(tail, false);
+      _length--;
+    }
 
-    if (_head.x == _food.x && _head.y == _food.y) {
-      if (_wormLength < MAX_TAIL_LENGTH) {
-        _wormLength++;
-      }
-      updateFood();
+    // collision with itself
+    if (isOccupied(newHead)) {
+      endGame(newHead);
+      return;
     }
 
-    _lastDrawUpdate = millis();
+    _headIndex = (_headIndex + 1) % MAX_TAIL_LENGTH;
+    _body[_headIndex] = newHead;
+    _length++;
+    _moves++;
+    setOccupied(newHead, true);
+    setScore(_length);
+    invalidate();
+
+    if (eat) {
+      updateFood();
+    }
   }
 }
 
 /**
- * @brief Game over, draw _head red
+ * @brief Game over, draw given cell red
  * 
+ * @param cell cell index of the collision
  */
-void Snake::endGame()
+void Snake::endGame(uint8_t cell)
 {
-  _gameState = GAME_STATE_END;
-  toggleLed(_head.x, _head.y, LED_TYPE_BLOOD);
+  _blood = cell;
+  setGameState(GAME_STATE_END);
 }
 
 /**
- * @brief Update _tail led positions
+ * @brief Place new _food on a uniformly chosen free cell (select the n-th free cell of the occupancy bitset)
  * 
  */
-void Snake::updateTail()
+void Snake::updateFood()
 {
-  for(int i=_wormLength-1; i>0; i--) {
-    _tail[i].x = _tail[i-1].x;
-    _tail[i].y = _tail[i-1].y;
+  uint8_t numFree = MAX_TAIL_LENGTH - _length;
+  if (numFree == 0) {
+    // whole field filled, game won
+    _food = NO_FOOD;
+    setGameState(GAME_STATE_END);
+    return;
   }
-  _tail[0].x = _head.x;
-  _tail[0].y = _head.y;
-
-  for(int i=0; i<_wormLength; i++) {
-    if (_tail[i].x > -1) {
-      toggleLed(_tail[i].x, _tail[i].y, LED_TYPE_SNAKE);
+  uint8_t rank = random(numFree);
+  for (uint8_t w = 0; w < OCCUPANCY_WORDS; w++) {
+    uint32_t freeCells = ~_occupied[w];
+    if (w == OCCUPANCY_WORDS - 1 && MAX_TAIL_LENGTH % 32 != 0) {
+      // mask cells beyond the field
+      freeCells &= (1UL << (MAX_TAIL_LENGTH % 32)) - 1;
+    }
+    uint8_t count = __builtin_popcount(freeCells);
+    if (rank < count) {
+      // clear the lowest free cells until the wanted one is the lowest
+      while (rank > 0) {
+        freeCells &= freeCells - 1;
+        rank--;
+      }
+      _food = w * 32 + __builtin_ctz(freeCells);
+      return;
     }
+    rank -= count;
   }
 }
 
 /**
- * @brief Update _food position (generate new one if found)
+ * @brief Check if a cell is occupied by the snake
  * 
+ * @param cell cell index
+ * @return true if occupied
  */
-void Snake::updateFood()
+bool Snake::isOccupied(uint8_t cell)
 {
-  bool found = true;
-  do {
-    found = true;
-    _food.x = random(0, X_MAX);
-    _food.y = random(0, Y_MAX);
-    for(int i=0; i<_wormLength; i++) {
-      if (_tail[i].x == _food.x && _tail[i].y == _food.y) {
-         found = false;
-      }
-    }
-  } while(found == false);
-  toggleLed(_food.x, _food.y, LED_TYPE_FOOD);
+  return (_occupied[cell / 32] >> (cell % 32)) & 1;
 }
 
 /**
- * @brief Check for collisison between snake and border or itself
+ * @brief Set or clear a cell in the occupancy bitset
  * 
- * @return true 
- * @return false 
+ * @param cell cell index
+ * @param occupied true if the cell is occupied by the snake
  */
-bool Snake::isCollision()
+void Snake::setOccupied(uint8_t cell, bool occupied)
 {
-  if (_head.x < 0 || _head.x >= X_MAX) {
-    return true;
+  if (occupied) {
+    _occupied[cell / 32] |= (1UL << (cell % 32));
+  } else {
+    _occupied[cell / 32] &= ~(1UL << (cell % 32));
   }
-  if (_head.y < 0 || _head.y >= Y_MAX) {
-    return true;
+}
+
+/**
+ * @brief Draw snake, food and the collision at game end. Only the cells which changed since the
+ * last frame are drawn: the new head cells and the cells left by the tail.
+ * 
+ * @param framebuffer target of drawing
+ */
+void Snake::render(Framebuffer &framebuffer)
+{
+  uint16_t moves = _moves - _drawnMoves;
+  if (_redraw || &framebuffer != _drawnFramebuffer || _drawnLength + moves > MAX_TAIL_LENGTH) {
+    // first frame, or the ring entries of the cells left by the tail are overwritten already
+    drawAll(framebuffer);
   }
-  for(int i=1; i<_wormLength; i++) {
-    if (_tail[i].x == _head.x && _tail[i].y == _head.y) {
-       return true;
+  else {
+    // cells left by the tail, unless the head is there again
+    uint8_t tailIndex = (_headIndex + MAX_TAIL_LENGTH - _length + 1) % MAX_TAIL_LENGTH;
+    for (uint8_t i = (_drawnHeadIndex + MAX_TAIL_LENGTH - _drawnLength + 1) % MAX_TAIL_LENGTH; i != tailIndex; i = (i + 1) % MAX_TAIL_LENGTH) {
+      if (!isOccupied(_body[i])) {
+        drawCell(framebuffer, _body[i], 0);
+      }
+    }
+    // new head cells
+    for (uint16_t m = moves; m > 0; m--) {
+      drawCell(framebuffer, _body[(_headIndex + MAX_TAIL_LENGTH - m + 1) % MAX_TAIL_LENGTH], SNAKE_COLOR_BODY);
+    }
+    if (_drawnFood != _food && _drawnFood != NO_FOOD && !isOccupied(_drawnFood)) {
+      drawCell(framebuffer, _drawnFood, 0);
+    }
+    // food may be placed on a cell just left by the tail
+    if (_food != NO_FOOD) {
+      drawCell(framebuffer, _food, SNAKE_COLOR_FOOD);
+    }
+    if (_blood != NO_FOOD) {
+      drawCell(framebuffer, _blood, SNAKE_COLOR_BLOOD);
     }
   }
-  return false;
+  _drawnFramebuffer = &framebuffer;
+  _redraw = false;
+  _drawnMoves = _moves;
+  _drawnHeadIndex = _headIndex;
+  _drawnLength = _length;
+  _drawnFood = _food;
 }
 
 /**
- * @brief Turn on LED on matrix
+ * @brief Request a complete new frame, the target does not contain the last frame anymore
  * 
- * @param x x position of led
- * @param y y position of led
- * @param type type of pixel {SNAKE, OFF, FOOD, BLOOD}
  */
-void Snake::toggleLed(uint8_t x, uint8_t y, uint8_t type)
+void Snake::redraw()
 {
-  uint32_t color;
+  _redraw = true;
+  Game::redraw();
+}
 
-  switch(type) {
-    case LED_TYPE_SNAKE:
-      color = LEDMatrix::Color24bit(0, 100, 100);
-      break;
-    case LED_TYPE_OFF:
-      color = LEDMatrix::Color24bit(0, 0, 0);
-      break;
-    case LED_TYPE_FOOD:
-      color = LEDMatrix::Color24bit(0, 150, 0);
-      break;
-    case LED_TYPE_BLOOD:
-      color = LEDMatrix::Color24bit(150, 0, 0);
-      break;
+/**
+ * @brief Draw the whole field: snake, food and the collision at game end
+ * 
+ * @param framebuffer target of drawing
+ */
+void Snake::drawAll(Framebuffer &framebuffer)
+{
+  framebuffer.gridFlush();
+  for (uint8_t i = 0; i < _length; i++) {
+    drawCell(framebuffer, getBodyCell(i), SNAKE_COLOR_BODY);
   }
+  if (_food != NO_FOOD) {
+    drawCell(framebuffer, _food, SNAKE_COLOR_FOOD);
+  }
+  if (_blood != NO_FOOD) {
+    drawCell(framebuffer, _blood, SNAKE_COLOR_BLOOD);
+  }
+}
 
-  (*_ledmatrix).gridAddPixel(x, y, color);
-}
\ No newline at end of file
+/**
+ * @brief Draw one cell of the field
+ * 
+ * @param framebuffer target of drawing
+ * @param cell cell index (y * X_MAX + x)
+ * @param color color of the cell
+ */
+void Snake::drawCell(Framebuffer &framebuffer, uint8_t cell, uint32_t color)
+{
+  framebuffer.gridAddPixel(cell % X_MAX, cell / X_MAX, color);
+}
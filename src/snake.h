@@ -16,19 +16,18 @@
 #include <Arduino.h>
 #include "ledmatrix.h"
 #include "udplogger.h"
+#include "inputqueue.h"
+#include "game.h"
 #include "config.h"
 
-#define DEBOUNCE_TIME 300   // in ms
-
 #define X_MAX GRID_WIDTH
 #define Y_MAX GRID_HEIGHT
 
 #define GAME_DELAY 400      // in ms
 
-#define LED_TYPE_SNAKE 1
-#define LED_TYPE_OFF   2
-#define LED_TYPE_FOOD  3
-#define LED_TYPE_BLOOD 4
+#define SNAKE_COLOR_BODY  0x006464
+#define SNAKE_COLOR_FOOD  0x009600
+#define SNAKE_COLOR_BLOOD 0x960000
 
 #define DIRECTION_NONE  0
 #define DIRECTION_UP    1
@@ -36,49 +35,64 @@
 #define DIRECTION_LEFT  3
 #define DIRECTION_RIGHT 4
 
-#define GAME_STATE_RUNNING 1
-#define GAME_STATE_END     2
-#define GAME_STATE_INIT    3
-
-#define MAX_TAIL_LENGTH X_MAX * Y_MAX
+#define MAX_TAIL_LENGTH (X_MAX * Y_MAX)
 #define MIN_TAIL_LENGTH 3
+#define NO_FOOD         0xFF
+#define OCCUPANCY_WORDS ((MAX_TAIL_LENGTH + 31) / 32)
 
-class Snake{
+class Snake : public Game{
 
-    struct Coords {
-      int x;
-      int y;
-    };
+    friend class SnakeTest;         // native tests (test/test_snake) compare the incremental frames
 
     public:
         Snake();
         Snake(LEDMatrix *myledmatrix, UDPLogger *mylogger);
-        void loopCycle();
         void initGame();
+        void render(Framebuffer &framebuffer) override;
+        void redraw() override;
         void ctrlUp();
         void ctrlDown();
         void ctrlLeft();
         void ctrlRight();
+
+        uint8_t getDirection();
+        uint8_t getLength();
+        uint8_t getGrowth();
+        uint8_t getBodyCell(uint8_t index);
+        uint8_t getFood();
+        bool isOccupied(uint8_t cell);
         
+    protected:
+        void update() override;
+
     private:
-        LEDMatrix *_ledmatrix;
-        UDPLogger *_logger;
         uint8_t _userDirection;
-        uint8_t _gameState;
-        Coords _head;
-        Coords _tail[MAX_TAIL_LENGTH];
-        Coords _food;
-        unsigned long _lastDrawUpdate = 0;
-        unsigned long _lastButtonClick;
-        unsigned int _wormLength = 0;
+        // body as ring buffer of cell indices (y * X_MAX + x), _body[_headIndex] is the head
+        uint8_t _body[MAX_TAIL_LENGTH];
+        uint8_t _headIndex = 0;
+        uint8_t _length = 0;         // number of cells occupied by the snake
+        uint8_t _growth = 0;         // number of steps the tail stays in place
+        uint32_t _occupied[OCCUPANCY_WORDS]; // bitset of cells occupied by the snake
+        uint8_t _food = NO_FOOD;
+        uint8_t _blood = NO_FOOD;    // cell of the collision at game end
+        uint16_t _moves = 0;         // number of steps of the snake
+
+        // state of the last frame, render() only draws the changes since then
+        Framebuffer *_drawnFramebuffer = nullptr;
+        bool _redraw = true;         // next frame is drawn completely
+        uint16_t _drawnMoves = 0;
+        uint8_t _drawnHeadIndex = 0;
+        uint8_t _drawnLength = 0;
+        uint8_t _drawnFood = NO_FOOD;
 
-        void resetLEDs();
         void updateGame();
-        void endGame();
-        void updateTail();
+        void pushInput(uint8_t key);
+        void applyNextInput();
+        void endGame(uint8_t cell);
         void updateFood();
-        bool isCollision();
-        void toggleLed(uint8_t x, uint8_t y, uint8_t type);
+        void setOccupied(uint8_t cell, bool occupied);
+        void drawCell(Framebuffer &framebuffer, uint8_t cell, uint32_t color);
+        void drawAll(Framebuffer &framebuffer);
 
 };
 
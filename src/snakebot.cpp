@@ -0,0 +1,357 @@
+/**
+ * @file snakebot.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for the snake autopilot (demo mode)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "snakebot.h"
+
+/**
+ * @brief Construct a new SnakeBot:: SnakeBot object
+ *
+ */
+SnakeBot::SnakeBot(){
+    initCycle();
+}
+
+/**
+ * @brief Construct a new SnakeBot:: SnakeBot object
+ *
+ * @param mysnake pointer to Snake object, which is controlled by the bot
+ * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
+ */
+SnakeBot::SnakeBot(Snake *mysnake, UDPLogger *mylogger){
+    _snake = mysnake;
+    _logger = mylogger;
+    initCycle();
+}
+
+/**
+ * @brief Start a new game
+ *
+ */
+void SnakeBot::initGame(){
+    _gameEndTime = 0;
+    _lastHead = SNAKEBOT_NO_CELL;
+    _lastLength = 0;
+    _stepsWithoutFood = 0;
+    _steps = 0;
+    _stepMicros = 0;
+    _maxStepMicros = 0;
+    (*_snake).initGame();
+}
+
+/**
+ * @brief Run main loop for one cycle, decides the next move after every step of the snake
+ *
+ */
+void SnakeBot::loopCycle(){
+    if ((*_snake).getGameState() != GAME_STATE_RUNNING) {
+        // restart game some time after the end
+        if (_gameEndTime == 0) {
+            _gameEndTime = millis();
+            _numGames++;
+            _totalSteps += _steps;
+            (*_logger).logString("SnakeBot: length " + String((*_snake).getLength()) + " after " + String(_steps) +
+                                 " steps (avg. " + String(_totalSteps / _numGames) + " steps/game), avg. " +
+                                 String(_stepMicros / max(_steps, 1UL)) + " us/step, max. " + String(_maxStepMicros) + " us/step");
+        }
+        else if (millis() - _gameEndTime > SNAKEBOT_RESTART_TIME) {
+            initGame();
+        }
+        return;
+    }
+
+    uint8_t head = (*_snake).getBodyCell(0);
+    if (head != _lastHead) {
+        // snake moved, plan next step
+        _lastHead = head;
+        if ((*_snake).getLength() != _lastLength) {
+            _lastLength = (*_snake).getLength();
+            _stepsWithoutFood = 0;
+        } else if (_stepsWithoutFood < SNAKEBOT_MAX_STALL_STEPS) {
+            _stepsWithoutFood++;
+        }
+        unsigned long start = micros();
+        _nextCell = chooseNextCell();
+        unsigned long duration = micros() - start;
+        _stepMicros += duration;
+        if (duration > _maxStepMicros) {
+            _maxStepMicros = duration;
+        }
+        _steps++;
+        // one input per step, the snake applies it with its next move
+        steerTo(_nextCell);
+    }
+}
+
+/**
+ * @brief Build a Hamiltonian cycle over the whole field: serpentine over all rows (columns)
+ * except the first column (row), which is the way back. Needs an even number of rows (columns).
+ *
+ */
+void SnakeBot::initCycle(){
+    for (uint8_t y = 0; y < Y_MAX; y++) {
+        for (uint8_t x = 0; x < X_MAX; x++) {
+            int nx = x, ny = y;
+            if (Y_MAX % 2 == 0) {
+                if (x == 0) {
+                    (y > 0) ? ny-- : nx++;
+                } else if (y % 2 == 0) {
+                    (x < X_MAX - 1) ? nx++ : ny++;
+                } else {
+                    (x > 1 || y == Y_MAX - 1) ? nx-- : ny++;
+                }
+            } else {
+                // transposed version for an even number of columns
+                if (y == 0) {
+                    (x > 0) ? nx-- : ny++;
+                } else if (x % 2 == 0) {
+                    (y < Y_MAX - 1) ? ny++ : nx++;
+                } else {
+                    (y > 1 || x == X_MAX - 1) ? ny-- : nx++;
+                }
+            }
+            _cycleNext[y * X_MAX + x] = ny * X_MAX + nx;
+        }
+    }
+}
+
+/**
+ * @brief Decide on the next cell of the head
+ *
+ * @return uint8_t cell index of next head position
+ */
+uint8_t SnakeBot::chooseNextCell(){
+    loadSnake();
+    uint8_t head = _body[0];
+    uint8_t food = (*_snake).getFood();
+
+    // cells which are blocked for the next step (tail moves on if the snake is not growing)
+    uint32_t blocked[OCCUPANCY_WORDS];
+    memcpy(blocked, _occupied, sizeof(blocked));
+    if (_growth == 0 && _length > 1) {
+        setBlocked(blocked, _body[_length - 1], false);
+    }
+
+    uint8_t neighbours[4];
+    uint8_t numNeighbours = getNeighbours(head, neighbours);
+
+    if (_length < SNAKEBOT_CROWDED_LENGTH && _stepsWithoutFood < SNAKEBOT_MAX_STALL_STEPS) {
+        // shortest path to food, if the tail is still reachable afterwards
+        uint8_t path[MAX_TAIL_LENGTH];
+        if (food != NO_FOOD) {
+            uint8_t pathLength = findPath(head, food, blocked, path);
+            if (pathLength > 0 && isTailReachableAfter(path, pathLength)) {
+                return path[0];
+            }
+        }
+        // stall: take a safe neighbour, prefer the one farthest away from the food
+        uint8_t best = SNAKEBOT_NO_CELL;
+        int bestDistance = -1;
+        for (uint8_t i = 0; i < numNeighbours; i++) {
+            if (isBlocked(blocked, neighbours[i]) || !isTailReachableAfter(&neighbours[i], 1)) {
+                continue;
+            }
+            int distance = abs(neighbours[i] % X_MAX - food % X_MAX) + abs(neighbours[i] / X_MAX - food / X_MAX);
+            if (distance > bestDistance) {
+                bestDistance = distance;
+                best = neighbours[i];
+            }
+        }
+        if (best != SNAKEBOT_NO_CELL) {
+            return best;
+        }
+    }
+
+    // crowded board, stalling too long or no safe move: follow the Hamiltonian cycle
+    uint8_t next = _cycleNext[head];
+    if (!isBlocked(blocked, next)) {
+        return next;
+    }
+    for (uint8_t i = 0; i < numNeighbours; i++) {
+        if (!isBlocked(blocked, neighbours[i]) && isTailReachableAfter(&neighbours[i], 1)) {
+            return neighbours[i];
+        }
+    }
+    for (uint8_t i = 0; i < numNeighbours; i++) {
+        if (!isBlocked(blocked, neighbours[i])) {
+            return neighbours[i];
+        }
+    }
+    return next;
+}
+
+/**
+ * @brief Copy body, occupancy and growth of the snake
+ *
+ */
+void SnakeBot::loadSnake(){
+    _length = (*_snake).getLength();
+    _growth = (*_snake).getGrowth();
+    memset(_occupied, 0, sizeof(_occupied));
+    for (uint8_t i = 0; i < _length; i++) {
+        _body[i] = (*_snake).getBodyCell(i);
+        setBlocked(_occupied, _body[i], true);
+    }
+}
+
+/**
+ * @brief Get all neighbour cells of a cell inside the field
+ *
+ * @param cell cell index
+ * @param neighbours array for up to four neighbour cells
+ * @return uint8_t number of neighbours
+ */
+uint8_t SnakeBot::getNeighbours(uint8_t cell, uint8_t *neighbours){
+    uint8_t x = cell % X_MAX;
+    uint8_t y = cell / X_MAX;
+    uint8_t n = 0;
+    if (x > 0) neighbours[n++] = cell - 1;
+    if (x < X_MAX - 1) neighbours[n++] = cell + 1;
+    if (y > 0) neighbours[n++] = cell - X_MAX;
+    if (y < Y_MAX - 1) neighbours[n++] = cell + X_MAX;
+    return n;
+}
+
+/**
+ * @brief Find the shortest path with a breadth-first search
+ *
+ * @param start start cell (not part of the path)
+ * @param target target cell (may be blocked)
+ * @param blocked bitset of blocked cells
+ * @param path array for the path (first step first, target last)
+ * @return uint8_t length of the path, 0 if there is no path
+ */
+uint8_t SnakeBot::findPath(uint8_t start, uint8_t target, const uint32_t *blocked, uint8_t *path){
+    memset(_parent, SNAKEBOT_NO_CELL, sizeof(_parent));
+    uint8_t head = 0, tail = 0;
+    _queue[tail++] = start;
+    _parent[start] = start;
+    while (head < tail) {
+        uint8_t cell = _queue[head++];
+        uint8_t neighbours[4];
+        uint8_t n = getNeighbours(cell, neighbours);
+        for (uint8_t i = 0; i < n; i++) {
+            uint8_t next = neighbours[i];
+            if (_parent[next] != SNAKEBOT_NO_CELL || (next != target && isBlocked(blocked, next))) {
+                continue;
+            }
+            _parent[next] = cell;
+            if (next == target) {
+                // walk back to start to get the length, then fill path backwards
+                uint8_t length = 0;
+                for (uint8_t c = target; c != start; c = _parent[c]) {
+                    length++;
+                }
+                uint8_t i = length;
+                for (uint8_t c = target; c != start; c = _parent[c]) {
+                    path[--i] = c;
+                }
+                return length;
+            }
+            _queue[tail++] = next;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Simulate the snake moving along a path and check if the tail can be reached afterwards
+ *
+ * @param path cells of the path (first step first)
+ * @param pathLength length of the path
+ * @return true if the tail is reachable from the head at the end of the path
+ */
+bool SnakeBot::isTailReachableAfter(const uint8_t *path, uint8_t pathLength){
+    // virtual snake as ring buffer: tail at _body[tailIndex], length grows when eating
+    uint8_t ring[MAX_TAIL_LENGTH];
+    uint32_t occupied[OCCUPANCY_WORDS];
+    memcpy(occupied, _occupied, sizeof(occupied));
+    for (uint8_t i = 0; i < _length; i++) {
+        ring[i] = _body[_length - 1 - i];
+    }
+    uint8_t tailIndex = 0;
+    uint8_t length = _length;
+    uint8_t growth = _growth;
+    uint8_t food = (*_snake).getFood();
+
+    for (uint8_t i = 0; i < pathLength; i++) {
+        if (path[i] == food || growth > 0) {
+            if (path[i] != food) {
+                growth--;
+            }
+        } else {
+            setBlocked(occupied, ring[tailIndex], false);
+            tailIndex = (tailIndex + 1) % MAX_TAIL_LENGTH;
+            length--;
+        }
+        if (isBlocked(occupied, path[i])) {
+            return false;
+        }
+        ring[(tailIndex + length) % MAX_TAIL_LENGTH] = path[i];
+        length++;
+        setBlocked(occupied, path[i], true);
+    }
+
+    if (length >= MAX_TAIL_LENGTH) {
+        return true;
+    }
+    uint8_t virtualHead = ring[(tailIndex + length - 1) % MAX_TAIL_LENGTH];
+    uint8_t virtualTail = ring[tailIndex];
+    if (virtualHead == virtualTail) {
+        return true;
+    }
+    uint8_t tmpPath[MAX_TAIL_LENGTH];
+    return findPath(virtualHead, virtualTail, occupied, tmpPath) > 0;
+}
+
+/**
+ * @brief Check if a cell is set in a bitset
+ *
+ * @param blocked bitset of cells
+ * @param cell cell index
+ * @return true if set
+ */
+bool SnakeBot::isBlocked(const uint32_t *blocked, uint8_t cell){
+    return (blocked[cell / 32] >> (cell % 32)) & 1;
+}
+
+/**
+ * @brief Set or clear a cell in a bitset
+ *
+ * @param blocked bitset of cells
+ * @param cell cell index
+ * @param value true to set the cell
+ */
+void SnakeBot::setBlocked(uint32_t *blocked, uint8_t cell, bool value){
+    if (value) {
+        blocked[cell / 32] |= (1UL << (cell % 32));
+    } else {
+        blocked[cell / 32] &= ~(1UL << (cell % 32));
+    }
+}
+
+/**
+ * @brief Turn the snake towards a neighbour cell of the head with the ctrl* API
+ * (the controls are mirrored, see Snake::ctrlUp()), nothing is queued if the direction does not change
+ *
+ * @param cell target cell
+ */
+void SnakeBot::steerTo(uint8_t cell){
+    uint8_t head = (*_snake).getBodyCell(0);
+    uint8_t direction = (*_snake).getDirection();
+    if (cell == head + 1 && direction != DIRECTION_LEFT) {
+        (*_snake).ctrlRight();
+    } else if (cell + 1 == head && direction != DIRECTION_RIGHT) {
+        (*_snake).ctrlLeft();
+    } else if (cell == head + X_MAX && direction != DIRECTION_UP) {
+        (*_snake).ctrlDown();
+    } else if (cell + X_MAX == head && direction != DIRECTION_DOWN) {
+        (*_snake).ctrlUp();
+    }
+}
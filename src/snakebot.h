@@ -0,0 +1,81 @@
+/**
+ * @file snakebot.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for the snake autopilot (demo mode)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The bot searches the shortest path to the food (BFS) and only takes it, if the
+ * tail is still reachable after eating (simulated on a copy of the snake). Otherwise
+ * it stalls on a safe cell. When the board gets crowded (or stalling takes too long)
+ * it follows a Hamiltonian cycle over the whole field. All searches are bounded by the 110 cells of the grid.
+ *
+ */
+#ifndef snakebot_h
+#define snakebot_h
+
+#include <Arduino.h>
+#include "snake.h"
+#include "udplogger.h"
+#include "config.h"
+
+#define SNAKEBOT_RESTART_TIME       3000                        // time in ms after game end until a new game is started
+#define SNAKEBOT_CROWDED_LENGTH     (MAX_TAIL_LENGTH * 6 / 10)  // length from which the Hamiltonian cycle is followed
+#define SNAKEBOT_MAX_STALL_STEPS    (MAX_TAIL_LENGTH * 2)      // steps without food after which the Hamiltonian cycle is followed
+#define SNAKEBOT_NO_CELL            0xFF
+
+class SnakeBot{
+
+    friend class SnakeBotTest;      // native tests (test/test_snakebot) run the searches on crafted boards
+
+    public:
+        SnakeBot();
+        SnakeBot(Snake *mysnake, UDPLogger *mylogger);
+
+        void initGame();
+        void loopCycle();
+
+    private:
+        void initCycle();
+        uint8_t chooseNextCell();
+        void loadSnake();
+        uint8_t getNeighbours(uint8_t cell, uint8_t *neighbours);
+        uint8_t findPath(uint8_t start, uint8_t target, const uint32_t *blocked, uint8_t *path);
+        bool isTailReachableAfter(const uint8_t *path, uint8_t pathLength);
+        bool isBlocked(const uint32_t *blocked, uint8_t cell);
+        void setBlocked(uint32_t *blocked, uint8_t cell, bool value);
+        void steerTo(uint8_t cell);
+
+        Snake *_snake;
+        UDPLogger *_logger;
+
+        // Hamiltonian cycle over the whole field, next cell for every cell
+        uint8_t _cycleNext[MAX_TAIL_LENGTH];
+
+        // copy of the snake (0 = head), occupied cells and pending growth
+        uint8_t _body[MAX_TAIL_LENGTH];
+        uint8_t _length = 0;
+        uint8_t _growth = 0;
+        uint32_t _occupied[OCCUPANCY_WORDS];
+
+        // BFS working memory
+        uint8_t _queue[MAX_TAIL_LENGTH];
+        uint8_t _parent[MAX_TAIL_LENGTH];
+
+        uint8_t _lastHead = SNAKEBOT_NO_CELL;
+        uint8_t _nextCell = SNAKEBOT_NO_CELL;
+        uint8_t _lastLength = 0;
+        uint16_t _stepsWithoutFood = 0;
+        unsigned long _gameEndTime = 0;
+
+        // statistics
+        unsigned long _steps = 0;
+        unsigned long _stepMicros = 0;
+        unsigned long _maxStepMicros = 0;
+        unsigned long _numGames = 0;
+        unsigned long _totalSteps = 0;
+};
+
+#endif
@@ -12,82 +12,177 @@
  */
 #include "tetris.h"
 
+// Shapes of the bricks in spawn orientation as row masks (bit x is column x of the brick)
+constexpr uint8_t brickShapes[7][MAX_BRICK_SIZE] = {
+    {0x0, 0x6, 0x6, 0x0},   // .... .##. .##. ....  (O)
+    {0x0, 0xF, 0x0, 0x0},   // .... #### .... ....  (I)
+    {0x2, 0x2, 0x6, 0x0},   // .#.. .#.. .##. ....  (L)
+    {0x2, 0x2, 0x3, 0x0},   // .#.. .#.. ##.. ....  (J)
+    {0x2, 0x6, 0x2, 0x0},   // .#.. .##. .#.. ....  (T)
+    {0x2, 0x3, 0x1, 0x0},   // .#.. ##.. #... ....  (Z)
+    {0x1, 0x3, 0x2, 0x0}    // #... ##.. .#.. ....  (S)
+};
+constexpr uint8_t brickSizes[7] = {4, 4, 3, 3, 3, 3, 3};
+
+/**
+ * @brief Pixel of a brick in the given rotation (clockwise around the center of the 3x3 or 4x4 brick)
+ * 
+ * @param b brick index
+ * @param r rotation (0-3)
+ * @param x column in brick
+ * @param y row in brick
+ * @return constexpr uint8_t 1 if pixel is set
+ */
+constexpr uint8_t brickPixel(int b, int r, int x, int y) {
+    return (x >= brickSizes[b] || y >= brickSizes[b]) ? 0
+           : (r == 0) ? ((brickShapes[b][y] >> x) & 1)
+           : brickPixel(b, r - 1, y, brickSizes[b] - 1 - x);
+}
+
+/**
+ * @brief Row mask of a brick in the given rotation
+ * 
+ * @param b brick index
+ * @param r rotation (0-3)
+ * @param y row in brick
+ * @return constexpr uint8_t row mask (bit x is column x of the brick)
+ */
+constexpr uint8_t brickRowMask(int b, int r, int y) {
+    return brickPixel(b, r, 0, y) | (brickPixel(b, r, 1, y) << 1) | (brickPixel(b, r, 2, y) << 2) | (brickPixel(b, r, 3, y) << 3);
+}
+
+#define BRICK_ROTATION(b, r) {brickRowMask(b, r, 0), brickRowMask(b, r, 1), brickRowMask(b, r, 2), brickRowMask(b, r, 3)}
+#define BRICK_ROTATIONS(b) {BRICK_ROTATION(b, 0), BRICK_ROTATION(b, 1), BRICK_ROTATION(b, 2), BRICK_ROTATION(b, 3)}
+
+// Row masks of all bricks in all four rotations [brick][rotation][row], calculated at compile time
+constexpr uint8_t brickRotations[7][4][MAX_BRICK_SIZE] = {BRICK_ROTATIONS(0), BRICK_ROTATIONS(1), BRICK_ROTATIONS(2), BRICK_ROTATIONS(3),
+                                                          BRICK_ROTATIONS(4), BRICK_ROTATIONS(5), BRICK_ROTATIONS(6)};
+
+static_assert(brickRotations[1][1][0] == 0x4 && brickRotations[1][1][3] == 0x4, "vertical I brick expected in column 2");
+
+// yoffset when adding brick to field, size, color
+const Tetris::AbstractBrick Tetris::_brickLib[7] = {
+    {1, 4, WHITE},
+    {0, 4, GREEN},
+    {1, 3, BLUE},
+    {1, 3, YELLOW},
+    {1, 3, AQUA},
+    {1, 3, HOTPINK},
+    {1, 3, RED}
+};
+
+// SRS wall kicks for clockwise rotation [3x3 bricks / I brick][from rotation][test][dx, dy],
+// y is pointing down (inverted compared to the SRS tables)
+const int8_t wallKicks[2][4][5][2] = {
+    {
+        {{0, 0}, {-1, 0}, {-1, -1}, {0, 2}, {-1, 2}},
+        {{0, 0}, {1, 0}, {1, 1}, {0, -2}, {1, -2}},
+        {{0, 0}, {1, 0}, {1, -1}, {0, 2}, {1, 2}},
+        {{0, 0}, {-1, 0}, {-1, 1}, {0, -2}, {-1, -2}}
+    },
+    {
+        {{0, 0}, {-2, 0}, {1, 0}, {-2, 1}, {1, -2}},
+        {{0, 0}, {-1, 0}, {2, 0}, {-1, -2}, {2, 1}},
+        {{0, 0}, {2, 0}, {-1, 0}, {2, -1}, {-1, 2}},
+        {{0, 0}, {1, 0}, {-2, 0}, {1, 2}, {-2, -1}}
+    }
+};
+
 Tetris::Tetris(){
 }
 
 /**
  * @brief Construct a new Tetris:: Tetris object
  * 
- * @param myledmatrix pointer to LEDMatrix object, need to provide gridAddPixel(x, y, col), drawOnMatrix(), gridFlush() and printNumber(x,y,n,col)
+ * @param myledmatrix pointer to LEDMatrix object, the game is rendered to
  * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
  */
-Tetris::Tetris(LEDMatrix *myledmatrix, UDPLogger *mylogger){
-    _logger = mylogger;
-    _ledmatrix = myledmatrix;
-    _gameStatet = GAME_STATE_READYt;
+Tetris::Tetris(LEDMatrix *myledmatrix, UDPLogger *mylogger) : Game(myledmatrix, mylogger, TETRIS_TICK_TIME){
+
 }
 
 /**
- * @brief Run main loop for one cycle
- * 
+ * @brief Simulate one tick (TETRIS_TICK_TIME) of the game
+ *
  */
-void Tetris::loopCycle(){
-    switch (_gameStatet) {
-        case GAME_STATE_READYt:
+void Tetris::update(){
+    unsigned long start = micros();
+    // inputs are kept in the queue during the line clear animation and applied to the next brick
+    if (!_clearing) {
+        processInputs();
+    }
+    switch (_gameState) {
+        case GAME_STATE_READY:
 
             break;
-        case GAME_STATE_INITt:
+        case GAME_STATE_INIT:
             tetrisInit();
 
             break;
-        case GAME_STATE_RUNNINGt:
+        case GAME_STATE_RUNNING:
+            if (_clearing) {
+                // animate removal of full lines, one step per CLEAR_STEP_TIME
+                if (getTime() - _clearingStepTime >= CLEAR_STEP_TIME) {
+                    _clearingStepTime = getTime();
+                    clearLinesStep();
+                }
+            }
             //If brick is still "on the loose", then move it down by one
-            if (_activeBrick.enabled) {
+            else if (_activeBrick.enabled) {
                 // move faster down when allow drop
                 if (_allowdrop) {
-                    if (millis() > _droptime + 50) {
-                        _droptime = millis();
+                    if (getTime() > _droptime + 50) {
+                        _droptime = getTime();
                         shiftActiveBrick(DIR_DOWN);
-                        printField();
+                        invalidate();
                     }
                 }
 
                 // move down with regular speed
-                if ((millis() - _prevUpdateTime) > (_brickSpeed * _speedtetris / 100)) {
-                        _prevUpdateTime = millis();
+                if ((getTime() - _prevUpdateTime) > (_brickSpeed * _speedtetris / 100)) {
+                        _prevUpdateTime = getTime();
                         shiftActiveBrick(DIR_DOWN);
-                        printField();
+                        invalidate();
                 }
             }
             else {
                 _allowdrop = false;
                 //Active brick has "crashed", check for full lines
                 //and create new brick at top of field
-                checkFullLines();
-                newActiveBrick();
-                _prevUpdateTime = millis();//Reset update time to avoid brick dropping two spaces
+                if (checkFullLines()) {
+                    // new brick is created after the line clear animation
+                    _clearingColumn = 0;
+                    _clearingStepTime = getTime();
+                    _clearing = true;
+                }
+                else {
+                    newActiveBrick();
+                    _prevUpdateTime = getTime();//Reset update time to avoid brick dropping two spaces
+                }
             }
             break;
-        case GAME_STATE_PAUSEDt:
+        case GAME_STATE_PAUSED:
 
             break;
-        case GAME_STATE_ENDt:
+        case GAME_STATE_END:
             // at game end show all bricks on field in red color for 1.5 seconds, then show score
             if (_tetrisGameOver == true) {
                 _tetrisGameOver = false;
-                (*_logger).logString("Tetris: end");
-                everythingRed();
-                _tetrisshowscore = millis();
+                _heldKey = INPUT_KEY_NONE;
+                (*_logger).logString("Tetris: end, longest update " + String(_maxLoopMicros) + " us");
+                _tetrisshowscore = getTime();
             }
 
-            if (millis() > (_tetrisshowscore + RED_END_TIME)) {
-                resetLEDs();
-                _score = _nbRowsTotal;
-                showscore();
-                _gameStatet = GAME_STATE_READYt;
+            if (getTime() > (_tetrisshowscore + RED_END_TIME)) {
+                _showScore = true;
+                setGameState(GAME_STATE_READY);
             }
             break;
     }
+    unsigned long duration = micros() - start;
+    if (duration > _maxLoopMicros) {
+        _maxLoopMicros = duration;
+    }
 }
 
 /**
@@ -95,11 +190,7 @@ void Tetris::loopCycle(){
  * 
  */
 void Tetris::ctrlStart() {
-    if (millis() > _lastButtonClick + DEBOUNCE_TIME)
-    {
-        _lastButtonClick = millis();
-        _gameStatet = GAME_STATE_INITt;
-    }
+    pushInput(INPUT_KEY_START, INPUT_ACTION_TAP);
 }
 
 /**
@@ -107,20 +198,7 @@ void Tetris::ctrlStart() {
  * 
  */
 void Tetris::ctrlPlayPause() {
-    if (millis() > _lastButtonClick + DEBOUNCE_TIME)
-    {
-        _lastButtonClick = millis();
-        if (_gameStatet == GAME_STATE_PAUSEDt) {
-            (*_logger).logString("Tetris: continue");
-
-            _gameStatet = GAME_STATE_RUNNINGt;
-
-        } else if (_gameStatet == GAME_STATE_RUNNINGt) {
-            (*_logger).logString("Tetris: pause");
-
-            _gameStatet = GAME_STATE_PAUSEDt;
-        }
-    }
+    pushInput(INPUT_KEY_PAUSE, INPUT_ACTION_TAP);
 }
 
 /**
@@ -128,12 +206,7 @@ void Tetris::ctrlPlayPause() {
  * 
  */
 void Tetris::ctrlRight() {
-    if (millis() > _lastButtonClick + DEBOUNCE_TIME && _gameStatet == GAME_STATE_RUNNINGt)
-    {
-        _lastButtonClick = millis();
-        shiftActiveBrick(DIR_RIGHT);
-        printField();
-    }
+    pushInput(INPUT_KEY_RIGHT, INPUT_ACTION_TAP);
 }
 
 /**
@@ -141,12 +214,7 @@ void Tetris::ctrlRight() {
  * 
  */
 void Tetris::ctrlLeft() {
-    if (millis() > _lastButtonClick + DEBOUNCE_TIME && _gameStatet == GAME_STATE_RUNNINGt)
-    {
-        _lastButtonClick = millis();
-        shiftActiveBrick(DIR_LEFT);
-        printField();
-    }
+    pushInput(INPUT_KEY_LEFT, INPUT_ACTION_TAP);
 }
 
 /**
@@ -154,12 +222,7 @@ void Tetris::ctrlLeft() {
  * 
  */
 void Tetris::ctrlUp() {
-    if (millis() > _lastButtonClick + DEBOUNCE_TIME && _gameStatet == GAME_STATE_RUNNINGt)
-    {
-        _lastButtonClick = millis();
-        rotateActiveBrick();
-        printField();
-    }
+    pushInput(INPUT_KEY_UP, INPUT_ACTION_TAP);
 }
 
 /**
@@ -167,12 +230,134 @@ void Tetris::ctrlUp() {
  * 
  */
 void Tetris::ctrlDown() {
-    // longer debounce time, to prevent immediate drop
-    if (millis() > _lastButtonClickr + DEBOUNCE_TIME*5 && _gameStatet == GAME_STATE_RUNNINGt)
-    {
-        _allowdrop = true;
-        _lastButtonClickr = millis();
+    pushInput(INPUT_KEY_DOWN, INPUT_ACTION_TAP);
+}
+
+/**
+ * @brief Trigger control: key pressed and held down (LEFT/RIGHT repeat after DAS_TIME every ARR_TIME)
+ * 
+ * @param key key {UP, DOWN, LEFT, RIGHT}
+ */
+void Tetris::ctrlPress(uint8_t key) {
+    pushInput(key, INPUT_ACTION_PRESS);
+}
+
+/**
+ * @brief Trigger control: key released
+ * 
+ * @param key key {UP, DOWN, LEFT, RIGHT}
+ */
+void Tetris::ctrlRelease(uint8_t key) {
+    pushInput(key, INPUT_ACTION_RELEASE);
+}
+
+/**
+ * @brief Queue an input event, it is applied with the next tick
+ * 
+ * @param key key of the event (INPUT_KEY_...)
+ * @param action action of the event {TAP, PRESS, RELEASE}
+ */
+void Tetris::pushInput(uint8_t key, uint8_t action) {
+    if (!_inputs.push(key, action)) {
+        (*_logger).logString("Tetris: input queue full, " + String(_inputs.getDropped()) + " inputs dropped");
+    }
+}
+
+/**
+ * @brief Apply all queued input events in order, then repeat the held key
+ * 
+ */
+void Tetris::processInputs() {
+    InputEvent event;
+    while (popInput(event)) {
+        applyInput(event);
+    }
+    repeatHeldKey();
+}
+
+/**
+ * @brief Apply one input event to the game
+ * 
+ * @param event input event
+ */
+void Tetris::applyInput(const InputEvent &event) {
+    if (event.key == INPUT_KEY_START) {
+        setGameState(GAME_STATE_INIT);
+        return;
+    }
+    if (event.key == INPUT_KEY_PAUSE) {
+        if (_gameState == GAME_STATE_PAUSED) {
+            (*_logger).logString("Tetris: continue");
+
+            setGameState(GAME_STATE_RUNNING);
+
+        } else if (_gameState == GAME_STATE_RUNNING) {
+            (*_logger).logString("Tetris: pause");
+
+            setGameState(GAME_STATE_PAUSED);
+        }
+        return;
+    }
+    if (event.action == INPUT_ACTION_RELEASE) {
+        if (event.key == _heldKey) {
+            _heldKey = INPUT_KEY_NONE;
+        }
+        return;
+    }
+    if (_gameState != GAME_STATE_RUNNING || !_activeBrick.enabled) {
+        return;
+    }
+    switch (event.key) {
+        case INPUT_KEY_LEFT:
+        case INPUT_KEY_RIGHT:
+            shiftActiveBrick(event.key == INPUT_KEY_LEFT ? DIR_LEFT : DIR_RIGHT);
+            if (event.action == INPUT_ACTION_PRESS) {
+                _heldKey = event.key;
+                _nextRepeatTime = event.time + _das;
+            }
+            break;
+        case INPUT_KEY_UP:
+            rotateActiveBrick();
+            break;
+        case INPUT_KEY_DOWN:
+            _allowdrop = true;
+            break;
+    }
+    invalidate();
+}
+
+/**
+ * @brief Shift active brick in direction of the held key (delayed auto shift)
+ * 
+ */
+void Tetris::repeatHeldKey() {
+    if (_heldKey == INPUT_KEY_NONE || _gameState != GAME_STATE_RUNNING || !_activeBrick.enabled) {
+        return;
     }
+    // catch up all repeats since the last cycle, at most one field width
+    uint8_t shifts = 0;
+    while ((long)(getTime() - _nextRepeatTime) >= 0 && shifts < GRID_WIDTH) {
+        shiftActiveBrick(_heldKey == INPUT_KEY_LEFT ? DIR_LEFT : DIR_RIGHT);
+        _nextRepeatTime += _arr;
+        shifts++;
+    }
+    if (shifts > 0) {
+        invalidate();
+    }
+    if (shifts >= GRID_WIDTH) {
+        _nextRepeatTime = getTime() + _arr;
+    }
+}
+
+/**
+ * @brief Set repeat behaviour of held left/right keys
+ * 
+ * @param das delay in ms before the held key starts to repeat
+ * @param arr delay in ms between repeated shifts
+ */
+void Tetris::setRepeat(uint16_t das, uint16_t arr) {
+    _das = das;
+    _arr = max(arr, (uint16_t)1);
 }
 
 /**
@@ -186,13 +371,49 @@ void Tetris::setSpeed(int32_t i) {
 }
 
 /**
- * @brief Clear the led matrix (turn all leds off)
+ * @brief Get number of bricks spawned since start, changes with every new active brick
+ * 
+ * @return unsigned long number of bricks
+ */
+unsigned long Tetris::getBrickCount() {
+    return _brickCount;
+}
+
+/**
+ * @brief Get type, rotation and position of the active brick
+ * 
+ * @param type index of brick in the brick library
+ * @param rotation rotation of brick (0-3)
+ * @param xpos x position of the brick
+ * @param ypos y position of the brick
+ * @return true if there is an active brick
+ */
+bool Tetris::getActiveBrick(uint8_t *type, uint8_t *rotation, int *xpos, int *ypos) {
+    *type = _activeBrick.type;
+    *rotation = _activeBrick.rotation;
+    *xpos = _activeBrick.xpos;
+    *ypos = _activeBrick.ypos;
+    return _activeBrick.enabled && _gameState == GAME_STATE_RUNNING;
+}
+
+/**
+ * @brief Get rows of the field as bitmasks (GRID_HEIGHT + 1 rows, see FIELD_OFFSET, FIELD_WALLS)
  * 
+ * @return const uint16_t* pointer to the rows
  */
-void Tetris::resetLEDs()
-{
-    (*_ledmatrix).gridFlush();
-    (*_ledmatrix).drawOnMatrixInstant();
+const uint16_t *Tetris::getFieldRows() {
+    return _field.rows;
+}
+
+/**
+ * @brief Get row masks of a brick in the given rotation
+ * 
+ * @param type index of brick in the brick library
+ * @param rotation rotation of brick (0-3)
+ * @return const uint8_t* MAX_BRICK_SIZE row masks (bit x is column x of the brick)
+ */
+const uint8_t *Tetris::getBrickRows(uint8_t type, uint8_t rotation) {
+    return brickRotations[type][rotation];
 }
 
 /**
@@ -202,44 +423,69 @@ void Tetris::resetLEDs()
 void Tetris::tetrisInit() {
     (*_logger).logString("Tetris: init");
     
+    startTime();
     clearField();
     _brickSpeed = INIT_SPEED;
     _nbRowsThisLevel = 0;
     _nbRowsTotal = 0;
     _tetrisGameOver = false;
-
+    _clearing = false;
+    _clearingRows = 0;
+    _lastBrick = 0;
+    _showScore = false;
+    _maxLoopMicros = 0;
+    // a replayed game has to start in the same state as the recorded one
+    _allowdrop = false;
+    _droptime = 0;
+
+    setGameState(GAME_STATE_RUNNING);
     newActiveBrick();
-    _prevUpdateTime = millis();
+    _prevUpdateTime = getTime();
+}
 
-    _gameStatet = GAME_STATE_RUNNINGt;
+/**
+ * @brief Check if the active brick covers the given field position
+ * 
+ * @param x column
+ * @param y row
+ * @return boolean true if the active brick has a pixel at x, y
+ */
+boolean Tetris::activeBrickPixel(int x, int y) {
+    if (!_activeBrick.enabled) { //Only draw brick if it is enabled
+        return false;
+    }
+    int bx = x - _activeBrick.xpos;
+    int by = y - _activeBrick.ypos;
+    if (bx < 0 || bx >= MAX_BRICK_SIZE || by < 0 || by >= MAX_BRICK_SIZE) {
+        return false;
+    }
+    return (_activeBrick.rows[by] >> bx) & 1;
 }
 
 /**
- * @brief Draw current field representation to led matrix
+ * @brief Draw current field representation, at game end all bricks in red, after that the score
  * 
+ * @param framebuffer target of drawing
  */
-void Tetris::printField() {
+void Tetris::render(Framebuffer &framebuffer) {
+    framebuffer.gridFlush();
+    if (_gameState == GAME_STATE_READY) {
+        if (_showScore) {
+            drawScore(framebuffer);
+        }
+        return;
+    }
+    bool gameOver = (_gameState == GAME_STATE_END);
     int x, y;
-    for (x = 0; x < GRID_WIDTH; x++) {
-        for (y = 0; y < GRID_HEIGHT; y++) {
-            uint8_t activeBrickPix = 0;
-            if (_activeBrick.enabled) { //Only draw brick if it is enabled
-                //Now check if brick is "in view"
-                if ((x >= _activeBrick.xpos) && (x < (_activeBrick.xpos + (_activeBrick.siz)))
-                        && (y >= _activeBrick.ypos) && (y < (_activeBrick.ypos + (_activeBrick.siz)))) {
-                    activeBrickPix = (_activeBrick.pix)[x - _activeBrick.xpos][y - _activeBrick.ypos];
-                }
-            }
-            if (_field.pix[x][y] == 1) {
-                (*_ledmatrix).gridAddPixel(x, y, _field.color[x][y]);
-            } else if (activeBrickPix == 1) {
-                (*_ledmatrix).gridAddPixel(x, y, _activeBrick.col);
-            } else {
-                (*_ledmatrix).gridAddPixel(x, y, 0x000000);
+    for (y = 0; y < GRID_HEIGHT; y++) {
+        for (x = 0; x < GRID_WIDTH; x++) {
+            if ((_field.rows[y] >> (x + FIELD_OFFSET)) & 1) {
+                framebuffer.gridAddPixel(x, y, gameOver ? RED : _brickLib[_field.color[y][x] - 1].col);
+            } else if (activeBrickPixel(x, y)) {
+                framebuffer.gridAddPixel(x, y, gameOver ? RED : _activeBrick.col);
             }
         }
     }
-    (*_ledmatrix).drawOnMatrixInstant();
 }
 
 
@@ -250,16 +496,15 @@ void Tetris::printField() {
  */
 void Tetris::newActiveBrick() {
     uint8_t selectedBrick = 0;
-    static uint8_t lastselectedBrick = 0;
 
     // choose random next brick, but not the same as before
     do {
         selectedBrick = random(7);
     }
-    while (lastselectedBrick == selectedBrick);
+    while (_lastBrick == selectedBrick);
 
     // Save selected brick for next round
-    lastselectedBrick = selectedBrick;
+    _lastBrick = selectedBrick;
 
     // every brick has its color, select corresponding color
     uint32_t selectedCol = _brickLib[selectedBrick].col;
@@ -269,146 +514,85 @@ void Tetris::newActiveBrick() {
     _activeBrick.xpos = GRID_WIDTH / 2 - _activeBrick.siz / 2;
     _activeBrick.ypos = BRICKOFFSET - _activeBrick.yOffset;
     _activeBrick.enabled = true;
+    _brickCount++;
 
     // Set color of brick
     _activeBrick.col = selectedCol;
-    // _activeBrick.color = _colorLib[1];
 
-    // Copy pix array of selected Brick
-    uint8_t x, y;
-    for (y = 0; y < MAX_BRICK_SIZE; y++) {
-        for (x = 0; x < MAX_BRICK_SIZE; x++) {
-            _activeBrick.pix[x][y] = (_brickLib[selectedBrick]).pix[x][y];
-        }
-    }
+    // Copy row masks of selected Brick
+    _activeBrick.type = selectedBrick;
+    _activeBrick.rotation = 0;
+    memcpy(_activeBrick.rows, brickRotations[selectedBrick][0], MAX_BRICK_SIZE);
+    invalidate();
 
     // Check collision, if already, then game is over
     if (checkFieldCollision(&_activeBrick)) {
         _tetrisGameOver = true;
-        _gameStatet = GAME_STATE_ENDt;
+        setGameState(GAME_STATE_END);
 
     }
 }
 
 /**
- * @brief Check collision between bricks in the field and the specified brick
+ * @brief Get row of the field as collision mask. Positions outside of the field (walls, floor) are set.
  * 
- * @param brick brick to be checked for collision
- * @return boolean true if collision occured
+ * @param y row
+ * @return uint32_t collision mask of row (bit FIELD_OFFSET + x is column x)
  */
-boolean Tetris::checkFieldCollision(struct Brick * brick) {
-    uint8_t bx, by;
-    uint8_t fx, fy;
-    for (by = 0; by < MAX_BRICK_SIZE; by++) {
-        for (bx = 0; bx < MAX_BRICK_SIZE; bx++) {
-            fx = (*brick).xpos + bx;
-            fy = (*brick).ypos + by;
-            if (( (*brick).pix[bx][by] == 1)
-                    && ( _field.pix[fx][fy] == 1)) {
-                return true;
-            }
-        }
+uint32_t Tetris::getFieldRow(int y) {
+    if (y < 0) {
+        // above the field there are only the walls
+        return FIELD_WALLS | 0xFFFF0000;
     }
-    return false;
+    if (y > GRID_HEIGHT) {
+        return 0xFFFFFFFF;
+    }
+    return _field.rows[y] | 0xFFFF0000;
 }
 
 /**
- * @brief Check collision between specified brick and all sides of the playing field
+ * @brief Check collision between the specified brick and the bricks in the field or the sides of the playing field
  * 
  * @param brick brick to be checked for collision
  * @return boolean true if collision occured
  */
-boolean Tetris::checkSidesCollision(struct Brick * brick) {
-    //Check vertical collision with sides of field
-    uint8_t bx, by;
-    uint8_t fx, fy;
-    for (by = 0; by < MAX_BRICK_SIZE; by++) {
-        for (bx = 0; bx < MAX_BRICK_SIZE; bx++) {
-            if ( (*brick).pix[bx][by] == 1) {
-                fx = (*brick).xpos + bx;//Determine actual position in the field of the current pix of the brick
-                fy = (*brick).ypos + by;
-                if (fx < 0 || fx >= GRID_WIDTH) {
-                    return true;
-                }
-            }
+boolean Tetris::checkFieldCollision(struct Brick * brick) {
+    int shift = (*brick).xpos + FIELD_OFFSET;
+    for (uint8_t by = 0; by < MAX_BRICK_SIZE; by++) {
+        if ((*brick).rows[by] == 0) {
+            continue;
+        }
+        if (shift < 0) {
+            return true;
+        }
+        if (((uint32_t)(*brick).rows[by] << shift) & getFieldRow((*brick).ypos + by)) {
+            return true;
         }
     }
     return false;
 }
 
 /**
- * @brief Rotate current active brick
+ * @brief Rotate current active brick (clockwise). If the rotated brick collides,
+ * the wall kicks are tried in order and the first free position is taken.
  * 
  */
 void Tetris::rotateActiveBrick() {
-    //Copy active brick pix array to temporary pix array
-    uint8_t x, y;
-    Brick tmpBrick;
-    for (y = 0; y < MAX_BRICK_SIZE; y++) {
-        for (x = 0; x < MAX_BRICK_SIZE; x++) {
-            tmpBrick.pix[x][y] = _activeBrick.pix[x][y];
-        }
-    }
-    tmpBrick.xpos = _activeBrick.xpos;
-    tmpBrick.ypos = _activeBrick.ypos;
-    tmpBrick.siz = _activeBrick.siz;
-
-    //Depending on size of the active brick, we will rotate differently
-    if (_activeBrick.siz == 3) {
-        //Perform rotation around center pix
-        tmpBrick.pix[0][0] = _activeBrick.pix[0][2];
-        tmpBrick.pix[0][1] = _activeBrick.pix[1][2];
-        tmpBrick.pix[0][2] = _activeBrick.pix[2][2];
-        tmpBrick.pix[1][0] = _activeBrick.pix[0][1];
-        tmpBrick.pix[1][1] = _activeBrick.pix[1][1];
-        tmpBrick.pix[1][2] = _activeBrick.pix[2][1];
-        tmpBrick.pix[2][0] = _activeBrick.pix[0][0];
-        tmpBrick.pix[2][1] = _activeBrick.pix[1][0];
-        tmpBrick.pix[2][2] = _activeBrick.pix[2][0];
-        //Keep other parts of temporary block clear
-        tmpBrick.pix[0][3] = 0;
-        tmpBrick.pix[1][3] = 0;
-        tmpBrick.pix[2][3] = 0;
-        tmpBrick.pix[3][3] = 0;
-        tmpBrick.pix[3][2] = 0;
-        tmpBrick.pix[3][1] = 0;
-        tmpBrick.pix[3][0] = 0;
-
-    } else if (_activeBrick.siz == 4) {
-        //Perform rotation around center "cross"
-        tmpBrick.pix[0][0] = _activeBrick.pix[0][3];
-        tmpBrick.pix[0][1] = _activeBrick.pix[1][3];
-        tmpBrick.pix[0][2] = _activeBrick.pix[2][3];
-        tmpBrick.pix[0][3] = _activeBrick.pix[3][3];
-        tmpBrick.pix[1][0] = _activeBrick.pix[0][2];
-        tmpBrick.pix[1][1] = _activeBrick.pix[1][2];
-        tmpBrick.pix[1][2] = _activeBrick.pix[2][2];
-        tmpBrick.pix[1][3] = _activeBrick.pix[3][2];
-        tmpBrick.pix[2][0] = _activeBrick.pix[0][1];
-        tmpBrick.pix[2][1] = _activeBrick.pix[1][1];
-        tmpBrick.pix[2][2] = _activeBrick.pix[2][1];
-        tmpBrick.pix[2][3] = _activeBrick.pix[3][1];
-        tmpBrick.pix[3][0] = _activeBrick.pix[0][0];
-        tmpBrick.pix[3][1] = _activeBrick.pix[1][0];
-        tmpBrick.pix[3][2] = _activeBrick.pix[2][0];
-        tmpBrick.pix[3][3] = _activeBrick.pix[3][0];
-    } else {
-        (*_logger).logString("Tetris: Brick size error");
-    }
-
-    // Now validate by checking collision.
-    // Collision possibilities:
-    //   - Brick now sticks outside field
-    //   - Brick now sticks inside fixed bricks of field
-    // In case of collision, we just discard the rotated temporary brick
-    if ((!checkSidesCollision(&tmpBrick)) && (!checkFieldCollision(&tmpBrick))) {
-        //Copy temporary brick pix array to active pix array
-        for (y = 0; y < MAX_BRICK_SIZE; y++) {
-            for (x = 0; x < MAX_BRICK_SIZE; x++) {
-                _activeBrick.pix[x][y] = tmpBrick.pix[x][y];
-            }
+    Brick tmpBrick = _activeBrick;
+    tmpBrick.rotation = (_activeBrick.rotation + 1) % 4;
+    memcpy(tmpBrick.rows, brickRotations[tmpBrick.type][tmpBrick.rotation], MAX_BRICK_SIZE);
+
+    // 3x3 bricks and the I brick have different kicks, the O brick does not change with rotation
+    const int8_t (*kicks)[2] = wallKicks[(_activeBrick.type == 1) ? 1 : 0][_activeBrick.rotation];
+    for (uint8_t i = 0; i < 5; i++) {
+        tmpBrick.xpos = _activeBrick.xpos + kicks[i][0];
+        tmpBrick.ypos = _activeBrick.ypos + kicks[i][1];
+        if (!checkFieldCollision(&tmpBrick)) {
+            _activeBrick = tmpBrick;
+            return;
         }
     }
+    // In case of collision at all kick positions, we just discard the rotated temporary brick
 }
 
 /**
@@ -431,7 +615,7 @@ void Tetris::shiftActiveBrick(int dir) {
     //   - Direction was LEFT/RIGHT, just revert position back
     //   - Direction was DOWN, revert position and fix block to field on collision
     // When no collision, keep _activeBrick coordinates
-    if ((checkSidesCollision(&_activeBrick)) || (checkFieldCollision(&_activeBrick))) {
+    if (checkFieldCollision(&_activeBrick)) {
         if (dir == DIR_LEFT) {
             _activeBrick.xpos++;
         } else if (dir == DIR_RIGHT) {
@@ -449,71 +633,77 @@ void Tetris::shiftActiveBrick(int dir) {
  * 
  */
 void Tetris::addActiveBrickToField() {
-    uint8_t bx, by;
-    uint8_t fx, fy;
-    for (by = 0; by < MAX_BRICK_SIZE; by++) {
-        for (bx = 0; bx < MAX_BRICK_SIZE; bx++) {
-            fx = _activeBrick.xpos + bx;
-            fy = _activeBrick.ypos + by;
-
-            if (fx >= 0 && fy >= 0 && fx < GRID_WIDTH && fy < GRID_HEIGHT && _activeBrick.pix[bx][by]) { // Check if inside playing field
-                // _field.pix[fx][fy] = _field.pix[fx][fy] || _activeBrick.pix[bx][by];
-                _field.pix[fx][fy] = _activeBrick.pix[bx][by];
-                _field.color[fx][fy] = _activeBrick.col;
+    for (uint8_t by = 0; by < MAX_BRICK_SIZE; by++) {
+        int fy = _activeBrick.ypos + by;
+        if (fy < 0 || fy >= GRID_HEIGHT || _activeBrick.rows[by] == 0) { // Check if inside playing field
+            continue;
+        }
+        _field.rows[fy] |= (uint16_t)(_activeBrick.rows[by] << (_activeBrick.xpos + FIELD_OFFSET));
+        for (uint8_t bx = 0; bx < MAX_BRICK_SIZE; bx++) {
+            if ((_activeBrick.rows[by] >> bx) & 1) {
+                _field.color[fy][_activeBrick.xpos + bx] = _activeBrick.type + 1;
             }
         }
     }
 }
 
 /**
- * @brief Move all pix from the field above startRow down by one. startRow is overwritten
+ * @brief Move all rows of the field above startRow down by one. startRow is overwritten
  * 
  * @param startRow 
  */
 void Tetris::moveFieldDownOne(uint8_t startRow) {
-    if (startRow == 0) { // Topmost row has nothing on top to move...
-        return;
+    for (uint8_t y = startRow; y > 0; y--) {
+        _field.rows[y] = _field.rows[y - 1];
+        memcpy(_field.color[y], _field.color[y - 1], GRID_WIDTH);
     }
-    uint8_t x, y;
-    for (y = startRow - 1; y > 0; y--) {
-        for (x = 0; x < GRID_WIDTH; x++) {
-            _field.pix[x][y + 1] = _field.pix[x][y];
-            _field.color[x][y + 1] = _field.color[x][y];
+    _field.rows[0] = FIELD_WALLS;
+    memset(_field.color[0], 0, GRID_WIDTH);
+}
+
+/**
+ * @brief Check for complete lines and mark them for the line clear animation
+ * 
+ * @return true if at least one line is complete
+ */
+bool Tetris::checkFullLines() {
+    _clearingRows = 0;
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        if (_field.rows[y] == FIELD_FULL) {
+            _clearingRows |= (1 << y);
         }
     }
+    return _clearingRows != 0;
 }
 
 /**
- * @brief Check if a line is complete
+ * @brief One step of the line clear animation: clear the next column of all full lines.
+ * After the last column the lines are removed and a new brick is created.
  * 
  */
-void Tetris::checkFullLines() {
-    int x, y;
-    int minY = 0;
-    for (y = (GRID_HEIGHT - 1); y >= minY; y--) {
-        uint8_t rowSum = 0;
-        for (x = 0; x < GRID_WIDTH; x++) {
-            rowSum = rowSum + (_field.pix[x][y]);
-        }
-        if (rowSum >= GRID_WIDTH) {
-            // Found full row, animate its removal
-            _activeBrick.enabled = false;
-
-            for (x = 0; x < GRID_WIDTH; x++) {
-                _field.pix[x][y] = 0;
-                printField();
-                delay(100);
+void Tetris::clearLinesStep() {
+    uint8_t y;
+    if (_clearingColumn < GRID_WIDTH) {
+        for (y = 0; y < GRID_HEIGHT; y++) {
+            if (_clearingRows & (1 << y)) {
+                _field.rows[y] &= ~(1 << (_clearingColumn + FIELD_OFFSET));
             }
-            // Move all upper rows down by one
-            moveFieldDownOne(y);
-            y++; minY++;
-            printField();
-            delay(100);
+        }
+        _clearingColumn++;
+        invalidate();
+        return;
+    }
 
+    // Move all upper rows down, starting with the topmost full row so that the row indices below stay valid
+    for (y = 0; y < GRID_HEIGHT; y++) {
+        if (_clearingRows & (1 << y)) {
+            moveFieldDownOne(y);
 
             _nbRowsThisLevel++; _nbRowsTotal++;
+            setScore(_nbRowsTotal);
             if (_nbRowsThisLevel >= LEVELUP) {
                 _nbRowsThisLevel = 0;
+                setLevel(getLevel() + 1);
                 _brickSpeed = _brickSpeed - SPEED_STEP;
                 if (_brickSpeed < 200) {
                     _brickSpeed = 200;
@@ -521,6 +711,12 @@ void Tetris::checkFullLines() {
             }
         }
     }
+    _clearingRows = 0;
+    _clearing = false;
+    invalidate();
+
+    newActiveBrick();
+    _prevUpdateTime = getTime();//Reset update time to avoid brick dropping two spaces
 }
 
 /**
@@ -528,58 +724,25 @@ void Tetris::checkFullLines() {
  * 
  */
 void Tetris::clearField() {
-    uint8_t x, y;
-    for (y = 0; y < GRID_HEIGHT; y++) {
-        for (x = 0; x < GRID_WIDTH; x++) {
-            _field.pix[x][y] = 0;
-            _field.color[x][y] = 0;
-        }
-    }
-    for (x = 0; x < GRID_WIDTH; x++) { //This last row is invisible to the player and only used for the collision detection routine
-        _field.pix[x][GRID_HEIGHT] = 1;
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        _field.rows[y] = FIELD_WALLS;
     }
+    memset(_field.color, 0, sizeof(_field.color));
+    _field.rows[GRID_HEIGHT] = FIELD_FULL; //This last row is invisible to the player and only used for the collision detection routine
 }
 
 /**
- * @brief Color all bricks on the field red
+ * @brief Draw score of the last game
  * 
+ * @param framebuffer target of drawing
  */
-void Tetris::everythingRed() {
-    int x, y;
-    for (x = 0; x < GRID_WIDTH; x++) {
-        for (y = 0; y < GRID_HEIGHT; y++) {
-            uint8_t activeBrickPix = 0;
-            if (_activeBrick.enabled) { //Only draw brick if it is enabled
-                //Now check if brick is "in view"
-                if ((x >= _activeBrick.xpos) && (x < (_activeBrick.xpos + (_activeBrick.siz)))
-                        && (y >= _activeBrick.ypos) && (y < (_activeBrick.ypos + (_activeBrick.siz)))) {
-                    activeBrickPix = (_activeBrick.pix)[x - _activeBrick.xpos][y - _activeBrick.ypos];
-                }
-            }
-            if (_field.pix[x][y] == 1) {
-                (*_ledmatrix).gridAddPixel(x, y, RED);
-            } else if (activeBrickPix == 1) {
-                (*_ledmatrix).gridAddPixel(x, y, RED);
-            } else {
-                (*_ledmatrix).gridAddPixel(x, y, 0x000000);
-            }
-        }
-    }
-    (*_ledmatrix).drawOnMatrixInstant();
-}
-
-/**
- * @brief Draw score to led matrix
- * 
- */
-void Tetris::showscore() {
+void Tetris::drawScore(Framebuffer &framebuffer) {
     uint32_t color = LEDMatrix::Color24bit(255, 170, 0);
-    (*_ledmatrix).gridFlush();
-    if(_score > 9){
-        (*_ledmatrix).printNumber(2, 3, _score/10, color);
-        (*_ledmatrix).printNumber(6, 3, _score%10, color);
+    uint32_t score = getScore();
+    if(score > 9){
+        framebuffer.printNumber(2, 3, score/10, color);
+        framebuffer.printNumber(6, 3, score%10, color);
     }else{
-        (*_ledmatrix).printNumber(4, 3, _score, color);
+        framebuffer.printNumber(4, 3, score, color);
     }
-    (*_ledmatrix).drawOnMatrixInstant();
-}
\ No newline at end of file
+}
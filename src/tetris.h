@@ -16,15 +16,12 @@
 #include <Arduino.h>
 #include "ledmatrix.h"
 #include "udplogger.h"
+#include "inputqueue.h"
+#include "game.h"
 #include "config.h"
 
-#define DEBOUNCE_TIME 100
 #define RED_END_TIME 1500
-#define GAME_STATE_RUNNINGt 1
-#define GAME_STATE_ENDt     2
-#define GAME_STATE_INITt    3
-#define GAME_STATE_PAUSEDt  4
-#define GAME_STATE_READYt   5
+#define TETRIS_TICK_TIME 10     // in ms, resolution of all timings of the game
 
 //common
 #define  DIR_UP    1
@@ -49,13 +46,22 @@
 #define  INIT_SPEED        800  // Initial delay in ms between brick drops
 #define  SPEED_STEP        10   // Factor for speed increase between levels, default 10
 #define  LEVELUP           4    // Number of rows before levelup, default 5
+#define  CLEAR_STEP_TIME   60   // Delay in ms between the steps of the line clear animation
+#define  DAS_TIME          170  // Delay in ms before a held left/right key starts to repeat (delayed auto shift)
+#define  ARR_TIME          50   // Delay in ms between repeated shifts of a held key (auto repeat rate)
 
-class Tetris{
+#define  FIELD_OFFSET      3        // bit position of column 0 in a field row, leaves space for bricks partly left of the field
+#define  FIELD_FULL        0xFFFF   // row mask of a complete row (incl. walls)
+#define  FIELD_WALLS       ((uint16_t)~(((1 << GRID_WIDTH) - 1) << FIELD_OFFSET)) // row mask of an empty row (only walls)
 
-    // Playing field
+class Tetris : public Game{
+
+    friend class TetrisTest;        // native tests (test/test_tetris) set up the field
+
+    // Playing field, every row is a bitmask (bit FIELD_OFFSET + x is column x, all other bits are walls)
     struct Field {
-        uint8_t pix[GRID_WIDTH][GRID_HEIGHT + 1]; //Make field one larger so that collision detection with bottom of field can be done in a uniform way
-        uint32_t color[GRID_WIDTH][GRID_HEIGHT];
+        uint16_t rows[GRID_HEIGHT + 1]; //Make field one larger so that collision detection with bottom of field can be done in a uniform way
+        uint8_t color[GRID_HEIGHT][GRID_WIDTH]; // palette index (brick type + 1), 0 = empty
     };
 
 
@@ -65,7 +71,9 @@ class Tetris{
         int xpos, ypos;
         int yOffset;//Y-offset to use when placing brick at top of field
         uint8_t siz;
-        uint8_t pix[MAX_BRICK_SIZE][MAX_BRICK_SIZE];
+        uint8_t type;//index in brick library
+        uint8_t rotation;
+        uint8_t rows[MAX_BRICK_SIZE];//row masks of current rotation (bit x is column x of brick)
 
         uint32_t col;
     };
@@ -74,7 +82,6 @@ class Tetris{
     struct AbstractBrick {
         int yOffset;//Y-offset to use when placing brick at top of field
         uint8_t siz;
-        uint8_t pix[MAX_BRICK_SIZE][MAX_BRICK_SIZE];
         uint32_t col;
     };
 
@@ -88,128 +95,77 @@ class Tetris{
         void ctrlLeft();
         void ctrlUp();
         void ctrlDown();
+        void ctrlPress(uint8_t key);
+        void ctrlRelease(uint8_t key);
         void setSpeed(int32_t i);
+        void setRepeat(uint16_t das, uint16_t arr);
+
+        void render(Framebuffer &framebuffer) override;
 
-        void loopCycle();
+        unsigned long getBrickCount();
+        bool getActiveBrick(uint8_t *type, uint8_t *rotation, int *xpos, int *ypos);
+        const uint16_t *getFieldRows();
+        static const uint8_t *getBrickRows(uint8_t type, uint8_t rotation);
+
+    protected:
+        void update() override;
 
     private:
-        void resetLEDs();
         void tetrisInit();
-        void printField();
+        void pushInput(uint8_t key, uint8_t action);
+        void processInputs();
+        void applyInput(const InputEvent &event);
+        void repeatHeldKey();
+        uint32_t getFieldRow(int y);
+        boolean activeBrickPixel(int x, int y);
 
         /* *** Game functions *** */
         void newActiveBrick();
         boolean checkFieldCollision(struct Brick * brick);
-        boolean checkSidesCollision(struct Brick * brick);
         void rotateActiveBrick();
         void shiftActiveBrick(int dir);
         void addActiveBrickToField();
         void moveFieldDownOne(uint8_t startRow);
-        void checkFullLines();
+        bool checkFullLines();
+        void clearLinesStep();
 
         void clearField();
-        void everythingRed();
-        void showscore();
+        void drawScore(Framebuffer &framebuffer);
 
 
-        LEDMatrix *_ledmatrix;
-        UDPLogger *_logger;
         Brick _activeBrick;
         Field _field;
 
-        long _lastButtonClick = 0;
-        long _lastButtonClickr = 0;
-        int _score = 0;
-        int _gameStatet = GAME_STATE_INITt;
+        uint8_t _heldKey = INPUT_KEY_NONE;  // left/right key which is held down
+        unsigned long _nextRepeatTime = 0;
+        uint16_t _das = DAS_TIME;
+        uint16_t _arr = ARR_TIME;
         uint16_t _brickSpeed;
         unsigned long _nbRowsThisLevel;
         unsigned long _nbRowsTotal;
+        unsigned long _brickCount = 0;
+        uint8_t _lastBrick = 0;           // type of the previous brick
 
         bool _tetrisGameOver;
+        bool _showScore = false;          // score of the last game is shown in state READY
 
         unsigned long _prevUpdateTime = 0;
 
+        // line clear animation (game stays RUNNING)
+        bool _clearing = false;
+        uint16_t _clearingRows = 0;       // bitmask of full rows which are cleared
+        uint8_t _clearingColumn = 0;      // next column to be cleared
+        unsigned long _clearingStepTime = 0;
+
+        unsigned long _maxLoopMicros = 0; // longest update of current game
+
         long _tetrisshowscore;
         long _droptime = 0;
         int _speedtetris = 80;
-        bool _allowdrop;
+        bool _allowdrop = false;
         
-        // color library
-        uint32_t _colorLib[10] = {RED, GREEN, BLUE, YELLOW, CHOCOLATE, PURPLE, WHITE, AQUA, HOTPINK, DARKORANGE};
-
-        // Brick "library"
-        AbstractBrick _brickLib[7] = {
-            {
-                1,//yoffset when adding brick to field
-                4,
-                { {0, 0, 0, 0},
-                {0, 1, 1, 0},
-                {0, 1, 1, 0},
-                {0, 0, 0, 0}
-                },
-                WHITE
-            },
-            {
-                0,
-                4,
-                { {0, 1, 0, 0},
-                {0, 1, 0, 0},
-                {0, 1, 0, 0},
-                {0, 1, 0, 0}
-                },
-                GREEN
-            },
-            {
-                1,
-                3,
-                { {0, 0, 0, 0},
-                {1, 1, 1, 0},
-                {0, 0, 1, 0},
-                {0, 0, 0, 0}
-                },
-                BLUE
-            },
-            {
-                1,
-                3,
-                { {0, 0, 1, 0},
-                {1, 1, 1, 0},
-                {0, 0, 0, 0},
-                {0, 0, 0, 0}
-                },
-                YELLOW
-            },
-            {
-                1,
-                3,
-                { {0, 0, 0, 0},
-                {1, 1, 1, 0},
-                {0, 1, 0, 0},
-                {0, 0, 0, 0}
-                },
-                AQUA
-            },
-            {
-                1,
-                3,
-                { {0, 1, 1, 0},
-                {1, 1, 0, 0},
-                {0, 0, 0, 0},
-                {0, 0, 0, 0}
-                },
-                HOTPINK
-            },
-            {
-                1,
-                3,
-                { {1, 1, 0, 0},
-                {0, 1, 1, 0},
-                {0, 0, 0, 0},
-                {0, 0, 0, 0}
-                },
-                RED
-            }
-        };
+        // Brick "library" (shapes and rotations see brickRotations in tetris.cpp)
+        static const AbstractBrick _brickLib[7];
 
 };
 
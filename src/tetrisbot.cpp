@@ -0,0 +1,223 @@
+/**
+ * @file tetrisbot.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class implementation for the tetris autoplayer (demo mode)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include "tetrisbot.h"
+
+/**
+ * @brief Construct a new TetrisBot:: TetrisBot object
+ *
+ */
+TetrisBot::TetrisBot(){
+
+}
+
+/**
+ * @brief Construct a new TetrisBot:: TetrisBot object
+ *
+ * @param mytetris pointer to Tetris object, which is controlled by the bot
+ * @param mylogger pointer to UDPLogger object, need to provide a function logString(message)
+ */
+TetrisBot::TetrisBot(Tetris *mytetris, UDPLogger *mylogger){
+    _tetris = mytetris;
+    _logger = mylogger;
+}
+
+/**
+ * @brief Start a new game
+ *
+ */
+void TetrisBot::initGame(){
+    _gameEndTime = 0;
+    _lastBrickCount = (*_tetris).getBrickCount();
+    _searchMicros = 0;
+    _numPlacements = 0;
+    _maxSearchMicros = 0;
+    (*_tetris).ctrlStart();
+}
+
+/**
+ * @brief Run main loop for one cycle, plans the placement of every new brick and executes one move per call
+ *
+ */
+void TetrisBot::loopCycle(){
+    GameState state = (*_tetris).getGameState();
+    if (state == GAME_STATE_READY || state == GAME_STATE_END) {
+        // restart game some time after the score was shown
+        if (_gameEndTime == 0) {
+            _gameEndTime = millis();
+            if (_numPlacements > 0) {
+                (*_logger).logString("TetrisBot: " + String(_numPlacements) + " placements evaluated in " + String(_searchMicros) +
+                                     " us (" + String((uint32_t)((uint64_t)_numPlacements * 1000000 / max(_searchMicros, 1UL))) +
+                                     "/s), longest search " + String(_maxSearchMicros) + " us");
+            }
+        }
+        else if (millis() - _gameEndTime > TETRISBOT_RESTART_TIME) {
+            initGame();
+        }
+        return;
+    }
+    _gameEndTime = 0;
+
+    uint8_t type, rotation;
+    int xpos, ypos;
+    if (!(*_tetris).getActiveBrick(&type, &rotation, &xpos, &ypos)) {
+        return;
+    }
+    if ((*_tetris).getBrickCount() != _lastBrickCount) {
+        _lastBrickCount = (*_tetris).getBrickCount();
+        planPlacement(type, xpos, ypos);
+    }
+
+    // one move per cycle: rotate first, then shift, then drop
+    if (rotation != _targetRotation) {
+        (*_tetris).ctrlUp();
+    } else if (xpos < _targetX) {
+        (*_tetris).ctrlRight();
+    } else if (xpos > _targetX) {
+        (*_tetris).ctrlLeft();
+    } else {
+        (*_tetris).ctrlDown();
+    }
+}
+
+/**
+ * @brief Search the best placement of the active brick: try all rotations and columns,
+ * drop the brick straight down and rate the resulting field
+ *
+ * @param type index of the brick in the brick library
+ * @param xpos current x position of the brick
+ * @param ypos current y position of the brick
+ */
+void TetrisBot::planPlacement(uint8_t type, int xpos, int ypos){
+    unsigned long start = micros();
+    const uint16_t *rows = (*_tetris).getFieldRows();
+    int32_t bestScore = INT32_MIN;
+    _targetRotation = 0;
+    _targetX = xpos;
+
+    for (uint8_t r = 0; r < 4; r++) {
+        const uint8_t *brick = Tetris::getBrickRows(type, r);
+        for (int x = -FIELD_OFFSET; x < GRID_WIDTH; x++) {
+            if (checkCollision(rows, brick, x, ypos)) {
+                continue;
+            }
+            int y = ypos;
+            while (!checkCollision(rows, brick, x, y + 1)) {
+                y++;
+            }
+            int32_t score = evaluatePlacement(rows, brick, x, y);
+            _numPlacements++;
+            if (score > bestScore) {
+                bestScore = score;
+                _targetRotation = r;
+                _targetX = x;
+            }
+        }
+    }
+
+    unsigned long duration = micros() - start;
+    _searchMicros += duration;
+    if (duration > _maxSearchMicros) {
+        _maxSearchMicros = duration;
+    }
+}
+
+/**
+ * @brief Rate the field after placing the brick at the given position
+ *
+ * @param rows rows of the field as bitmasks (see Tetris::getFieldRows())
+ * @param brick row masks of the brick
+ * @param xpos x position of the brick
+ * @param ypos y position of the brick
+ * @return int32_t score, higher is better
+ */
+int32_t TetrisBot::evaluatePlacement(const uint16_t *rows, const uint8_t *brick, int xpos, int ypos){
+    uint16_t field[GRID_HEIGHT];
+    memcpy(field, rows, sizeof(field));
+    for (uint8_t by = 0; by < MAX_BRICK_SIZE; by++) {
+        if (brick[by] == 0) {
+            continue;
+        }
+        int fy = ypos + by;
+        if (fy < 0) {
+            return TETRISBOT_SCORE_INVALID;
+        }
+        field[fy] |= (uint16_t)(brick[by] << (xpos + FIELD_OFFSET));
+    }
+
+    // remove full lines (copy the remaining rows bottom up)
+    int lines = 0;
+    int dst = GRID_HEIGHT - 1;
+    for (int y = GRID_HEIGHT - 1; y >= 0; y--) {
+        if (field[y] == FIELD_FULL) {
+            lines++;
+        } else {
+            field[dst--] = field[y];
+        }
+    }
+    while (dst >= 0) {
+        field[dst--] = FIELD_WALLS;
+    }
+
+    // column heights and holes (empty cells below the top of a column)
+    uint8_t heights[GRID_WIDTH] = {0};
+    uint16_t covered = 0;
+    int holes = 0;
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        uint16_t cells = field[y] & ~FIELD_WALLS;
+        uint16_t newTops = cells & ~covered;
+        while (newTops) {
+            uint8_t bit = __builtin_ctz(newTops);
+            heights[bit - FIELD_OFFSET] = GRID_HEIGHT - y;
+            newTops &= newTops - 1;
+        }
+        holes += __builtin_popcount(covered & ~cells);
+        covered |= cells;
+    }
+
+    int aggregateHeight = 0;
+    int bumpiness = 0;
+    for (uint8_t x = 0; x < GRID_WIDTH; x++) {
+        aggregateHeight += heights[x];
+        if (x > 0) {
+            bumpiness += abs(heights[x] - heights[x - 1]);
+        }
+    }
+
+    return TETRISBOT_WEIGHT_HEIGHT * aggregateHeight + TETRISBOT_WEIGHT_LINES * lines +
+           TETRISBOT_WEIGHT_HOLES * holes + TETRISBOT_WEIGHT_BUMPINESS * bumpiness;
+}
+
+/**
+ * @brief Check collision of a brick with the field (incl. walls and floor)
+ *
+ * @param rows rows of the field as bitmasks (GRID_HEIGHT + 1 rows)
+ * @param brick row masks of the brick
+ * @param xpos x position of the brick
+ * @param ypos y position of the brick
+ * @return true if the brick collides
+ */
+bool TetrisBot::checkCollision(const uint16_t *rows, const uint8_t *brick, int xpos, int ypos){
+    int shift = xpos + FIELD_OFFSET;
+    for (uint8_t by = 0; by < MAX_BRICK_SIZE; by++) {
+        if (brick[by] == 0) {
+            continue;
+        }
+        int fy = ypos + by;
+        if (shift < 0 || fy > GRID_HEIGHT) {
+            return true;
+        }
+        uint32_t row = ((fy < 0) ? FIELD_WALLS : rows[fy]) | 0xFFFF0000;
+        if (((uint32_t)brick[by] << shift) & row) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,62 @@
+/**
+ * @file tetrisbot.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Class declaration for the tetris autoplayer (demo mode)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The bot searches all rotations and columns of the active brick on the
+ * bitboard field of the game, rates the resulting fields with a heuristic
+ * (height, lines, holes, bumpiness) and moves the brick with the ctrl* API.
+ *
+ */
+#ifndef tetrisbot_h
+#define tetrisbot_h
+
+#include <Arduino.h>
+#include "tetris.h"
+#include "udplogger.h"
+#include "config.h"
+
+#define TETRISBOT_RESTART_TIME      3000    // time in ms after game end until a new game is started
+
+// weights of the heuristic (scaled by 100)
+#define TETRISBOT_WEIGHT_HEIGHT     -51
+#define TETRISBOT_WEIGHT_LINES      76
+#define TETRISBOT_WEIGHT_HOLES      -36
+#define TETRISBOT_WEIGHT_BUMPINESS  -18
+#define TETRISBOT_SCORE_INVALID     -100000 // score of placements which stick out of the top of the field
+
+class TetrisBot{
+
+    friend class TetrisBotTest;     // native tests (test/test_tetrisbot) check the planned placement
+
+    public:
+        TetrisBot();
+        TetrisBot(Tetris *mytetris, UDPLogger *mylogger);
+
+        void initGame();
+        void loopCycle();
+
+    private:
+        void planPlacement(uint8_t type, int xpos, int ypos);
+        int32_t evaluatePlacement(const uint16_t *rows, const uint8_t *brick, int xpos, int ypos);
+        bool checkCollision(const uint16_t *rows, const uint8_t *brick, int xpos, int ypos);
+
+        Tetris *_tetris;
+        UDPLogger *_logger;
+
+        unsigned long _lastBrickCount = 0;
+        uint8_t _targetRotation = 0;
+        int _targetX = 0;
+        unsigned long _gameEndTime = 0;
+
+        // statistics of placement search
+        unsigned long _searchMicros = 0;
+        unsigned long _numPlacements = 0;
+        unsigned long _maxSearchMicros = 0;
+};
+
+#endif
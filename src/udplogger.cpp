@@ -16,7 +16,14 @@ void UDPLogger::setName(String name){
     // _name = name;
 }
 
+void UDPLogger::setMuted(bool muted){
+    _muted = muted;
+}
+
 void UDPLogger::logString(String logmessage){
+    if(_muted){
+        return;
+    }
     Serial.println(logmessage);
     // // wait 5 milliseconds if last send was less than 5 milliseconds before 
     // if(millis() < (_lastSend + 5)){
@@ -21,6 +21,7 @@ class UDPLogger{
         UDPLogger();
         UDPLogger(IPAddress interfaceAddr, IPAddress multicastAddr, int port);
         void setName(String name);
+        void setMuted(bool muted);
         void logString(String logmessage);
         void logColor24bit(uint32_t color);
     private:
@@ -31,6 +32,7 @@ class UDPLogger{
         WiFiUDP _Udp;
         char _packetBuffer[100];
         long _lastSend;
+        bool _muted = false;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,16 @@
+/**
+ * @file Adafruit_GFX.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Empty Adafruit GFX for the native tests (see Adafruit_NeoMatrix.h)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef Adafruit_GFX_h
+#define Adafruit_GFX_h
+
+#include <Arduino.h>
+
+#endif
@@ -0,0 +1,60 @@
+/**
+ * @file Adafruit_NeoMatrix.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief NeoMatrix for the native tests: keeps the pixels in memory instead of driving the LEDs
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * LEDMatrix runs unchanged on top of it, a test can read back what was shown
+ * (getPixel()) and how often (getShowCount()).
+ *
+ */
+#ifndef Adafruit_NeoMatrix_h
+#define Adafruit_NeoMatrix_h
+
+#include <Arduino.h>
+#include <vector>
+
+#define NEO_MATRIX_TOP 0x00
+#define NEO_MATRIX_BOTTOM 0x01
+#define NEO_MATRIX_LEFT 0x00
+#define NEO_MATRIX_RIGHT 0x02
+#define NEO_MATRIX_ROWS 0x00
+#define NEO_MATRIX_COLUMNS 0x04
+#define NEO_MATRIX_PROGRESSIVE 0x00
+#define NEO_MATRIX_ZIGZAG 0x08
+#define NEO_GRB 0x52
+#define NEO_KHZ800 0x0000
+
+class Adafruit_NeoMatrix {
+public:
+    Adafruit_NeoMatrix(int width, int height, uint8_t, uint8_t, uint16_t)
+        : _width(width), _height(height), _pixels(width * height + 16, 0) {}
+    void begin() {}
+    void setTextWrap(bool) {}
+    void setBrightness(uint8_t brightness) { _brightness = brightness; }
+    void fillScreen(uint16_t color) { std::fill(_pixels.begin(), _pixels.begin() + _width * _height, color); }
+    void drawPixel(int16_t x, int16_t y, uint16_t color) {
+        if (x >= 0 && x < _width && y >= 0 && y < _height) _pixels[y * _width + x] = color;
+    }
+    void setPixelColor(uint16_t n, uint32_t color) {
+        if (n < _pixels.size()) _pixels[n] = color;
+    }
+    void show() { _showCount++; }
+
+    uint32_t getPixel(int16_t x, int16_t y) const { return _pixels[y * _width + x]; }
+    uint32_t getPixelColor(uint16_t n) const { return _pixels[n]; }
+    uint8_t getBrightness() const { return _brightness; }
+    uint32_t getShowCount() const { return _showCount; }
+
+private:
+    int _width;
+    int _height;
+    std::vector<uint32_t> _pixels;
+    uint8_t _brightness = 0;
+    uint32_t _showCount = 0;
+};
+
+#endif
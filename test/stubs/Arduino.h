@@ -0,0 +1,208 @@
+/**
+ * @file Arduino.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Minimal Arduino core for the native tests (pio test -e native)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Only the parts of the Arduino API used by the sources of the native build.
+ * The clock runs in real time by default, a test can switch it to a fake
+ * clock which only moves with nativeAdvanceMicros()/nativeAdvanceMillis()
+ * and delay().
+ *
+ */
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <thread>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define LED_BUILTIN 2
+
+#define F(string_literal) (string_literal)
+#define PROGMEM
+
+using std::min;
+using std::max;
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ----------------------------------------------------------------------------------
+//                                        STRING
+// ----------------------------------------------------------------------------------
+
+class String {
+public:
+    String() {}
+    String(const char *cstr) : _s(cstr ? cstr : "") {}
+    String(const std::string &str) : _s(str) {}
+    explicit String(char c) : _s(1, c) {}
+    String(int value) : _s(std::to_string(value)) {}
+    String(unsigned int value) : _s(std::to_string(value)) {}
+    String(long value) : _s(std::to_string(value)) {}
+    String(unsigned long value) : _s(std::to_string(value)) {}
+    String(long long value) : _s(std::to_string(value)) {}
+    String(unsigned long long value) : _s(std::to_string(value)) {}
+    String(double value, unsigned int decimalPlaces = 2) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "%.*f", decimalPlaces, value);
+        _s = buffer;
+    }
+
+    String operator+(const String &rhs) const { return String(_s + rhs._s); }
+    friend String operator+(const char *lhs, const String &rhs) { return String(std::string(lhs) + rhs._s); }
+    String &operator+=(const String &rhs) { _s += rhs._s; return *this; }
+    String &operator+=(const char *rhs) { _s += rhs; return *this; }
+    String &operator+=(char c) { _s += c; return *this; }
+    bool operator==(const String &rhs) const { return _s == rhs._s; }
+    bool operator==(const char *rhs) const { return _s == rhs; }
+    bool operator!=(const String &rhs) const { return _s != rhs._s; }
+    bool operator!=(const char *rhs) const { return _s != rhs; }
+    bool operator<(const String &rhs) const { return _s < rhs._s; }
+    char operator[](unsigned int index) const { return index < _s.size() ? _s[index] : 0; }
+
+    unsigned int length() const { return _s.size(); }
+    const char *c_str() const { return _s.c_str(); }
+    char charAt(unsigned int index) const { return (*this)[index]; }
+    long toInt() const { return atol(_s.c_str()); }
+    float toFloat() const { return atof(_s.c_str()); }
+    int indexOf(char c, unsigned int from = 0) const { return find(_s.find(c, from)); }
+    int indexOf(const String &str, unsigned int from = 0) const { return find(_s.find(str._s, from)); }
+    int lastIndexOf(char c) const { return find(_s.rfind(c)); }
+    String substring(unsigned int from) const { return from < _s.size() ? String(_s.substr(from)) : String(); }
+    String substring(unsigned int from, unsigned int to) const { return from < _s.size() && to > from ? String(_s.substr(from, to - from)) : String(); }
+    bool startsWith(const String &prefix) const { return _s.compare(0, prefix._s.size(), prefix._s) == 0; }
+    bool endsWith(const String &suffix) const { return _s.size() >= suffix._s.size() && _s.compare(_s.size() - suffix._s.size(), suffix._s.size(), suffix._s) == 0; }
+    void toLowerCase() { std::transform(_s.begin(), _s.end(), _s.begin(), ::tolower); }
+    void toCharArray(char *buffer, unsigned int size) const { strlcpyStub(buffer, _s.c_str(), size); }
+    bool reserve(unsigned int size) { _s.reserve(size); return true; }
+
+private:
+    static int find(size_t pos) { return pos == std::string::npos ? -1 : (int)pos; }
+    static void strlcpyStub(char *dst, const char *src, size_t size) {
+        if (size == 0) return;
+        size_t n = std::min(strlen(src), size - 1);
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    std::string _s;
+};
+
+inline size_t strlcpy(char *dst, const char *src, size_t size) {
+    size_t length = strlen(src);
+    if (size > 0) {
+        size_t n = std::min(length, size - 1);
+        memcpy(dst, src, n);
+        dst[n] = '\0';
+    }
+    return length;
+}
+
+// ----------------------------------------------------------------------------------
+//                                        TIME
+// ----------------------------------------------------------------------------------
+
+struct NativeClock {
+    bool fake = false;
+    unsigned long fakeMicros = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+
+inline NativeClock &nativeClock() {
+    static NativeClock clock;
+    return clock;
+}
+
+inline unsigned long micros() {
+    NativeClock &clock = nativeClock();
+    if (clock.fake) return clock.fakeMicros;
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - clock.start).count();
+}
+
+inline unsigned long millis() {
+    NativeClock &clock = nativeClock();
+    if (clock.fake) return clock.fakeMicros / 1000;
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - clock.start).count();
+}
+
+inline void delay(unsigned long ms) {
+    NativeClock &clock = nativeClock();
+    if (clock.fake) clock.fakeMicros += ms * 1000;
+    else std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+inline void yield() {}
+
+// switch to the fake clock (starting at the given time) or back to real time
+inline void nativeUseFakeClock(bool fake, unsigned long startMillis = 0) {
+    nativeClock().fake = fake;
+    nativeClock().fakeMicros = startMillis * 1000;
+}
+
+inline void nativeAdvanceMicros(unsigned long us) { nativeClock().fakeMicros += us; }
+inline void nativeAdvanceMillis(unsigned long ms) { nativeClock().fakeMicros += ms * 1000; }
+
+// ----------------------------------------------------------------------------------
+//                                        RANDOM
+// ----------------------------------------------------------------------------------
+
+inline std::minstd_rand &nativeRandom() {
+    static std::minstd_rand generator(1);
+    return generator;
+}
+
+inline void randomSeed(unsigned long seed) { nativeRandom().seed(seed == 0 ? 1 : seed); }
+
+inline long random(long howbig) {
+    if (howbig <= 0) return 0;
+    return nativeRandom()() % howbig;
+}
+
+inline long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return howsmall + random(howbig - howsmall);
+}
+
+// ----------------------------------------------------------------------------------
+//                                        HARDWARE
+// ----------------------------------------------------------------------------------
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return HIGH; }
+inline uint16_t analogRead(uint8_t) { return 0; }
+
+struct NativeSerial {
+    void begin(unsigned long) {}
+    template <typename T> void print(const T &) {}
+    template <typename T> void println(const T &) {}
+    void println() {}
+    template <typename... Args> void printf(const char *, Args...) {}
+};
+static NativeSerial Serial __attribute__((unused));
+
+struct NativeESP {
+    uint32_t getFreeHeap() { return 0; }
+    void restart() {}
+};
+static NativeESP ESP __attribute__((unused));
+
+#endif
@@ -0,0 +1,87 @@
+/**
+ * @file FS.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief File system for the native tests, the files are stored in a directory of the host
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef FS_h
+#define FS_h
+
+#include <Arduino.h>
+#include <memory>
+#include <sys/stat.h>
+
+// directory of the host which holds the files of the native file system
+inline std::string &nativeFsRoot() {
+    static std::string root = "/tmp/wordclock_native_fs";
+    return root;
+}
+
+namespace fs {
+
+class File {
+public:
+    File() {}
+    explicit File(FILE *file) : _file(file, [](FILE *f) { fclose(f); }) {}
+
+    explicit operator bool() const { return (bool)_file; }
+
+    size_t read(uint8_t *buffer, size_t size) { return _file ? fread(buffer, 1, size, _file.get()) : 0; }
+    int read() {
+        uint8_t value;
+        return read(&value, 1) == 1 ? value : -1;
+    }
+    size_t write(const uint8_t *buffer, size_t size) { return _file ? fwrite(buffer, 1, size, _file.get()) : 0; }
+    size_t write(uint8_t value) { return write(&value, 1); }
+    void flush() {
+        if (_file) fflush(_file.get());
+    }
+    bool seek(uint32_t pos) { return _file && fseek(_file.get(), pos, SEEK_SET) == 0; }
+    size_t position() const { return _file ? ftell(_file.get()) : 0; }
+    size_t size() const {
+        if (!_file) return 0;
+        long pos = ftell(_file.get());
+        fseek(_file.get(), 0, SEEK_END);
+        long size = ftell(_file.get());
+        fseek(_file.get(), pos, SEEK_SET);
+        return size;
+    }
+    int available() { return size() - position(); }
+    void close() { _file.reset(); }
+
+private:
+    std::shared_ptr<FILE> _file;
+};
+
+class FS {
+public:
+    bool begin(bool formatOnFail = false) {
+        (void)formatOnFail;
+        ::mkdir(nativeFsRoot().c_str(), 0755);
+        return true;
+    }
+    File open(const String &path, const char *mode = "r") {
+        const char *hostMode = (mode[0] == 'w') ? "w+b" : (mode[0] == 'a') ? "a+b" : "rb";
+        FILE *file = fopen(hostPath(path).c_str(), hostMode);
+        return file ? File(file) : File();
+    }
+    bool exists(const String &path) {
+        struct stat info;
+        return stat(hostPath(path).c_str(), &info) == 0;
+    }
+    bool remove(const String &path) { return ::remove(hostPath(path).c_str()) == 0; }
+
+private:
+    std::string hostPath(const String &path) { return nativeFsRoot() + path.c_str(); }
+};
+
+}
+
+using fs::File;
+using fs::FS;
+
+#endif
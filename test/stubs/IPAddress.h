@@ -0,0 +1,29 @@
+/**
+ * @file IPAddress.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief IPAddress for the native tests
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef IPAddress_h
+#define IPAddress_h
+
+#include <Arduino.h>
+
+class IPAddress {
+public:
+    IPAddress() {}
+    IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) : _bytes{a, b, c, d} {}
+    uint8_t operator[](int index) const { return _bytes[index]; }
+    String toString() const {
+        return String(_bytes[0]) + "." + String(_bytes[1]) + "." + String(_bytes[2]) + "." + String(_bytes[3]);
+    }
+
+private:
+    uint8_t _bytes[4] = {0, 0, 0, 0};
+};
+
+#endif
@@ -0,0 +1,19 @@
+/**
+ * @file LittleFS.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief LittleFS for the native tests, see FS.h
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef LittleFS_h
+#define LittleFS_h
+
+#include <FS.h>
+
+// all instances share the directory nativeFsRoot()
+static fs::FS LittleFS __attribute__((unused));
+
+#endif
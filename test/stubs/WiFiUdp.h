@@ -0,0 +1,65 @@
+/**
+ * @file WiFiUdp.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief WiFiUDP for the native tests: sent packets are dropped, received packets are queued by the test
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#ifndef WiFiUdp_h
+#define WiFiUdp_h
+
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <deque>
+#include <vector>
+
+// packets to be received by all WiFiUDP objects, in order
+inline std::deque<std::vector<uint8_t>> &nativeUdpPackets() {
+    static std::deque<std::vector<uint8_t>> packets;
+    return packets;
+}
+
+class WiFiUDP {
+public:
+    uint8_t begin(uint16_t) { return 1; }
+    uint8_t beginMulticast(IPAddress, uint16_t) { return 1; }
+    void stop() {}
+    int beginPacket(IPAddress, uint16_t) { return 1; }
+    int beginMulticastPacket() { return 1; }
+    size_t write(uint8_t) { return 1; }
+    size_t write(const uint8_t *, size_t size) { return size; }
+    size_t print(const char *text) { return strlen(text); }
+    int endPacket() { return 1; }
+
+    int parsePacket() {
+        if (nativeUdpPackets().empty()) {
+            _packet.clear();
+            return 0;
+        }
+        _packet = nativeUdpPackets().front();
+        nativeUdpPackets().pop_front();
+        _position = 0;
+        return _packet.size();
+    }
+    int available() { return _packet.size() - _position; }
+    int read() { return _position < _packet.size() ? _packet[_position++] : -1; }
+    int read(uint8_t *buffer, size_t size) {
+        size_t n = std::min(size, _packet.size() - _position);
+        memcpy(buffer, _packet.data() + _position, n);
+        _position += n;
+        return n;
+    }
+    int read(char *buffer, size_t size) { return read((uint8_t *)buffer, size); }
+    void flush() {}
+    IPAddress remoteIP() { return IPAddress(127, 0, 0, 1); }
+    uint16_t remotePort() { return 0; }
+
+private:
+    std::vector<uint8_t> _packet;
+    size_t _position = 0;
+};
+
+#endif
@@ -0,0 +1,224 @@
+/**
+ * @file test_animplayer.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Native round-trip tests: animations encoded with the WcaEncoder (tools/wcaencoder) are played by the AnimationPlayer
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+#include <chrono>
+#include "animplayer.h"
+#include "wcaencoder.h"
+
+#define TEST_FILE "/test.wca"
+
+Adafruit_NeoMatrix matrix(GRID_WIDTH + 1, GRID_HEIGHT, NEOPIXELPIN, NEOPIXEL_MATRIX_TYPE, NEOPIXEL_LED_TYPE);
+UDPLogger logger;
+LEDMatrix ledmatrix(&matrix, 40, &logger);
+
+/**
+ * @brief Write the encoded animation to the native file system
+ */
+void writeFile(const std::vector<uint8_t> &data) {
+    File file = LittleFS.open(TEST_FILE, "w");
+    TEST_ASSERT_TRUE(file);
+    TEST_ASSERT_EQUAL(data.size(), file.write(data.data(), data.size()));
+    file.close();
+}
+
+/**
+ * @brief Frame with a moving diagonal stripe on a gradient background and some noise
+ */
+std::vector<uint32_t> makeFrame(uint16_t index) {
+    std::vector<uint32_t> pixels;
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        for (uint8_t x = 0; x < GRID_WIDTH; x++) {
+            uint32_t color = LEDMatrix::Color24bit(x * 20, y * 20, 0);
+            if ((x + y + index) % 7 == 0) {
+                color = LEDMatrix::Color24bit(255, 255, 255);
+            }
+            if (random(20) == 0) {
+                color = LEDMatrix::Color24bit(0, 0, random(4) * 60);
+            }
+            pixels.push_back(color);
+        }
+    }
+    return pixels;
+}
+
+void checkGrid(const std::vector<uint32_t> &pixels, uint16_t frame) {
+    char message[40];
+    snprintf(message, sizeof(message), "frame %d", frame);
+    TEST_ASSERT_EQUAL_HEX32_ARRAY_MESSAGE(pixels.data(), &ledmatrix.targetgrid[0][0], GRID_WIDTH * GRID_HEIGHT, message);
+}
+
+void setUp(void) {
+    nativeUseFakeClock(true, 1000);
+    randomSeed(7);
+    LittleFS.begin();
+    ledmatrix.gridFlush();
+}
+
+void tearDown(void) {
+    LittleFS.remove(TEST_FILE);
+    nativeUseFakeClock(false);
+}
+
+// every frame is shown exactly as encoded and after the duration of the previous one, looped animations start again
+void test_roundtrip_loop(void) {
+    const uint16_t numFrames = 40;
+    WcaEncoder encoder(GRID_WIDTH, GRID_HEIGHT, true);
+    std::vector<std::vector<uint32_t>> frames;
+    for (uint16_t i = 0; i < numFrames; i++) {
+        frames.push_back(makeFrame(i));
+        TEST_ASSERT_TRUE(encoder.addFrame(frames.back(), 50 + i));
+    }
+    writeFile(encoder.encode());
+
+    AnimationPlayer player(&ledmatrix, &logger);
+    player.setFile(TEST_FILE);
+    player.initGame();
+    for (uint16_t i = 0; i < 2 * numFrames; i++) {
+        player.loopCycle();
+        checkGrid(frames[i % numFrames], i);
+        // nothing happens before the duration is over
+        nativeAdvanceMillis(50 + i % numFrames - 1);
+        player.loopCycle();
+        checkGrid(frames[i % numFrames], i);
+        nativeAdvanceMillis(1);
+    }
+}
+
+// unchanged frames are stored as empty delta frames, a not looped animation keeps its last frame
+void test_delta_frames_and_end(void) {
+    WcaEncoder encoder(GRID_WIDTH, GRID_HEIGHT, false);
+    std::vector<uint32_t> first(GRID_WIDTH * GRID_HEIGHT, LEDMatrix::Color24bit(0, 0, 255));
+    std::vector<uint32_t> second = first;
+    second[5] = LEDMatrix::Color24bit(255, 0, 0);
+    TEST_ASSERT_TRUE(encoder.addFrame(first, 100));
+    TEST_ASSERT_TRUE(encoder.addFrame(first, 100));
+    TEST_ASSERT_TRUE(encoder.addFrame(second, 100));
+    std::vector<uint8_t> data = encoder.encode();
+
+    // header (10) + palette (2 colors), key frame: header (5) + one run of 110 pixels
+    const size_t offset = ANIMPLAYER_HEADER_SIZE + 2 * 3;
+    TEST_ASSERT_EQUAL(ANIMPLAYER_FRAME_KEY, data[offset + 2]);
+    TEST_ASSERT_EQUAL(2, data[offset + 3]);
+    // second frame: empty delta frame
+    TEST_ASSERT_EQUAL(ANIMPLAYER_FRAME_DELTA, data[offset + 7 + 2]);
+    TEST_ASSERT_EQUAL(0, data[offset + 7 + 3]);
+    // third frame: one changed pixel (skip 5, run 1, red)
+    TEST_ASSERT_EQUAL(ANIMPLAYER_FRAME_DELTA, data[offset + 12 + 2]);
+    TEST_ASSERT_EQUAL(3, data[offset + 12 + 3]);
+    TEST_ASSERT_EQUAL(5, data[offset + 12 + 5]);
+    TEST_ASSERT_EQUAL(1, data[offset + 12 + 6]);
+    TEST_ASSERT_EQUAL(offset + 12 + 5 + 3, data.size());
+    writeFile(data);
+
+    AnimationPlayer player(&ledmatrix, &logger);
+    player.setFile(TEST_FILE);
+    player.initGame();
+    for (uint8_t i = 0; i < 3; i++) {
+        player.loopCycle();
+        nativeAdvanceMillis(100);
+    }
+    checkGrid(second, 2);
+    for (uint8_t i = 0; i < 5; i++) {
+        player.loopCycle();
+        nativeAdvanceMillis(100);
+        checkGrid(second, 3 + i);
+    }
+}
+
+// a palette with 256 colors is stored with size 0, the 257th color is rejected
+void test_full_palette(void) {
+    WcaEncoder encoder(GRID_WIDTH, GRID_HEIGHT, true);
+    std::vector<std::vector<uint32_t>> frames;
+    for (uint16_t first = 0; first < 256; first += GRID_WIDTH * GRID_HEIGHT) {
+        std::vector<uint32_t> pixels;
+        for (uint8_t i = 0; i < GRID_WIDTH * GRID_HEIGHT; i++) {
+            uint8_t color = min(first + i, 255);
+            pixels.push_back(LEDMatrix::Color24bit(color, 255 - color, 17));
+        }
+        frames.push_back(pixels);
+        TEST_ASSERT_TRUE(encoder.addFrame(pixels, 100));
+    }
+    TEST_ASSERT_EQUAL(256, encoder.paletteSize());
+    std::vector<uint32_t> tooMany(GRID_WIDTH * GRID_HEIGHT, LEDMatrix::Color24bit(1, 2, 3));
+    TEST_ASSERT_FALSE(encoder.addFrame(tooMany, 100));
+
+    std::vector<uint8_t> data = encoder.encode();
+    TEST_ASSERT_EQUAL(0, data[6]);
+    writeFile(data);
+
+    AnimationPlayer player(&ledmatrix, &logger);
+    player.setFile(TEST_FILE);
+    player.initGame();
+    for (uint16_t i = 0; i < frames.size(); i++) {
+        player.loopCycle();
+        checkGrid(frames[i], i);
+        nativeAdvanceMillis(100);
+    }
+}
+
+// files which do not match the grid are rejected
+void test_wrong_size(void) {
+    WcaEncoder encoder(GRID_WIDTH + 1, GRID_HEIGHT, true);
+    std::vector<uint32_t> pixels((GRID_WIDTH + 1) * GRID_HEIGHT, LEDMatrix::Color24bit(255, 0, 0));
+    TEST_ASSERT_FALSE(encoder.addFrame(std::vector<uint32_t>(3, 0), 100));
+    TEST_ASSERT_TRUE(encoder.addFrame(pixels, 100));
+    writeFile(encoder.encode());
+
+    AnimationPlayer player(&ledmatrix, &logger);
+    player.setFile(TEST_FILE);
+    player.initGame();
+    player.loopCycle();
+    std::vector<uint32_t> off(GRID_WIDTH * GRID_HEIGHT, 0);
+    checkGrid(off, 0);
+}
+
+// a long animation with key and delta frames is played through once, reports the decode time per frame on the host
+void test_playback_rate(void) {
+    const uint16_t numFrames = 600;
+    WcaEncoder encoder(GRID_WIDTH, GRID_HEIGHT, true);
+    std::vector<std::vector<uint32_t>> frames;
+    for (uint16_t i = 0; i < numFrames; i++) {
+        frames.push_back(makeFrame(i));
+        TEST_ASSERT_TRUE(encoder.addFrame(frames.back(), 20));
+    }
+    std::vector<uint8_t> data = encoder.encode();
+    writeFile(data);
+
+    AnimationPlayer player(&ledmatrix, &logger);
+    player.setFile(TEST_FILE);
+    player.initGame();
+    unsigned long totalMicros = 0;
+    unsigned long maxMicros = 0;
+    for (uint16_t i = 0; i < numFrames; i++) {
+        auto start = std::chrono::steady_clock::now();
+        player.loopCycle();
+        unsigned long micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        totalMicros += micros;
+        maxMicros = max(maxMicros, micros);
+        checkGrid(frames[i], i);
+        nativeAdvanceMillis(20);
+    }
+    char message[120];
+    snprintf(message, sizeof(message), "%u frames, %u bytes: %.2f us per frame avg, max %lu us, %.0f fps (host)",
+             numFrames, (unsigned)data.size(), (double)totalMicros / numFrames, maxMicros,
+             totalMicros > 0 ? numFrames * 1e6 / totalMicros : 0.0);
+    TEST_MESSAGE(message);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_roundtrip_loop);
+    RUN_TEST(test_delta_frames_and_end);
+    RUN_TEST(test_full_palette);
+    RUN_TEST(test_wrong_size);
+    RUN_TEST(test_playback_rate);
+    return UNITY_END();
+}
@@ -0,0 +1,222 @@
+/**
+ * @file test_commandqueue.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Native tests of the queue of web commands: order, overflow, cut strings, producer threads and the latency under load
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+#include "commandqueue.h"
+#include "latencyhistogram.h"
+
+#define COMMAND_TEST_THREADED   100000  // number of commands pushed by the producer thread
+#define LOAD_TEST_CLIENTS       4       // threads sending /cmd requests
+#define LOAD_TEST_COMMANDS      2500    // commands per client
+#define LOAD_TEST_FRAME_TIME    1000    // in us, time of one main loop cycle without the commands (drawing etc.)
+#define LOAD_TEST_EXECUTE_TIME  20      // in us, time to execute one command
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// commands keep their order, name, value and time
+void test_order(void) {
+    CommandQueue queue;
+    TEST_ASSERT_TRUE(queue.push("mode", "3", 100));
+    TEST_ASSERT_TRUE(queue.push("brightness", "40", 200));
+    TEST_ASSERT_TRUE(queue.push("ledoff", "", 300));
+    TEST_ASSERT_EQUAL(3, queue.size());
+
+    Command command;
+    TEST_ASSERT_TRUE(queue.pop(command));
+    TEST_ASSERT_EQUAL_STRING("mode", command.name);
+    TEST_ASSERT_EQUAL_STRING("3", command.value);
+    TEST_ASSERT_EQUAL(100, command.received);
+    TEST_ASSERT_TRUE(queue.pop(command));
+    TEST_ASSERT_EQUAL_STRING("brightness", command.name);
+    TEST_ASSERT_EQUAL_STRING("40", command.value);
+    TEST_ASSERT_EQUAL(200, command.received);
+    TEST_ASSERT_TRUE(queue.pop(command));
+    TEST_ASSERT_EQUAL_STRING("ledoff", command.name);
+    TEST_ASSERT_EQUAL_STRING("", command.value);
+    TEST_ASSERT_FALSE(queue.pop(command));
+    TEST_ASSERT_EQUAL(0, queue.size());
+}
+
+// a full queue drops new commands and keeps the queued ones, it takes commands again after a pop
+void test_overflow(void) {
+    CommandQueue queue;
+    for (uint8_t i = 0; i < COMMAND_QUEUE_SIZE; i++) {
+        TEST_ASSERT_TRUE(queue.push("mode", String(i), i));
+    }
+    TEST_ASSERT_EQUAL(COMMAND_QUEUE_SIZE, queue.size());
+    TEST_ASSERT_FALSE(queue.push("mode", "dropped", 99));
+    TEST_ASSERT_FALSE(queue.push("mode", "dropped", 99));
+    TEST_ASSERT_EQUAL(2, queue.getDropped());
+    TEST_ASSERT_EQUAL(COMMAND_QUEUE_SIZE, queue.size());
+
+    Command command;
+    TEST_ASSERT_TRUE(queue.pop(command));
+    TEST_ASSERT_EQUAL_STRING("0", command.value);
+    TEST_ASSERT_TRUE(queue.push("mode", "last", 100));
+    for (uint8_t i = 1; i < COMMAND_QUEUE_SIZE; i++) {
+        TEST_ASSERT_TRUE(queue.pop(command));
+        TEST_ASSERT_EQUAL_STRING(String(i).c_str(), command.value);
+    }
+    TEST_ASSERT_TRUE(queue.pop(command));
+    TEST_ASSERT_EQUAL_STRING("last", command.value);
+    TEST_ASSERT_FALSE(queue.pop(command));
+    TEST_ASSERT_EQUAL(2, queue.getDropped());
+}
+
+// the 8 bit indices wrap around many times, the size stays right
+void test_wrap_around(void) {
+    CommandQueue queue;
+    Command command;
+    for (uint16_t i = 0; i < 1000; i++) {
+        TEST_ASSERT_TRUE(queue.push("a", String(i), i));
+        TEST_ASSERT_TRUE(queue.push("b", String(i), i));
+        TEST_ASSERT_EQUAL(2, queue.size());
+        TEST_ASSERT_TRUE(queue.pop(command));
+        TEST_ASSERT_EQUAL_STRING("a", command.name);
+        TEST_ASSERT_EQUAL(i, command.received);
+        TEST_ASSERT_TRUE(queue.pop(command));
+        TEST_ASSERT_EQUAL_STRING("b", command.name);
+        TEST_ASSERT_EQUAL(0, queue.size());
+    }
+    TEST_ASSERT_EQUAL(0, queue.getDropped());
+}
+
+// too long names and values are cut and stay terminated
+void test_cut_strings(void) {
+    CommandQueue queue;
+    String name, value;
+    for (uint8_t i = 0; i < 2 * COMMAND_VALUE_SIZE; i++) {
+        name += (char)('a' + i % 26);
+        value += (char)('0' + i % 10);
+    }
+    TEST_ASSERT_TRUE(queue.push(name, value, 0));
+    Command command;
+    TEST_ASSERT_TRUE(queue.pop(command));
+    TEST_ASSERT_EQUAL(COMMAND_NAME_SIZE - 1, strlen(command.name));
+    TEST_ASSERT_EQUAL(COMMAND_VALUE_SIZE - 1, strlen(command.value));
+    TEST_ASSERT_EQUAL_STRING(name.substring(0, COMMAND_NAME_SIZE - 1).c_str(), command.name);
+    TEST_ASSERT_EQUAL_STRING(value.substring(0, COMMAND_VALUE_SIZE - 1).c_str(), command.value);
+}
+
+// a producer in another thread (like the TCP task) and the consumer: every command arrives once, complete and in order
+void test_producer_thread(void) {
+    CommandQueue queue;
+    uint32_t rejected = 0;
+    std::thread producer([&queue, &rejected]() {
+        for (uint32_t i = 0; i < COMMAND_TEST_THREADED; i++) {
+            // the value repeats the number, so a command which is read before it is written completely is detected
+            String value = String(i) + "/" + String(i);
+            while (!queue.push("seq", value, i)) {
+                rejected++;
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    Command command;
+    uint32_t expected = 0;
+    while (expected < COMMAND_TEST_THREADED) {
+        if (!queue.pop(command)) {
+            std::this_thread::yield();
+            continue;
+        }
+        TEST_ASSERT_EQUAL(expected, command.received);
+        TEST_ASSERT_EQUAL_STRING("seq", command.name);
+        TEST_ASSERT_EQUAL_STRING((String(expected) + "/" + String(expected)).c_str(), command.value);
+        expected++;
+    }
+    producer.join();
+    TEST_ASSERT_FALSE(queue.pop(command));
+    TEST_ASSERT_EQUAL((uint16_t)rejected, queue.getDropped());
+}
+
+/**
+ * @brief Busy wait like code running on the main loop (sleeping would give the time to other threads)
+ */
+void busyWait(unsigned long duration) {
+    unsigned long start = micros();
+    while (micros() - start < duration) {
+    }
+}
+
+// load test: several clients send /cmd requests while the main loop executes them, like handleCommand() and
+// handleCommands() in main.cpp; reports p50 and p99 of the handler time and of the time until a command is executed
+void test_load_latency(void) {
+    CommandQueue queue;
+    LatencyHistogram handlerLatency;
+    LatencyHistogram commandLatency;
+    // the handlers of all clients run in the one task of the TCP stack, the mutex serializes them the same way
+    std::mutex tcpTask;
+    std::vector<std::thread> clients;
+    for (uint8_t c = 0; c < LOAD_TEST_CLIENTS; c++) {
+        clients.emplace_back([&, c]() {
+            std::minstd_rand rng(c + 1);
+            for (uint16_t i = 0; i < LOAD_TEST_COMMANDS; i++) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200 + rng() % 1000));
+                std::lock_guard<std::mutex> lock(tcpTask);
+                unsigned long start = micros();
+                queue.push("brightness", String(i % 256), start);
+                handlerLatency.add(micros() - start);
+            }
+        });
+    }
+
+    // main loop
+    uint32_t executed = 0;
+    uint32_t cycles = 0;
+    while (executed + queue.getDropped() < LOAD_TEST_CLIENTS * LOAD_TEST_COMMANDS) {
+        Command command;
+        while (queue.pop(command)) {
+            busyWait(LOAD_TEST_EXECUTE_TIME);
+            commandLatency.add(micros() - command.received);
+            executed++;
+        }
+        busyWait(LOAD_TEST_FRAME_TIME);
+        cycles++;
+    }
+    for (std::thread &client : clients) {
+        client.join();
+    }
+
+    char message[200];
+    snprintf(message, sizeof(message), "%u commands in %u cycles, %u dropped: handler p50 %lu us, p99 %lu us, "
+             "executed after p50 %lu us, p99 %lu us, max %lu us (host)", (unsigned)executed, (unsigned)cycles,
+             (unsigned)queue.getDropped(), handlerLatency.getPercentile(50), handlerLatency.getPercentile(99),
+             commandLatency.getPercentile(50), commandLatency.getPercentile(99), commandLatency.getMax());
+    TEST_MESSAGE(message);
+    TEST_ASSERT_EQUAL(LOAD_TEST_CLIENTS * LOAD_TEST_COMMANDS, handlerLatency.getCount());
+    // the queue takes the commands of a few cycles, almost nothing is dropped
+    TEST_ASSERT_LESS_OR_EQUAL(LOAD_TEST_CLIENTS * LOAD_TEST_COMMANDS / 100, queue.getDropped());
+    // the handler only copies the command
+    TEST_ASSERT_LESS_THAN(100, handlerLatency.getPercentile(50));
+    TEST_ASSERT_LESS_THAN(2000, handlerLatency.getPercentile(99));
+    // a command waits for the end of the current cycle (generous bound for the scheduler of the host)
+    TEST_ASSERT_LESS_THAN(2 * LOAD_TEST_FRAME_TIME, commandLatency.getPercentile(50));
+    TEST_ASSERT_LESS_THAN(20 * LOAD_TEST_FRAME_TIME, commandLatency.getPercentile(99));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_order);
+    RUN_TEST(test_overflow);
+    RUN_TEST(test_wrap_around);
+    RUN_TEST(test_cut_strings);
+    RUN_TEST(test_producer_thread);
+    RUN_TEST(test_load_latency);
+    return UNITY_END();
+}
@@ -0,0 +1,106 @@
+/**
+ * @file test_gamebench.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Native tests of the headless benchmark: all games are played in slices by loopCycle() and end
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+#include <chrono>
+#include "gamebench.h"
+
+#define GAMEBENCH_TEST_GAMES    20
+
+UDPLogger logger;
+
+void setUp(void) {
+    randomSeed(1);
+}
+
+void tearDown(void) {
+}
+
+/**
+ * @brief Run the benchmark of a game like the main loop until it is finished
+ */
+GameBenchResult runBench(const char *game) {
+    GameBench bench(&logger);
+    TEST_ASSERT_TRUE(bench.start(game, GAMEBENCH_TEST_GAMES));
+    TEST_ASSERT_TRUE(bench.isRunning());
+    TEST_ASSERT_TRUE(bench.getResult().running);
+
+    uint32_t cycles = 0;
+    unsigned long maxCycleMicros = 0;
+    while (bench.isRunning()) {
+        auto start = std::chrono::steady_clock::now();
+        bench.loopCycle();
+        unsigned long micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        maxCycleMicros = max(maxCycleMicros, micros);
+        cycles++;
+    }
+    GameBenchResult result = bench.getResult();
+    TEST_ASSERT_FALSE(result.running);
+
+    char message[120];
+    snprintf(message, sizeof(message), "%s: %u games, %u stuck, %u ticks in %u cycles, max %lu us per cycle (host)", game,
+             (unsigned)result.games, (unsigned)result.stuck, (unsigned)result.ticks, (unsigned)cycles, maxCycleMicros);
+    TEST_MESSAGE(message);
+
+    // played in many slices, none of them takes much longer than the time budget
+    TEST_ASSERT_GREATER_THAN(1, cycles);
+    TEST_ASSERT_GREATER_OR_EQUAL(result.ticks / GAMEBENCH_CYCLE_TICKS, cycles);
+    TEST_ASSERT_LESS_THAN(4 * GAMEBENCH_CYCLE_TIME * 1000UL, maxCycleMicros);
+    // every game ends
+    TEST_ASSERT_EQUAL(GAMEBENCH_TEST_GAMES, result.games);
+    TEST_ASSERT_EQUAL(0, result.stuck);
+    TEST_ASSERT_LESS_OR_EQUAL(result.scoreMax, result.scoreMin);
+    return result;
+}
+
+void test_tetris(void) {
+    runBench("tetris");
+}
+
+void test_snake(void) {
+    runBench("snake");
+}
+
+void test_pong(void) {
+    runBench("pong");
+}
+
+// the bot never misses, the games only end because a ball which misses all bricks is deflected
+void test_breakout(void) {
+    GameBenchResult result = runBench("breakout");
+    TEST_ASSERT_GREATER_THAN(0, result.levelMax);
+}
+
+// unknown games are not started, stop() keeps the result of the finished games
+void test_unknown_game_and_stop(void) {
+    GameBench bench(&logger);
+    TEST_ASSERT_FALSE(bench.start("chess", 1));
+    TEST_ASSERT_FALSE(bench.isRunning());
+
+    TEST_ASSERT_TRUE(bench.start("pong", GAMEBENCH_MAX_GAMES));
+    while (bench.getResult().games < 2) {
+        bench.loopCycle();
+    }
+    bench.stop();
+    TEST_ASSERT_FALSE(bench.isRunning());
+    TEST_ASSERT_FALSE(bench.getResult().running);
+    TEST_ASSERT_GREATER_OR_EQUAL(2, bench.getResult().games);
+    bench.loopCycle();
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_tetris);
+    RUN_TEST(test_snake);
+    RUN_TEST(test_pong);
+    RUN_TEST(test_breakout);
+    RUN_TEST(test_unknown_game_and_stop);
+    return UNITY_END();
+}
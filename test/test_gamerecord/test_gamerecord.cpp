@@ -0,0 +1,254 @@
+/**
+ * @file test_gamerecord.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Native tests of recording and replaying games: the replayed game ends in the same state as the recorded one
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+#include <functional>
+#include "gamerecord.h"
+#include "gamebench.h"
+#include "tetris.h"
+#include "tetrisbot.h"
+#include "snake.h"
+#include "snakebot.h"
+#include "pong.h"
+#include "breakout.h"
+
+#define TEST_FILE           "/test.rec"
+#define TEST_MAX_CYCLES     500000      // limit of a recorded game (10 ms per cycle)
+
+// framebuffer which keeps a checksum of the drawing calls per pixel
+class TestFramebuffer : public Framebuffer {
+public:
+    void gridAddPixel(uint8_t x, uint8_t y, uint32_t color) override {
+        grid[y][x] = grid[y][x] * 31 + color;
+    }
+    void gridBlendPixel(uint8_t x, uint8_t y, uint32_t color, uint16_t weight) override {
+        grid[y][x] = (grid[y][x] * 31 + color) * 31 + weight;
+    }
+    void gridFlush(void) override {
+        memset(grid, 0, sizeof(grid));
+    }
+    uint32_t grid[GRID_HEIGHT][GRID_WIDTH] = {{0}};
+};
+
+// state of a game at its end
+struct FinalState {
+    bool ended;
+    uint32_t ticks;
+    uint32_t score;
+    uint8_t level;
+    TestFramebuffer frame;
+};
+
+UDPLogger logger;
+FinalState finalState;
+
+/**
+ * @brief Event hook: keep the state at the end of the game
+ */
+void storeFinalState(Game *game, uint8_t event) {
+    if (event != GAME_EVENT_END) {
+        return;
+    }
+    finalState.ended = true;
+    finalState.ticks = game->getTicks();
+    finalState.score = game->getScore();
+    finalState.level = game->getLevel();
+    game->render(finalState.frame);
+}
+
+void setUp(void) {
+    nativeUseFakeClock(true, 1000);
+    randomSeed(19);
+    LittleFS.begin();
+}
+
+void tearDown(void) {
+    LittleFS.remove(TEST_FILE);
+    nativeUseFakeClock(false);
+}
+
+/**
+ * @brief Record a started game played like in the main loop (10 ms per cycle) until it ends
+ *
+ * @param game game to be recorded
+ * @param gameId id of the game (GAME_ID_...)
+ * @param start starts the game
+ * @param input called before every cycle (bot or player inputs)
+ * @param maxCycles number of cycles after which the recording is stopped
+ */
+FinalState recordGame(Game &game, uint8_t gameId, std::function<void()> start, std::function<void(uint32_t)> input,
+                      uint32_t maxCycles = TEST_MAX_CYCLES) {
+    GameRecorder recorder(&logger);
+    finalState = {};
+    game.setEventHook(storeFinalState);
+    recorder.start(&game, gameId, TEST_FILE);
+    start();
+    for (uint32_t cycle = 0; cycle < maxCycles && !finalState.ended; cycle++) {
+        nativeAdvanceMillis(10);
+        input(cycle);
+        game.loopCycle();
+        recorder.loopCycle();
+    }
+    if (!finalState.ended) {
+        // recording of a game which was not finished ends at the current tick
+        finalState.ticks = game.getTicks();
+        finalState.score = game.getScore();
+        finalState.level = game.getLevel();
+        game.render(finalState.frame);
+    }
+    recorder.stop();
+    return finalState;
+}
+
+/**
+ * @brief Replay the recording headless (without time) and compare the final state with the recorded one
+ *
+ * @param game new instance of the recorded game
+ * @param start starts the game the same way as the recorded one
+ * @param recorded state at the end of the recording
+ */
+void replayGame(Game &game, std::function<void()> start, const FinalState &recorded) {
+    GameReplayer replayer;
+    TEST_ASSERT_TRUE(replayer.open(TEST_FILE));
+    finalState = {};
+    game.setEventHook(storeFinalState);
+    game.setReplayer(&replayer);
+    start();
+    while (!finalState.ended && !replayer.isFinished(game.getTicks())) {
+        game.step();
+    }
+    TEST_ASSERT_EQUAL(recorded.ended, finalState.ended);
+    if (!finalState.ended) {
+        finalState.ticks = game.getTicks();
+        finalState.score = game.getScore();
+        finalState.level = game.getLevel();
+        game.render(finalState.frame);
+    }
+    replayer.close();
+
+    char message[80];
+    snprintf(message, sizeof(message), "%u ticks, score %u, level %u", (unsigned)recorded.ticks, (unsigned)recorded.score,
+             (unsigned)recorded.level);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_EQUAL(recorded.ticks, finalState.ticks);
+    TEST_ASSERT_EQUAL(recorded.score, finalState.score);
+    TEST_ASSERT_EQUAL(recorded.level, finalState.level);
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(&recorded.frame.grid[0][0], &finalState.frame.grid[0][0], GRID_WIDTH * GRID_HEIGHT);
+}
+
+/**
+ * @brief Replay the recording with the benchmark like the main loop, it has to match the recording
+ */
+void benchReplay(void) {
+    GameBench bench(&logger);
+    TEST_ASSERT_TRUE(bench.replay(TEST_FILE));
+    uint32_t cycles = 0;
+    while (bench.isRunning()) {
+        bench.loopCycle();
+        cycles++;
+    }
+    TEST_ASSERT_EQUAL(GAMEBENCH_REPLAY_MATCH, bench.getResult().replay);
+    TEST_ASSERT_GREATER_OR_EQUAL(bench.getResult().ticks / GAMEBENCH_CYCLE_TICKS, cycles);
+}
+
+// tetris with the bot, which presses many keys
+void test_tetris_bot(void) {
+    Tetris tetris(nullptr, &logger);
+    TetrisBot bot(&tetris, &logger);
+    FinalState recorded = recordGame(tetris, GAME_ID_TETRIS, [&]() { bot.initGame(); }, [&](uint32_t cycle) { bot.loopCycle(); });
+    TEST_ASSERT_TRUE(recorded.ended);
+
+    Tetris replayed(nullptr, &logger);
+    replayGame(replayed, [&]() { replayed.ctrlStart(); }, recorded);
+    benchReplay();
+}
+
+// snake with the bot, one turn per step
+void test_snake_bot(void) {
+    Snake snake(nullptr, &logger);
+    SnakeBot bot(&snake, &logger);
+    FinalState recorded = recordGame(snake, GAME_ID_SNAKE, [&]() { bot.initGame(); }, [&](uint32_t cycle) { bot.loopCycle(); });
+    TEST_ASSERT_TRUE(recorded.ended);
+
+    Snake replayed(nullptr, &logger);
+    replayGame(replayed, [&]() { replayed.initGame(); }, recorded);
+    benchReplay();
+}
+
+// pong against the bot with held, timestamped inputs which are applied after PONG_INPUT_DELAY (some of them late)
+void test_pong_timestamped_inputs(void) {
+    Pong pong(nullptr, &logger);
+    FinalState recorded = recordGame(pong, GAME_ID_PONG, [&]() { pong.initGame(1); }, [&](uint32_t cycle) {
+        if (cycle % 7 == 0) {
+            const uint8_t keys[3] = {INPUT_KEY_UP, INPUT_KEY_DOWN, INPUT_KEY_NONE};
+            pong.queueInput(PLAYER_2, millis() - random(60), keys[random(3)]);
+        }
+    });
+    TEST_ASSERT_TRUE(recorded.ended);
+
+    Pong replayed(nullptr, &logger);
+    replayGame(replayed, [&]() { replayed.initGame(1); }, recorded);
+    benchReplay();
+}
+
+// breakout with random taps, presses and releases of a player
+void test_breakout_player_inputs(void) {
+    Breakout breakout(nullptr, &logger);
+    FinalState recorded = recordGame(breakout, GAME_ID_BREAKOUT, [&]() { breakout.initGame(false); }, [&](uint32_t cycle) {
+        switch (random(30)) {
+            case 0: breakout.ctrlLeft(); break;
+            case 1: breakout.ctrlRight(); break;
+            case 2: breakout.ctrlPress(INPUT_KEY_LEFT); break;
+            case 3: breakout.ctrlPress(INPUT_KEY_RIGHT); break;
+            case 4: breakout.ctrlRelease(INPUT_KEY_LEFT); break;
+            case 5: breakout.ctrlRelease(INPUT_KEY_RIGHT); break;
+            default: break;
+        }
+    });
+    TEST_ASSERT_TRUE(recorded.ended);
+
+    Breakout replayed(nullptr, &logger);
+    replayGame(replayed, [&]() { replayed.initGame(false); }, recorded);
+    benchReplay();
+}
+
+// the recording of a game which was stopped while running ends at the tick it was stopped
+void test_unfinished_game(void) {
+    Tetris tetris(nullptr, &logger);
+    TetrisBot bot(&tetris, &logger);
+    FinalState recorded = recordGame(tetris, GAME_ID_TETRIS, [&]() { bot.initGame(); }, [&](uint32_t cycle) { bot.loopCycle(); }, 3000);
+    TEST_ASSERT_FALSE(recorded.ended);
+
+    Tetris replayed(nullptr, &logger);
+    replayGame(replayed, [&]() { replayed.ctrlStart(); }, recorded);
+    benchReplay();
+}
+
+// files which are no recordings are not replayed
+void test_no_recording(void) {
+    File file = LittleFS.open(TEST_FILE, "w");
+    file.write((const uint8_t *)"GIF89a", 6);
+    file.close();
+    GameBench bench(&logger);
+    TEST_ASSERT_FALSE(bench.replay(TEST_FILE));
+    TEST_ASSERT_FALSE(bench.isRunning());
+    TEST_ASSERT_FALSE(bench.replay("/missing.rec"));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_tetris_bot);
+    RUN_TEST(test_snake_bot);
+    RUN_TEST(test_pong_timestamped_inputs);
+    RUN_TEST(test_breakout_player_inputs);
+    RUN_TEST(test_unfinished_game);
+    RUN_TEST(test_no_recording);
+    return UNITY_END();
+}
@@ -0,0 +1,544 @@
+/**
+ * @file test_gifdecoder.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Native tests of the streaming GifDecoder with small generated sample GIFs
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The samples are written by GifWriter below: a plain LZW encoder which can
+ * interlace the rows and defer the clear code when the code table is full.
+ * The expected canvas is composed at full resolution (disposal and
+ * transparency as in the GIF89a spec) and then sampled to the grid.
+ *
+ */
+#include <unity.h>
+#include <chrono>
+#include <map>
+#include <new>
+#include <vector>
+#include "gifdecoder.h"
+
+#define TEST_FILE "/test.gif"
+
+// ----------------------------------------------------------------------------------
+//                                  HEAP TRACKING
+// ----------------------------------------------------------------------------------
+
+static size_t heapCurrent = 0;
+static size_t heapPeak = 0;
+static size_t decodePeak = 0;    // max. heap allocated by one call of open() or decodeFrame()
+
+void startHeapTracking() {
+    heapPeak = heapCurrent;
+}
+
+void stopHeapTracking(size_t before) {
+    decodePeak = max(decodePeak, heapPeak - before);
+}
+
+void *operator new(size_t size) {
+    size_t *block = (size_t *)malloc(size + sizeof(size_t));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    block[0] = size;
+    heapCurrent += size;
+    heapPeak = max(heapPeak, heapCurrent);
+    return block + 1;
+}
+
+void operator delete(void *ptr) noexcept {
+    if (ptr != nullptr) {
+        size_t *block = (size_t *)ptr - 1;
+        heapCurrent -= block[0];
+        free(block);
+    }
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+// ----------------------------------------------------------------------------------
+//                                  SAMPLE WRITER
+// ----------------------------------------------------------------------------------
+
+struct GifFrame {
+    uint16_t left = 0, top = 0, width = 0, height = 0;
+    std::vector<uint8_t> indices;       // row-major (not interlaced)
+    bool interlaced = false;
+    uint8_t disposal = 0;
+    int16_t transparent = -1;
+    uint16_t delay = 10;                // in 1/100 s
+    std::vector<uint32_t> localColors;  // empty: global color table
+};
+
+class GifWriter {
+public:
+    GifWriter(uint16_t width, uint16_t height, const std::vector<uint32_t> &colors) : width(width), height(height), colors(colors) {
+        const char *header = "GIF89a";
+        data.insert(data.end(), header, header + 6);
+        pushUInt16(width);
+        pushUInt16(height);
+        data.push_back(0x80 | tableBits(colors.size()));
+        data.push_back(0);
+        data.push_back(0);
+        pushColors(colors);
+    }
+
+    void addFrame(const GifFrame &frame, bool deferredClear = false) {
+        data.push_back(0x21);
+        data.push_back(0xF9);
+        data.push_back(4);
+        data.push_back((frame.disposal << 2) | (frame.transparent >= 0 ? 1 : 0));
+        pushUInt16(frame.delay);
+        data.push_back(frame.transparent >= 0 ? frame.transparent : 0);
+        data.push_back(0);
+
+        data.push_back(0x2C);
+        pushUInt16(frame.left);
+        pushUInt16(frame.top);
+        pushUInt16(frame.width);
+        pushUInt16(frame.height);
+        size_t numColors = frame.localColors.empty() ? colors.size() : frame.localColors.size();
+        data.push_back((frame.localColors.empty() ? 0 : 0x80 | tableBits(numColors)) | (frame.interlaced ? 0x40 : 0));
+        pushColors(frame.localColors);
+
+        std::vector<uint8_t> ordered;
+        if (frame.interlaced) {
+            const uint8_t start[4] = {0, 4, 2, 1};
+            const uint8_t step[4] = {8, 8, 4, 2};
+            for (uint8_t pass = 0; pass < 4; pass++) {
+                for (uint16_t row = start[pass]; row < frame.height; row += step[pass]) {
+                    ordered.insert(ordered.end(), frame.indices.begin() + row * frame.width, frame.indices.begin() + (row + 1) * frame.width);
+                }
+            }
+        } else {
+            ordered = frame.indices;
+        }
+        uint8_t minCodeSize = max(2, (int)tableBits(numColors) + 1);
+        data.push_back(minCodeSize);
+        compress(ordered, minCodeSize, deferredClear);
+    }
+
+    std::vector<uint8_t> finish() {
+        data.push_back(0x3B);
+        return data;
+    }
+
+    uint16_t width, height;
+    std::vector<uint32_t> colors;
+    uint32_t kwkwkCodes = 0;        // codes which the decoder gets before it knows them
+    uint32_t deferredCodes = 0;     // codes written while the code table was full
+
+private:
+    static uint8_t tableBits(size_t size) {
+        uint8_t bits = 0;
+        while ((2u << bits) < size) {
+            bits++;
+        }
+        return bits;
+    }
+
+    void pushUInt16(uint16_t value) {
+        data.push_back(value & 0xFF);
+        data.push_back(value >> 8);
+    }
+
+    void pushColors(const std::vector<uint32_t> &table) {
+        if (table.empty()) {
+            return;
+        }
+        for (size_t i = 0; i < (2u << tableBits(table.size())); i++) {
+            uint32_t color = i < table.size() ? table[i] : 0;
+            data.push_back(color >> 16);
+            data.push_back(color >> 8);
+            data.push_back(color);
+        }
+    }
+
+    void writeCode(uint16_t code) {
+        bitBuffer |= (uint32_t)code << bitCount;
+        bitCount += codeSize;
+        while (bitCount >= 8) {
+            bytes.push_back(bitBuffer & 0xFF);
+            bitBuffer >>= 8;
+            bitCount -= 8;
+        }
+    }
+
+    void compress(const std::vector<uint8_t> &pixels, uint8_t minCodeSize, bool deferredClear) {
+        const uint16_t clearCode = 1 << minCodeSize;
+        std::map<std::pair<uint16_t, uint8_t>, uint16_t> table;
+        uint16_t nextCode = clearCode + 2;
+        int32_t lastAdded = -1;
+        uint16_t codesWhileFull = 0;
+        bytes.clear();
+        bitBuffer = 0;
+        bitCount = 0;
+        codeSize = minCodeSize + 1;
+        writeCode(clearCode);
+
+        int32_t prefix = -1;
+        for (uint8_t pixel : pixels) {
+            if (prefix < 0) {
+                prefix = pixel;
+                continue;
+            }
+            std::map<std::pair<uint16_t, uint8_t>, uint16_t>::iterator entry = table.find(std::make_pair((uint16_t)prefix, pixel));
+            if (entry != table.end()) {
+                prefix = entry->second;
+                continue;
+            }
+            writeCode(prefix);
+            if (prefix == lastAdded) {
+                kwkwkCodes++;
+            }
+            if (nextCode < GIFDECODER_MAX_CODES) {
+                if (nextCode == (1 << codeSize) && codeSize < 12) {
+                    codeSize++;
+                }
+                table[std::make_pair((uint16_t)prefix, pixel)] = nextCode;
+                lastAdded = nextCode++;
+            } else {
+                deferredCodes++;
+                codesWhileFull++;
+            }
+            if (nextCode == GIFDECODER_MAX_CODES && (!deferredClear || codesWhileFull >= 500)) {
+                writeCode(clearCode);
+                table.clear();
+                nextCode = clearCode + 2;
+                codeSize = minCodeSize + 1;
+                lastAdded = -1;
+                codesWhileFull = 0;
+            }
+            prefix = pixel;
+        }
+        if (prefix >= 0) {
+            writeCode(prefix);
+            if (prefix == lastAdded) {
+                kwkwkCodes++;
+            }
+            if (nextCode < GIFDECODER_MAX_CODES && nextCode == (1 << codeSize) && codeSize < 12) {
+                codeSize++;
+            }
+        }
+        writeCode(clearCode + 1);
+        if (bitCount > 0) {
+            bytes.push_back(bitBuffer & 0xFF);
+        }
+
+        for (size_t pos = 0; pos < bytes.size(); pos += 255) {
+            size_t size = min((size_t)255, bytes.size() - pos);
+            data.push_back(size);
+            data.insert(data.end(), bytes.begin() + pos, bytes.begin() + pos + size);
+        }
+        data.push_back(0);
+    }
+
+    std::vector<uint8_t> data;
+    std::vector<uint8_t> bytes;
+    uint32_t bitBuffer = 0;
+    uint8_t bitCount = 0;
+    uint8_t codeSize = 0;
+};
+
+// ----------------------------------------------------------------------------------
+//                                  EXPECTED CANVAS
+// ----------------------------------------------------------------------------------
+
+// composes the frames at full resolution like a GIF viewer
+class Composer {
+public:
+    Composer(const GifWriter &writer) : width(writer.width), height(writer.height), colors(writer.colors),
+                                        screen(writer.width * writer.height, 0) {}
+
+    void addFrame(const GifFrame &frame) {
+        if (lastDisposal == 2) {
+            for (uint16_t y = last.top; y < last.top + last.height && y < height; y++) {
+                for (uint16_t x = last.left; x < last.left + last.width && x < width; x++) {
+                    screen[y * width + x] = 0;
+                }
+            }
+        } else if (lastDisposal == 3) {
+            screen = saved;
+        }
+        saved = screen;
+        const std::vector<uint32_t> &table = frame.localColors.empty() ? colors : frame.localColors;
+        for (uint16_t y = 0; y < frame.height; y++) {
+            for (uint16_t x = 0; x < frame.width; x++) {
+                uint8_t index = frame.indices[y * frame.width + x];
+                if (index != frame.transparent && frame.top + y < height && frame.left + x < width) {
+                    screen[(frame.top + y) * width + frame.left + x] = table[index];
+                }
+            }
+        }
+        lastDisposal = frame.disposal;
+        last = frame;
+    }
+
+    // nearest neighbour sampling (center of each area) or centered, like the decoder
+    static int32_t sample(uint8_t i, uint8_t gridSize, uint16_t screenSize) {
+        if (screenSize >= gridSize) {
+            return (2 * i + 1) * screenSize / (2 * gridSize);
+        }
+        int32_t offset = (gridSize - screenSize) / 2;
+        return (i >= offset && i < offset + screenSize) ? i - offset : -1;
+    }
+
+    void check(GifDecoder &decoder, const char *what) {
+        for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+            for (uint8_t x = 0; x < GRID_WIDTH; x++) {
+                int32_t sx = sample(x, GRID_WIDTH, width);
+                int32_t sy = sample(y, GRID_HEIGHT, height);
+                uint32_t expected = (sx >= 0 && sy >= 0) ? screen[sy * width + sx] : 0;
+                if (decoder.canvas[y][x] != expected) {
+                    char message[120];
+                    snprintf(message, sizeof(message), "%s: pixel %d,%d expected 0x%06X was 0x%06X",
+                             what, x, y, (unsigned)expected, (unsigned)decoder.canvas[y][x]);
+                    TEST_FAIL_MESSAGE(message);
+                }
+            }
+        }
+    }
+
+private:
+    uint16_t width, height;
+    std::vector<uint32_t> colors;
+    std::vector<uint32_t> screen;
+    std::vector<uint32_t> saved;
+    uint8_t lastDisposal = 0;
+    GifFrame last;
+};
+
+// ----------------------------------------------------------------------------------
+//                                  HELPERS
+// ----------------------------------------------------------------------------------
+
+void writeFile(const std::vector<uint8_t> &data) {
+    File file = LittleFS.open(TEST_FILE, "w");
+    TEST_ASSERT_TRUE(file);
+    TEST_ASSERT_EQUAL(data.size(), file.write(data.data(), data.size()));
+    file.close();
+}
+
+std::vector<uint32_t> makeColors(uint16_t size) {
+    std::vector<uint32_t> colors;
+    for (uint16_t i = 0; i < size; i++) {
+        // never black, so the canvas shows which pixels have been written
+        colors.push_back(0x010101 + ((uint32_t)i * 0x3B1F07 & 0xFEFEFE));
+    }
+    return colors;
+}
+
+GifFrame makeFrame(uint16_t left, uint16_t top, uint16_t width, uint16_t height, uint16_t numColors) {
+    GifFrame frame;
+    frame.left = left;
+    frame.top = top;
+    frame.width = width;
+    frame.height = height;
+    for (uint32_t i = 0; i < (uint32_t)width * height; i++) {
+        frame.indices.push_back(random(numColors));
+    }
+    return frame;
+}
+
+/**
+ * @brief Decode all frames of the sample and compare every canvas with the composed frames
+ *
+ * @return unsigned long max. decode time of a frame in us
+ */
+unsigned long decodeAndCheck(GifWriter &writer, const std::vector<GifFrame> &frames, GifDecoder &decoder) {
+    writeFile(writer.finish());
+    Composer composer(writer);
+    size_t heapBefore = heapCurrent;
+    startHeapTracking();
+    TEST_ASSERT_TRUE(decoder.open(TEST_FILE));
+    stopHeapTracking(heapBefore);
+    unsigned long maxMicros = 0;
+    for (size_t i = 0; i < frames.size(); i++) {
+        composer.addFrame(frames[i]);
+        heapBefore = heapCurrent;
+        startHeapTracking();
+        auto start = std::chrono::steady_clock::now();
+        long delay = decoder.decodeFrame();
+        unsigned long micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        stopHeapTracking(heapBefore);
+        maxMicros = max(maxMicros, micros);
+        TEST_ASSERT_EQUAL(frames[i].delay * 10 >= 20 ? frames[i].delay * 10 : GIFDECODER_DEFAULT_DELAY, delay);
+        char what[20];
+        snprintf(what, sizeof(what), "frame %d", (int)i);
+        composer.check(decoder, what);
+    }
+    TEST_ASSERT_EQUAL(GIFDECODER_END, decoder.decodeFrame());
+    return maxMicros;
+}
+
+GifDecoder decoder;
+
+void setUp(void) {
+    randomSeed(11);
+    LittleFS.begin();
+}
+
+void tearDown(void) {
+    decoder.close();
+    LittleFS.remove(TEST_FILE);
+}
+
+// ----------------------------------------------------------------------------------
+//                                  TESTS
+// ----------------------------------------------------------------------------------
+
+// image of the grid size, every pixel is shown as is, also after rewind
+void test_plain_grid_size(void) {
+    GifWriter writer(GRID_WIDTH, GRID_HEIGHT, makeColors(16));
+    std::vector<GifFrame> frames = {makeFrame(0, 0, GRID_WIDTH, GRID_HEIGHT, 16), makeFrame(0, 0, GRID_WIDTH, GRID_HEIGHT, 16)};
+    frames[1].delay = 25;
+    for (const GifFrame &frame : frames) {
+        writer.addFrame(frame);
+    }
+    decodeAndCheck(writer, frames, decoder);
+
+    TEST_ASSERT_TRUE(decoder.rewind());
+    Composer composer(writer);
+    composer.addFrame(frames[0]);
+    TEST_ASSERT_EQUAL(GIFDECODER_DEFAULT_DELAY, decoder.decodeFrame());
+    composer.check(decoder, "after rewind");
+}
+
+// larger images are downsampled, smaller images centered
+void test_sampling(void) {
+    GifWriter large(3 * GRID_WIDTH + 2, 2 * GRID_HEIGHT + 5, makeColors(64));
+    std::vector<GifFrame> frames = {makeFrame(0, 0, 3 * GRID_WIDTH + 2, 2 * GRID_HEIGHT + 5, 64)};
+    large.addFrame(frames[0]);
+    decodeAndCheck(large, frames, decoder);
+
+    GifWriter small(5, 4, makeColors(4));
+    frames = {makeFrame(0, 0, 5, 4, 4)};
+    small.addFrame(frames[0]);
+    decodeAndCheck(small, frames, decoder);
+}
+
+// interlaced rows are put to the right place, also for heights which leave passes empty
+void test_interlaced(void) {
+    const uint16_t heights[4] = {GRID_HEIGHT, 3, 33, 1};
+    for (uint16_t height : heights) {
+        GifWriter writer(GRID_WIDTH, height, makeColors(8));
+        std::vector<GifFrame> frames = {makeFrame(0, 0, GRID_WIDTH, height, 8), makeFrame(2, height / 3, 5, height - height / 3, 8)};
+        frames[0].interlaced = true;
+        frames[1].interlaced = true;
+        writer.addFrame(frames[0]);
+        writer.addFrame(frames[1]);
+        decodeAndCheck(writer, frames, decoder);
+    }
+}
+
+// runs of one color produce codes which are used in the step they are defined (KwKwK)
+void test_lzw_kwkwk(void) {
+    GifWriter writer(GRID_WIDTH * 4, GRID_HEIGHT * 4, makeColors(2));
+    GifFrame frame = makeFrame(0, 0, GRID_WIDTH * 4, GRID_HEIGHT * 4, 2);
+    for (size_t i = 0; i < frame.indices.size(); i++) {
+        frame.indices[i] = (i / 37) % 2;
+    }
+    std::vector<GifFrame> frames = {frame};
+    writer.addFrame(frame);
+    TEST_ASSERT_GREATER_THAN(10, writer.kwkwkCodes);
+    decodeAndCheck(writer, frames, decoder);
+}
+
+// the code table is full (4096 codes): codes are used without new entries until the clear code comes
+void test_lzw_deferred_clear(void) {
+    GifWriter writer(128, 128, makeColors(256));
+    std::vector<GifFrame> frames = {makeFrame(0, 0, 128, 128, 256), makeFrame(0, 0, 128, 128, 256)};
+    writer.addFrame(frames[0], true);
+    TEST_ASSERT_GREATER_THAN(0, writer.deferredCodes);
+    // second frame: clear code as soon as the table is full
+    writer.addFrame(frames[1], false);
+
+    decodePeak = 0;
+    unsigned long maxMicros = decodeAndCheck(writer, frames, decoder);
+    char message[120];
+    snprintf(message, sizeof(message), "128x128 px, 256 colors: max %lu us per frame, peak heap %u bytes, decoder %u bytes (host)",
+             maxMicros, (unsigned)decodePeak, (unsigned)sizeof(GifDecoder));
+    TEST_MESSAGE(message);
+    // no allocations besides the file handle
+    TEST_ASSERT_LESS_THAN(256, decodePeak);
+}
+
+// disposal 2 clears the area of the previous frame, 3 restores the canvas before it
+void test_disposal(void) {
+    for (uint8_t disposal = 2; disposal <= 3; disposal++) {
+        GifWriter writer(GRID_WIDTH, GRID_HEIGHT, makeColors(8));
+        std::vector<GifFrame> frames = {makeFrame(0, 0, GRID_WIDTH, GRID_HEIGHT, 8),
+                                        makeFrame(3, 2, 4, 5, 8),
+                                        makeFrame(1, 1, 6, 6, 8),
+                                        makeFrame(0, 0, GRID_WIDTH, GRID_HEIGHT, 8)};
+        frames[1].disposal = disposal;
+        frames[1].localColors = makeColors(8);
+        frames[1].localColors[4] = 0xFF00FF;
+        // frames 2 and 3 are mostly transparent, the disposed canvas stays visible
+        for (uint8_t i = 2; i < 4; i++) {
+            frames[i].transparent = 7;
+            frames[i].disposal = (i == 2) ? disposal : 1;
+            for (size_t p = 0; p < frames[i].indices.size(); p++) {
+                if (p % 3 != 0) {
+                    frames[i].indices[p] = 7;
+                }
+            }
+        }
+        for (const GifFrame &frame : frames) {
+            writer.addFrame(frame);
+        }
+        decodeAndCheck(writer, frames, decoder);
+    }
+}
+
+// truncated files end the animation or report an error, but never read beyond the data
+void test_truncated(void) {
+    GifWriter writer(20, 15, makeColors(16));
+    std::vector<GifFrame> frames = {makeFrame(0, 0, 20, 15, 16), makeFrame(2, 2, 10, 10, 16)};
+    frames[0].interlaced = true;
+    for (const GifFrame &frame : frames) {
+        writer.addFrame(frame);
+    }
+    std::vector<uint8_t> data = writer.finish();
+
+    for (size_t length = 0; length < data.size(); length++) {
+        writeFile(std::vector<uint8_t>(data.begin(), data.begin() + length));
+        if (!decoder.open(TEST_FILE)) {
+            // not even the header and the global color table
+            TEST_ASSERT_LESS_THAN(13 + 3 * 16, length);
+            continue;
+        }
+        uint8_t numFrames = 0;
+        long result;
+        while ((result = decoder.decodeFrame()) >= 0) {
+            numFrames++;
+            TEST_ASSERT_LESS_OR_EQUAL(frames.size(), numFrames);
+        }
+        TEST_ASSERT_TRUE(result == GIFDECODER_END || result == GIFDECODER_ERROR);
+    }
+
+    // unknown block type
+    data.insert(data.end() - 1, 0x99);
+    writeFile(data);
+    TEST_ASSERT_TRUE(decoder.open(TEST_FILE));
+    TEST_ASSERT_GREATER_OR_EQUAL(0, decoder.decodeFrame());
+    TEST_ASSERT_GREATER_OR_EQUAL(0, decoder.decodeFrame());
+    TEST_ASSERT_EQUAL(GIFDECODER_ERROR, decoder.decodeFrame());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_plain_grid_size);
+    RUN_TEST(test_sampling);
+    RUN_TEST(test_interlaced);
+    RUN_TEST(test_lzw_kwkwk);
+    RUN_TEST(test_lzw_deferred_clear);
+    RUN_TEST(test_disposal);
+    RUN_TEST(test_truncated);
+    return UNITY_END();
+}
@@ -0,0 +1,144 @@
+/**
+ * @file test_inputqueue.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Native tests of the timestamped input queue and how Tetris and Snake consume it (with fake time)
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+#include "inputqueue.h"
+#include "tetris.h"
+#include "snake.h"
+
+Adafruit_NeoMatrix matrix(GRID_WIDTH + 1, GRID_HEIGHT, NEOPIXELPIN, NEOPIXEL_MATRIX_TYPE, NEOPIXEL_LED_TYPE);
+UDPLogger logger;
+LEDMatrix ledmatrix(&matrix, 40, &logger);
+
+void setUp(void) {
+    nativeUseFakeClock(true, 1000);
+    randomSeed(13);
+}
+
+void tearDown(void) {
+    nativeUseFakeClock(false);
+}
+
+/**
+ * @brief Run the game like the main loop for the given time (10 ms per cycle)
+ */
+void runFor(Game &game, unsigned long duration) {
+    for (unsigned long t = 0; t < duration; t += 10) {
+        nativeAdvanceMillis(10);
+        game.loopCycle();
+    }
+}
+
+int getBrickX(Tetris &tetris) {
+    uint8_t type, rotation;
+    int xpos, ypos;
+    TEST_ASSERT_TRUE(tetris.getActiveBrick(&type, &rotation, &xpos, &ypos));
+    return xpos;
+}
+
+// events keep their order and time, an event is only lost if the queue is full
+void test_queue_order_and_overflow(void) {
+    InputQueue queue;
+    for (uint8_t i = 0; i < INPUT_QUEUE_SIZE; i++) {
+        TEST_ASSERT_TRUE(queue.push(INPUT_KEY_UP + i % 4, INPUT_ACTION_TAP, i % 2));
+        nativeAdvanceMillis(1);
+    }
+    TEST_ASSERT_EQUAL(INPUT_QUEUE_SIZE, queue.size());
+    TEST_ASSERT_FALSE(queue.push(INPUT_KEY_START));
+    TEST_ASSERT_EQUAL(1, queue.getDropped());
+
+    InputEvent event;
+    for (uint8_t i = 0; i < INPUT_QUEUE_SIZE; i++) {
+        TEST_ASSERT_TRUE(queue.pop(event));
+        TEST_ASSERT_EQUAL(INPUT_KEY_UP + i % 4, event.key);
+        TEST_ASSERT_EQUAL(i % 2, event.player);
+        TEST_ASSERT_EQUAL(1000 + i, event.time);
+    }
+    TEST_ASSERT_FALSE(queue.pop(event));
+    TEST_ASSERT_EQUAL(0, queue.size());
+
+    // indices wrap around many times
+    for (uint16_t i = 0; i < 1000; i++) {
+        TEST_ASSERT_TRUE(queue.push(i % 7));
+        TEST_ASSERT_TRUE(queue.push((i + 1) % 7));
+        TEST_ASSERT_TRUE(queue.pop(event));
+        TEST_ASSERT_EQUAL(i % 7, event.key);
+        TEST_ASSERT_TRUE(queue.pop(event));
+        TEST_ASSERT_EQUAL((i + 1) % 7, event.key);
+    }
+    TEST_ASSERT_EQUAL(1, queue.getDropped());
+}
+
+// fast taps in the same millisecond are all applied in order, nothing is debounced
+void test_tetris_fast_taps(void) {
+    Tetris tetris(&ledmatrix, &logger);
+    tetris.ctrlStart();
+    runFor(tetris, 10);
+    int x = getBrickX(tetris);
+    // the spawn position leaves room for at least three shifts to each side
+    tetris.ctrlLeft();
+    tetris.ctrlLeft();
+    tetris.ctrlLeft();
+    tetris.ctrlRight();
+    runFor(tetris, 10);
+    TEST_ASSERT_EQUAL(x - 2, getBrickX(tetris));
+}
+
+// a held key shifts once, repeats after DAS_TIME every ARR_TIME and stops with the release
+void test_tetris_delayed_auto_shift(void) {
+    Tetris tetris(&ledmatrix, &logger);
+    tetris.ctrlStart();
+    runFor(tetris, 10);
+    int x = getBrickX(tetris);
+
+    tetris.ctrlPress(INPUT_KEY_RIGHT);
+    runFor(tetris, 10);
+    TEST_ASSERT_EQUAL(x + 1, getBrickX(tetris));
+    runFor(tetris, DAS_TIME - 20);
+    TEST_ASSERT_EQUAL(x + 1, getBrickX(tetris));
+    runFor(tetris, 10);
+    TEST_ASSERT_EQUAL(x + 2, getBrickX(tetris));
+    runFor(tetris, ARR_TIME);
+    TEST_ASSERT_EQUAL(x + 3, getBrickX(tetris));
+
+    tetris.ctrlRelease(INPUT_KEY_RIGHT);
+    runFor(tetris, 3 * ARR_TIME);
+    TEST_ASSERT_EQUAL(x + 3, getBrickX(tetris));
+}
+
+// two fast inputs result in two turns of the snake, inputs without a change of the direction are skipped
+void test_snake_fast_turns(void) {
+    Snake snake(&ledmatrix, &logger);
+    snake.initGame();
+    // move away from the border (DIRECTION_LEFT moves to higher x, the field is rotated)
+    for (uint8_t i = 0; i < 3; i++) {
+        snake.step();
+    }
+    TEST_ASSERT_EQUAL(DIRECTION_LEFT, snake.getDirection());
+
+    snake.ctrlRight();      // same direction, skipped
+    snake.ctrlDown();
+    snake.ctrlLeft();
+    snake.step();
+    TEST_ASSERT_EQUAL(DIRECTION_UP, snake.getDirection());
+    snake.step();
+    TEST_ASSERT_EQUAL(DIRECTION_RIGHT, snake.getDirection());
+    TEST_ASSERT_EQUAL(GAME_STATE_RUNNING, snake.getGameState());
+    TEST_ASSERT_EQUAL(1 * X_MAX + 2, snake.getBodyCell(0));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_queue_order_and_overflow);
+    RUN_TEST(test_tetris_fast_taps);
+    RUN_TEST(test_tetris_delayed_auto_shift);
+    RUN_TEST(test_snake_fast_turns);
+    return UNITY_END();
+}
@@ -0,0 +1,96 @@
+/**
+ * @file test_latencyhistogram.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Native tests of the latency histogram: bucket bounds, percentiles and the open last bucket
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+#include "latencyhistogram.h"
+
+#define LATENCY_TEST_LONG   (1UL << 30)     // longer than the last bucket
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// without latencies all values are 0
+void test_empty(void) {
+    LatencyHistogram histogram;
+    TEST_ASSERT_EQUAL(0, histogram.getCount());
+    TEST_ASSERT_EQUAL(0, histogram.getMax());
+    TEST_ASSERT_EQUAL(0, histogram.getPercentile(50));
+    TEST_ASSERT_EQUAL(0, histogram.getPercentile(100));
+    TEST_ASSERT_EQUAL_STRING("{\"count\":\"0\",\"p50\":\"0\",\"p99\":\"0\",\"max\":\"0\"}", histogram.getJSON().c_str());
+}
+
+// both ends of bucket n ([2^n, 2^(n+1)) us) are counted in it, its upper bound is 2^(n+1) - 1
+void test_bucket_bounds(void) {
+    LatencyHistogram histogram;
+    for (uint8_t n = 0; n < LATENCY_BUCKETS - 1; n++) {
+        unsigned long bounds[2] = {1UL << n, (2UL << n) - 1};
+        for (uint8_t i = 0; i < 2; i++) {
+            histogram.reset();
+            histogram.add(bounds[i]);
+            histogram.add(LATENCY_TEST_LONG);
+            // the median is the smaller latency, reported as the upper bound of its bucket
+            TEST_ASSERT_EQUAL((2UL << n) - 1, histogram.getPercentile(50));
+        }
+    }
+    // 0 us is counted in the first bucket
+    histogram.reset();
+    histogram.add(0);
+    histogram.add(LATENCY_TEST_LONG);
+    TEST_ASSERT_EQUAL(1, histogram.getPercentile(50));
+}
+
+// the rank of a percentile is rounded up, the result is never more than the longest latency
+void test_percentiles(void) {
+    LatencyHistogram histogram;
+    for (uint8_t i = 0; i < 98; i++) {
+        histogram.add(10);                          // bucket [8, 16)
+    }
+    histogram.add(300);                             // bucket [256, 512)
+    histogram.add(5000);                            // bucket [4096, 8192)
+    TEST_ASSERT_EQUAL(100, histogram.getCount());
+    TEST_ASSERT_EQUAL(5000, histogram.getMax());
+    TEST_ASSERT_EQUAL(15, histogram.getPercentile(1));
+    TEST_ASSERT_EQUAL(15, histogram.getPercentile(50));
+    TEST_ASSERT_EQUAL(15, histogram.getPercentile(98));
+    TEST_ASSERT_EQUAL(511, histogram.getPercentile(99));
+    TEST_ASSERT_EQUAL(5000, histogram.getPercentile(100));
+    TEST_ASSERT_EQUAL_STRING("{\"count\":\"100\",\"p50\":\"15\",\"p99\":\"511\",\"max\":\"5000\"}", histogram.getJSON().c_str());
+
+    // 101 latencies: the 99th percentile is the 100th latency
+    histogram.add(10);
+    TEST_ASSERT_EQUAL(511, histogram.getPercentile(99));
+
+    histogram.reset();
+    histogram.add(100);
+    TEST_ASSERT_EQUAL(1, histogram.getCount());
+    TEST_ASSERT_EQUAL(100, histogram.getPercentile(50));
+}
+
+// the last bucket has no upper bound, latencies in it are reported with the longest latency
+void test_last_bucket(void) {
+    LatencyHistogram histogram;
+    histogram.add(1UL << (LATENCY_BUCKETS - 1));
+    histogram.add(LATENCY_TEST_LONG);
+    TEST_ASSERT_EQUAL(LATENCY_TEST_LONG, histogram.getMax());
+    TEST_ASSERT_EQUAL(LATENCY_TEST_LONG, histogram.getPercentile(50));
+    TEST_ASSERT_EQUAL(LATENCY_TEST_LONG, histogram.getPercentile(100));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty);
+    RUN_TEST(test_bucket_bounds);
+    RUN_TEST(test_percentiles);
+    RUN_TEST(test_last_bucket);
+    return UNITY_END();
+}
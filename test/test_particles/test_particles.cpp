@@ -0,0 +1,161 @@
+/**
+ * @file test_particles.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Native tests of the particle pool (swap-remove, capacity) and the update costs of the effects
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+#include <chrono>
+#include "particles.h"
+
+// access to the pool of a Particles object (friend of Particles)
+class ParticlesTest {
+public:
+    static uint8_t count(Particles &particles) { return particles._numParticles; }
+    static uint8_t effect(Particles &particles) { return particles._effect; }
+    static void clear(Particles &particles) { particles._numParticles = 0; }
+    static void add(Particles &particles, int16_t x, int16_t y, int16_t vx, int16_t vy, uint8_t life, uint8_t type) {
+        Particles::Particle *p = particles.addParticle();
+        TEST_ASSERT_NOT_NULL(p);
+        p->x = x;
+        p->y = y;
+        p->vx = vx;
+        p->vy = vy;
+        p->color = 0xFFFFFF;
+        p->life = p->maxLife = life;
+        p->type = type;
+    }
+    static bool addFails(Particles &particles) { return particles.addParticle() == nullptr; }
+    static void update(Particles &particles) { particles.updateParticles(); }
+    static void setGravity(Particles &particles, int16_t gravity) { particles._gravity = gravity; }
+    static const Particles::Particle &particle(Particles &particles, uint8_t i) { return particles._pool[i]; }
+
+    // every particle in the pool is alive and on (or next to) the grid
+    static void checkPool(Particles &particles) {
+        TEST_ASSERT_LESS_OR_EQUAL(PARTICLES_MAX, particles._numParticles);
+        for (uint8_t i = 0; i < particles._numParticles; i++) {
+            const Particles::Particle &p = particles._pool[i];
+            TEST_ASSERT_GREATER_THAN(0, p.life);
+            TEST_ASSERT_LESS_OR_EQUAL((GRID_HEIGHT + 1) * PARTICLES_FP_ONE, p.y);
+            TEST_ASSERT_GREATER_OR_EQUAL(-PARTICLES_FP_ONE, p.x);
+            TEST_ASSERT_LESS_OR_EQUAL(GRID_WIDTH * PARTICLES_FP_ONE, p.x);
+        }
+    }
+};
+
+Adafruit_NeoMatrix matrix(GRID_WIDTH + 1, GRID_HEIGHT, NEOPIXELPIN, NEOPIXEL_MATRIX_TYPE, NEOPIXEL_LED_TYPE);
+UDPLogger logger;
+LEDMatrix ledmatrix(&matrix, 40, &logger);
+
+void setUp(void) {
+    nativeUseFakeClock(true);
+    randomSeed(42);
+}
+
+void tearDown(void) {
+    nativeUseFakeClock(false);
+}
+
+// the particles which die are replaced by the last ones, the survivors stay in the pool exactly once
+void test_swap_remove_keeps_survivors(void) {
+    Particles particles(&ledmatrix, &logger);
+    particles.initGame();
+    ParticlesTest::clear(particles);
+    ParticlesTest::setGravity(particles, 0);
+
+    // life 1 dies with the next update, the x position identifies the particle
+    const uint8_t lifes[10] = {1, 5, 1, 1, 5, 5, 1, 5, 1, 1};
+    for (uint8_t i = 0; i < 10; i++) {
+        ParticlesTest::add(particles, i * PARTICLES_FP_ONE, 0, 0, 0, lifes[i], PARTICLE_TYPE_DEFAULT);
+    }
+    ParticlesTest::update(particles);
+
+    TEST_ASSERT_EQUAL(4, ParticlesTest::count(particles));
+    bool seen[10] = {false};
+    for (uint8_t i = 0; i < ParticlesTest::count(particles); i++) {
+        uint8_t id = ParticlesTest::particle(particles, i).x / PARTICLES_FP_ONE;
+        TEST_ASSERT_EQUAL(5, lifes[id]);
+        TEST_ASSERT_FALSE(seen[id]);
+        seen[id] = true;
+        TEST_ASSERT_EQUAL(4, ParticlesTest::particle(particles, i).life);
+    }
+}
+
+// particles leaving the grid are removed, also the last one of the pool
+void test_swap_remove_out_of_grid(void) {
+    Particles particles(&ledmatrix, &logger);
+    particles.initGame();
+    ParticlesTest::clear(particles);
+    ParticlesTest::setGravity(particles, 0);
+
+    ParticlesTest::add(particles, PARTICLES_FP_ONE, GRID_HEIGHT * PARTICLES_FP_ONE, 0, 2 * PARTICLES_FP_ONE, 100, PARTICLE_TYPE_DEFAULT);
+    ParticlesTest::add(particles, 0, 0, -2 * PARTICLES_FP_ONE, 0, 100, PARTICLE_TYPE_DEFAULT);
+    ParticlesTest::add(particles, 3 * PARTICLES_FP_ONE, 0, 0, 0, 100, PARTICLE_TYPE_DEFAULT);
+    ParticlesTest::add(particles, GRID_WIDTH * PARTICLES_FP_ONE, 0, PARTICLES_FP_ONE, 0, 100, PARTICLE_TYPE_DEFAULT);
+    ParticlesTest::update(particles);
+
+    TEST_ASSERT_EQUAL(1, ParticlesTest::count(particles));
+    TEST_ASSERT_EQUAL(3 * PARTICLES_FP_ONE, ParticlesTest::particle(particles, 0).x);
+}
+
+// the pool never grows beyond its capacity, a burst in a full pool is cut
+void test_pool_capacity(void) {
+    Particles particles(&ledmatrix, &logger);
+    particles.initGame();
+    ParticlesTest::clear(particles);
+    ParticlesTest::setGravity(particles, 0);
+
+    for (uint8_t i = 0; i < PARTICLES_MAX - 1; i++) {
+        ParticlesTest::add(particles, PARTICLES_FP_ONE, PARTICLES_FP_ONE, 0, 0, 200, PARTICLE_TYPE_DEFAULT);
+    }
+    // rocket at its highest point explodes with the next update (12 particles)
+    ParticlesTest::add(particles, 5 * PARTICLES_FP_ONE, 3 * PARTICLES_FP_ONE, 0, 0, 200, PARTICLE_TYPE_ROCKET);
+    TEST_ASSERT_TRUE(ParticlesTest::addFails(particles));
+
+    ParticlesTest::update(particles);
+    TEST_ASSERT_EQUAL(PARTICLES_MAX, ParticlesTest::count(particles));
+    for (uint8_t i = 0; i < PARTICLES_MAX; i++) {
+        TEST_ASSERT_NOT_EQUAL(PARTICLE_TYPE_ROCKET, ParticlesTest::particle(particles, i).type);
+    }
+    ParticlesTest::checkPool(particles);
+}
+
+// all effects keep the pool valid over a long run, the update costs are reported
+void test_effects_long_run(void) {
+    Particles particles(&ledmatrix, &logger);
+    for (uint8_t effect = 0; effect < PARTICLE_NUM_EFFECTS; effect++) {
+        particles.initGame();
+        uint8_t peak = 0;
+        unsigned long maxMicros = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (uint16_t tick = 0; tick < 450; tick++) {
+            // 450 ticks at 30 fps = 15 s, the effect does not change
+            nativeAdvanceMillis(33);
+            auto tickStart = std::chrono::steady_clock::now();
+            particles.loopCycle();
+            unsigned long tickMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - tickStart).count();
+            maxMicros = max(maxMicros, tickMicros);
+            ParticlesTest::checkPool(particles);
+            peak = max(peak, ParticlesTest::count(particles));
+        }
+        unsigned long totalMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        TEST_ASSERT_GREATER_THAN(0, peak);
+        char message[100];
+        snprintf(message, sizeof(message), "effect %d: peak %d particles, avg %lu us, max %lu us per tick (host)",
+                 ParticlesTest::effect(particles), peak, totalMicros / 450, maxMicros);
+        TEST_MESSAGE(message);
+    }
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_swap_remove_keeps_survivors);
+    RUN_TEST(test_swap_remove_out_of_grid);
+    RUN_TEST(test_pool_capacity);
+    RUN_TEST(test_effects_long_run);
+    return UNITY_END();
+}
@@ -0,0 +1,157 @@
+/**
+ * @file test_pong.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Native tests of the fixed-timestep simulation of Pong: the game does not depend on the call pattern of loopCycle()
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+#include "pong.h"
+
+#define PONG_TEST_SEED      42
+#define PONG_TEST_MAX_TIME  600000  // in ms, limit of a bot game
+
+Adafruit_NeoMatrix matrix(GRID_WIDTH + 1, GRID_HEIGHT, NEOPIXELPIN, NEOPIXEL_MATRIX_TYPE, NEOPIXEL_LED_TYPE);
+UDPLogger logger;
+LEDMatrix ledmatrix(&matrix, 40, &logger);
+
+uint32_t endTick = 0;
+
+// result of a bot game
+struct GameResult {
+    uint32_t ticks;
+    uint32_t hits;
+    uint32_t grid[GRID_HEIGHT][GRID_WIDTH];
+};
+
+void storeEndTick(Game *game, uint8_t event) {
+    if (event == GAME_EVENT_END) {
+        endTick = game->getTicks();
+    }
+}
+
+void setUp(void) {
+    nativeUseFakeClock(true, 1000);
+}
+
+void tearDown(void) {
+    nativeUseFakeClock(false);
+}
+
+/**
+ * @brief Play a game of two bots with the given time between the calls of loopCycle()
+ *
+ * @param nextDelay returns the time until the next call (in ms)
+ */
+GameResult playGame(uint32_t (*nextDelay)(uint32_t call)) {
+    randomSeed(PONG_TEST_SEED);
+    Pong pong(&ledmatrix, &logger);
+    pong.setEventHook(storeEndTick);
+    pong.initGame(2);
+    endTick = 0;
+    uint32_t call = 0;
+    unsigned long start = millis();
+    while (pong.getGameState() == GAME_STATE_RUNNING && millis() - start < PONG_TEST_MAX_TIME) {
+        nativeAdvanceMillis(nextDelay(call++));
+        pong.loopCycle();
+    }
+    // the frame with the final state is drawn with the last call, ticks after the end are not counted
+    GameResult result;
+    result.ticks = endTick;
+    result.hits = pong.getScore();
+    memcpy(result.grid, ledmatrix.targetgrid, sizeof(result.grid));
+    return result;
+}
+
+uint32_t regularDelay(uint32_t call) {
+    return PONG_TICK_TIME;
+}
+
+uint32_t irregularDelay(uint32_t call) {
+    return 1 + (call * 7919) % 23;
+}
+
+uint32_t stallingDelay(uint32_t call) {
+    return (call % 20 == 19) ? 150 : 3;
+}
+
+// bot games give the same result whether loopCycle() is called every tick, irregularly or with long stalls
+void test_independent_of_call_pattern(void) {
+    GameResult regular = playGame(regularDelay);
+    GameResult irregular = playGame(irregularDelay);
+    GameResult stalling = playGame(stallingDelay);
+
+    char message[80];
+    snprintf(message, sizeof(message), "game of %u ticks, %u paddle hits", (unsigned)regular.ticks, (unsigned)regular.hits);
+    TEST_MESSAGE(message);
+    // the game has to end and last some rallies to be meaningful
+    TEST_ASSERT_NOT_EQUAL(0, regular.ticks);
+    TEST_ASSERT_GREATER_THAN(5, regular.hits);
+
+    TEST_ASSERT_EQUAL(regular.ticks, irregular.ticks);
+    TEST_ASSERT_EQUAL(regular.hits, irregular.hits);
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(&regular.grid[0][0], &irregular.grid[0][0], GRID_WIDTH * GRID_HEIGHT);
+    TEST_ASSERT_EQUAL(regular.ticks, stalling.ticks);
+    TEST_ASSERT_EQUAL(regular.hits, stalling.hits);
+    TEST_ASSERT_EQUAL_HEX32_ARRAY(&regular.grid[0][0], &stalling.grid[0][0], GRID_WIDTH * GRID_HEIGHT);
+}
+
+// after a stall longer than GAME_MAX_CATCHUP the missed time is dropped instead of simulated
+void test_catchup_is_limited(void) {
+    randomSeed(PONG_TEST_SEED);
+    Pong pong(&ledmatrix, &logger);
+    pong.initGame(2);
+    nativeAdvanceMillis(10 * PONG_TICK_TIME);
+    pong.loopCycle();
+    TEST_ASSERT_EQUAL(10, pong.getTicks());
+
+    nativeAdvanceMillis(1000);
+    pong.loopCycle();
+    TEST_ASSERT_EQUAL(10 + 1, pong.getTicks());
+
+    // continues at the normal rate
+    nativeAdvanceMillis(5 * PONG_TICK_TIME);
+    pong.loopCycle();
+    TEST_ASSERT_EQUAL(10 + 1 + 5, pong.getTicks());
+}
+
+// the input latency ends when the frame is shown, rendering the frame (again) does not change it
+void test_latency_ends_with_shown_frame(void) {
+    randomSeed(PONG_TEST_SEED);
+    Pong pong(&ledmatrix, &logger);
+    pong.initGame(1);
+    nativeAdvanceMillis(PONG_TICK_TIME);
+    pong.loopCycle();
+    pong.frameShown();
+
+    pong.queueInput(PLAYER_2, millis(), INPUT_KEY_UP);
+    // applied after PONG_INPUT_DELAY, the paddle moves with the same tick
+    for (uint8_t i = 0; i < PONG_INPUT_DELAY / PONG_TICK_TIME + 2; i++) {
+        nativeAdvanceMillis(PONG_TICK_TIME);
+        pong.loopCycle();
+        pong.render(ledmatrix);
+        TEST_ASSERT_EQUAL(0, pong.getMaxInputLatency(PLAYER_2));
+    }
+    nativeAdvanceMillis(5);
+    pong.frameShown();
+    TEST_ASSERT_EQUAL(PONG_INPUT_DELAY + 2 * PONG_TICK_TIME + 5, pong.getMaxInputLatency(PLAYER_2));
+    TEST_ASSERT_EQUAL(pong.getMaxInputLatency(PLAYER_2), pong.getAvgInputLatency(PLAYER_2));
+
+    // measured only once
+    nativeAdvanceMillis(PONG_TICK_TIME);
+    pong.loopCycle();
+    pong.frameShown();
+    TEST_ASSERT_EQUAL(PONG_INPUT_DELAY + 2 * PONG_TICK_TIME + 5, pong.getMaxInputLatency(PLAYER_2));
+    TEST_ASSERT_EQUAL(0, pong.getLateInputs(PLAYER_2));
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_independent_of_call_pattern);
+    RUN_TEST(test_catchup_is_limited);
+    RUN_TEST(test_latency_ends_with_shown_frame);
+    return UNITY_END();
+}
@@ -0,0 +1,138 @@
+/**
+ * @file test_snake.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Native tests of the incremental rendering of Snake
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+#include "snake.h"
+
+// framebuffer which keeps the pixels and counts the drawing calls
+class TestFramebuffer : public Framebuffer {
+public:
+    void gridAddPixel(uint8_t x, uint8_t y, uint32_t color) override {
+        grid[y][x] = color;
+        pixelWrites++;
+    }
+    void gridBlendPixel(uint8_t x, uint8_t y, uint32_t color, uint16_t weight) override {
+        gridAddPixel(x, y, color);
+    }
+    void gridFlush(void) override {
+        memset(grid, 0, sizeof(grid));
+        flushes++;
+    }
+    uint32_t grid[GRID_HEIGHT][GRID_WIDTH] = {{0}};
+    uint32_t pixelWrites = 0;
+    uint32_t flushes = 0;
+};
+
+// complete drawing of a Snake object (friend of Snake)
+class SnakeTest {
+public:
+    static void drawAll(Snake &snake, Framebuffer &framebuffer) { snake.drawAll(framebuffer); }
+};
+
+UDPLogger logger;
+
+void setUp(void) {
+    nativeUseFakeClock(true, 1000);
+    randomSeed(9);
+}
+
+void tearDown(void) {
+    nativeUseFakeClock(false);
+}
+
+void checkFrame(Snake &snake, TestFramebuffer &incremental, uint32_t frame) {
+    TestFramebuffer full;
+    SnakeTest::drawAll(snake, full);
+    char message[40];
+    snprintf(message, sizeof(message), "frame %u", (unsigned)frame);
+    TEST_ASSERT_EQUAL_HEX32_ARRAY_MESSAGE(&full.grid[0][0], &incremental.grid[0][0], GRID_WIDTH * GRID_HEIGHT, message);
+}
+
+// random games, rendered after one to three steps: every frame equals the complete drawing,
+// only the first frame of a game flushes the framebuffer
+void test_incremental_equals_full(void) {
+    Snake snake(nullptr, &logger);
+    TestFramebuffer framebuffer;
+    uint32_t frames = 0;
+    uint32_t games = 0;
+    uint32_t maxWrites = 0;
+    snake.initGame();
+    snake.render(framebuffer);
+    while (games < 50) {
+        uint8_t steps = 1 + random(3);
+        for (uint8_t i = 0; i < steps; i++) {
+            switch (random(6)) {
+                case 0: snake.ctrlUp(); break;
+                case 1: snake.ctrlDown(); break;
+                case 2: snake.ctrlLeft(); break;
+                case 3: snake.ctrlRight(); break;
+                default: break;
+            }
+            snake.step();
+        }
+        uint32_t flushes = framebuffer.flushes;
+        uint32_t writes = framebuffer.pixelWrites;
+        snake.render(framebuffer);
+        checkFrame(snake, framebuffer, frames);
+        if (framebuffer.flushes == flushes) {
+            maxWrites = max(maxWrites, framebuffer.pixelWrites - writes);
+        }
+        frames++;
+        if (snake.getGameState() == GAME_STATE_END) {
+            games++;
+            snake.initGame();
+            snake.render(framebuffer);
+            checkFrame(snake, framebuffer, frames);
+            frames++;
+        }
+    }
+    TEST_ASSERT_EQUAL(games + 1, framebuffer.flushes);
+    // at most 3 steps: 3 head cells, 3 tail cells, old and new food, blood
+    TEST_ASSERT_LESS_OR_EQUAL(9, maxWrites);
+}
+
+// another framebuffer gets the complete frame
+void test_new_framebuffer_gets_full_frame(void) {
+    Snake snake(nullptr, &logger);
+    TestFramebuffer first, second;
+    snake.initGame();
+    for (uint8_t i = 0; i < 5; i++) {
+        snake.step();
+        snake.render(first);
+    }
+    snake.step();
+    snake.render(second);
+    TEST_ASSERT_EQUAL(1, second.flushes);
+    checkFrame(snake, second, 0);
+}
+
+// the grid is flushed by others (night mode, pictures of /leddirect or DDP): redraw() restores the complete frame
+void test_redraw_after_flush(void) {
+    Snake snake(nullptr, &logger);
+    TestFramebuffer framebuffer;
+    snake.initGame();
+    for (uint8_t i = 0; i < 5; i++) {
+        snake.step();
+        snake.render(framebuffer);
+    }
+    framebuffer.gridFlush();
+    snake.step();
+    snake.redraw();
+    snake.render(framebuffer);
+    checkFrame(snake, framebuffer, 0);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_incremental_equals_full);
+    RUN_TEST(test_new_framebuffer_gets_full_frame);
+    RUN_TEST(test_redraw_after_flush);
+    return UNITY_END();
+}
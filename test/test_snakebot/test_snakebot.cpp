@@ -0,0 +1,202 @@
+/**
+ * @file test_snakebot.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Native tests of the snake autopilot: path search and tail reachability on crafted boards, inputs per step
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+#include <chrono>
+#include "snakebot.h"
+
+#define CELL(x, y) ((y) * X_MAX + (x))
+
+// access to the body, food and inputs of a Snake object (friend of Snake)
+class SnakeTest {
+public:
+    // replace the snake by the given cells (head first), the snake is not growing
+    static void setSnake(Snake &snake, const uint8_t *cells, uint8_t length, uint8_t food) {
+        memset(snake._occupied, 0, sizeof(snake._occupied));
+        snake._headIndex = length - 1;
+        snake._length = length;
+        snake._growth = 0;
+        for (uint8_t i = 0; i < length; i++) {
+            snake._body[length - 1 - i] = cells[i];
+            snake.setOccupied(cells[i], true);
+        }
+        snake._food = food;
+    }
+    static uint8_t queuedInputs(Snake &snake) { return snake._inputs.size(); }
+    static uint16_t droppedInputs(Snake &snake) { return snake._inputs.getDropped(); }
+};
+
+// access to the searches of a SnakeBot object (friend of SnakeBot)
+class SnakeBotTest {
+public:
+    static uint8_t findPath(SnakeBot &bot, uint8_t start, uint8_t target, const uint32_t *blocked, uint8_t *path) {
+        return bot.findPath(start, target, blocked, path);
+    }
+    static bool isTailReachableAfter(SnakeBot &bot, const uint8_t *path, uint8_t pathLength) {
+        bot.loadSnake();
+        return bot.isTailReachableAfter(path, pathLength);
+    }
+    static uint8_t chooseNextCell(SnakeBot &bot) { return bot.chooseNextCell(); }
+};
+
+Adafruit_NeoMatrix matrix(GRID_WIDTH + 1, GRID_HEIGHT, NEOPIXELPIN, NEOPIXEL_MATRIX_TYPE, NEOPIXEL_LED_TYPE);
+UDPLogger logger;
+LEDMatrix ledmatrix(&matrix, 40, &logger);
+
+void setUp(void) {
+    nativeUseFakeClock(true, 1000);
+    randomSeed(11);
+}
+
+void tearDown(void) {
+    nativeUseFakeClock(false);
+}
+
+bool isNeighbour(uint8_t a, uint8_t b) {
+    return abs(a % X_MAX - b % X_MAX) + abs(a / X_MAX - b / X_MAX) == 1;
+}
+
+// the shortest way around a wall is found, a walled in target is not reachable
+void test_find_path_around_wall(void) {
+    Snake snake(&ledmatrix, &logger);
+    SnakeBot bot(&snake, &logger);
+    uint32_t blocked[OCCUPANCY_WORDS] = {0};
+    // wall in column 5 from the top to the second last row
+    for (uint8_t y = 0; y < Y_MAX - 1; y++) {
+        blocked[CELL(5, y) / 32] |= 1UL << (CELL(5, y) % 32);
+    }
+    uint8_t path[MAX_TAIL_LENGTH];
+    uint8_t length = SnakeBotTest::findPath(bot, CELL(0, 0), CELL(10, 0), blocked, path);
+    // down to the last row, along it and up again
+    TEST_ASSERT_EQUAL(2 * (Y_MAX - 1) + X_MAX - 1, length);
+    TEST_ASSERT_EQUAL(CELL(10, 0), path[length - 1]);
+    TEST_ASSERT_TRUE(isNeighbour(CELL(0, 0), path[0]));
+    for (uint8_t i = 0; i < length; i++) {
+        TEST_ASSERT_FALSE((blocked[path[i] / 32] >> (path[i] % 32)) & 1);
+        if (i > 0) {
+            TEST_ASSERT_TRUE(isNeighbour(path[i - 1], path[i]));
+        }
+    }
+
+    // close the gap in the last row
+    blocked[CELL(5, Y_MAX - 1) / 32] |= 1UL << (CELL(5, Y_MAX - 1) % 32);
+    TEST_ASSERT_EQUAL(0, SnakeBotTest::findPath(bot, CELL(0, 0), CELL(10, 0), blocked, path));
+}
+
+// food in a dead end of the corner: the long snake would be trapped after eating, the bot does not go there
+void test_no_food_in_dead_end(void) {
+    Snake snake(&ledmatrix, &logger);
+    SnakeBot bot(&snake, &logger);
+    snake.initGame();
+    const uint8_t body[] = {CELL(1, 2), CELL(1, 1), CELL(1, 0), CELL(2, 0), CELL(3, 0), CELL(4, 0), CELL(5, 0), CELL(6, 0)};
+    SnakeTest::setSnake(snake, body, sizeof(body), CELL(0, 0));
+
+    uint8_t path[MAX_TAIL_LENGTH];
+    uint32_t blocked[OCCUPANCY_WORDS] = {0};
+    for (uint8_t i = 0; i < sizeof(body); i++) {
+        blocked[body[i] / 32] |= 1UL << (body[i] % 32);
+    }
+    uint8_t length = SnakeBotTest::findPath(bot, CELL(1, 2), CELL(0, 0), blocked, path);
+    const uint8_t expected[] = {CELL(0, 2), CELL(0, 1), CELL(0, 0)};
+    TEST_ASSERT_EQUAL(3, length);
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, path, 3);
+
+    // head in the corner, neighbours are the neck and the body which has not moved away
+    TEST_ASSERT_FALSE(SnakeBotTest::isTailReachableAfter(bot, path, length));
+    uint8_t next = SnakeBotTest::chooseNextCell(bot);
+    TEST_ASSERT_NOT_EQUAL(CELL(0, 2), next);
+    TEST_ASSERT_TRUE(isNeighbour(CELL(1, 2), next));
+    TEST_ASSERT_FALSE(snake.isOccupied(next));
+}
+
+// same dead end with a short snake: the body moves away, the tail stays reachable and the food is taken
+void test_food_in_dead_end_short_snake(void) {
+    Snake snake(&ledmatrix, &logger);
+    SnakeBot bot(&snake, &logger);
+    snake.initGame();
+    const uint8_t body[] = {CELL(1, 2), CELL(1, 1), CELL(1, 0)};
+    SnakeTest::setSnake(snake, body, sizeof(body), CELL(0, 0));
+
+    const uint8_t path[] = {CELL(0, 2), CELL(0, 1), CELL(0, 0)};
+    TEST_ASSERT_TRUE(SnakeBotTest::isTailReachableAfter(bot, path, 3));
+    TEST_ASSERT_EQUAL(CELL(0, 2), SnakeBotTest::chooseNextCell(bot));
+}
+
+// the bot queues at most one input per step of the snake, even if it runs many cycles per step
+void test_one_input_per_step(void) {
+    Snake snake(&ledmatrix, &logger);
+    SnakeBot bot(&snake, &logger);
+    bot.initGame();
+    uint16_t maxQueued = 0;
+    uint32_t steps = 0;
+    uint8_t lastHead = snake.getBodyCell(0);
+    // 10 ms per cycle like the main loop, 40 cycles per step
+    for (uint32_t cycle = 0; cycle < 40 * 200 && snake.getGameState() == GAME_STATE_RUNNING; cycle++) {
+        nativeAdvanceMillis(10);
+        snake.loopCycle();
+        bot.loopCycle();
+        maxQueued = max(maxQueued, (uint16_t)SnakeTest::queuedInputs(snake));
+        if (snake.getBodyCell(0) != lastHead) {
+            lastHead = snake.getBodyCell(0);
+            steps++;
+        }
+    }
+    TEST_ASSERT_EQUAL(GAME_STATE_RUNNING, snake.getGameState());
+    TEST_ASSERT_GREATER_THAN(150, steps);
+    TEST_ASSERT_LESS_OR_EQUAL(1, maxQueued);
+    TEST_ASSERT_EQUAL(0, SnakeTest::droppedInputs(snake));
+}
+
+// the bot plays one game for each of five fixed seeds, it does not crash early and fills at least a third of the field,
+// reports the average game length and the planning time per step on the host
+void test_games_fixed_seeds(void) {
+    uint32_t totalLength = 0;
+    uint32_t totalSteps = 0;
+    uint64_t totalNanos = 0;
+    uint64_t maxNanos = 0;
+    for (unsigned long seed = 1; seed <= 5; seed++) {
+        randomSeed(seed);
+        Snake snake(&ledmatrix, &logger);
+        SnakeBot bot(&snake, &logger);
+        bot.initGame();
+        uint32_t steps = 0;
+        while (snake.getGameState() == GAME_STATE_RUNNING && steps < 20000) {
+            // the decision only depends on the snake, time it here since micros() is the fake clock in the tests
+            auto start = std::chrono::steady_clock::now();
+            SnakeBotTest::chooseNextCell(bot);
+            uint64_t nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            totalNanos += nanos;
+            maxNanos = max(maxNanos, nanos);
+            bot.loopCycle();
+            snake.step();
+            steps++;
+        }
+        totalLength += snake.getLength();
+        totalSteps += steps;
+        char message[80];
+        snprintf(message, sizeof(message), "seed %lu: length %u after %u steps", seed, (unsigned)snake.getLength(), (unsigned)steps);
+        TEST_MESSAGE(message);
+        TEST_ASSERT_GREATER_OR_EQUAL_MESSAGE(MAX_TAIL_LENGTH / 3, snake.getLength(), message);
+    }
+    char message[120];
+    snprintf(message, sizeof(message), "average length %.1f of %u after %.0f steps, %.2f us per step avg, %.2f us max (host)",
+             totalLength / 5.0, (unsigned)MAX_TAIL_LENGTH, totalSteps / 5.0, totalNanos / 1000.0 / totalSteps, maxNanos / 1000.0);
+    TEST_MESSAGE(message);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_find_path_around_wall);
+    RUN_TEST(test_no_food_in_dead_end);
+    RUN_TEST(test_food_in_dead_end_short_snake);
+    RUN_TEST(test_one_input_per_step);
+    RUN_TEST(test_games_fixed_seeds);
+    return UNITY_END();
+}
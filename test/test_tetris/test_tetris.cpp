@@ -0,0 +1,149 @@
+/**
+ * @file test_tetris.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Native tests of the non-blocking line clear of Tetris
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+#include <chrono>
+#include "tetris.h"
+
+#define TETRIS_MAX_UPDATE_MICROS    200     // bound of a single update() on the host
+
+// access to the field and the active brick of a Tetris object (friend of Tetris)
+class TetrisTest {
+public:
+    // rows from firstRow to the bottom are full except the given column
+    static void fillRows(Tetris &tetris, uint8_t firstRow, uint8_t gapColumn) {
+        for (uint8_t y = firstRow; y < GRID_HEIGHT; y++) {
+            tetris._field.rows[y] = FIELD_FULL & ~(1 << (gapColumn + FIELD_OFFSET));
+            for (uint8_t x = 0; x < GRID_WIDTH; x++) {
+                tetris._field.color[y][x] = (x == gapColumn) ? 0 : 1 + (x + y) % 7;
+            }
+        }
+    }
+    // vertical I brick above the given column
+    static void setVerticalI(Tetris &tetris, uint8_t column) {
+        tetris._activeBrick.enabled = true;
+        tetris._activeBrick.type = 1;
+        tetris._activeBrick.rotation = 1;
+        tetris._activeBrick.siz = 4;
+        tetris._activeBrick.col = GREEN;
+        tetris._activeBrick.xpos = column - 2;   // vertical I is in column 2 of the brick
+        tetris._activeBrick.ypos = 0;
+        memcpy(tetris._activeBrick.rows, Tetris::getBrickRows(1, 1), MAX_BRICK_SIZE);
+    }
+    static bool clearing(Tetris &tetris) { return tetris._clearing; }
+    static uint16_t clearingRows(Tetris &tetris) { return tetris._clearingRows; }
+};
+
+Adafruit_NeoMatrix matrix(GRID_WIDTH + 1, GRID_HEIGHT, NEOPIXELPIN, NEOPIXEL_MATRIX_TYPE, NEOPIXEL_LED_TYPE);
+UDPLogger logger;
+LEDMatrix ledmatrix(&matrix, 40, &logger);
+
+void setUp(void) {
+    nativeUseFakeClock(true, 1000);
+    randomSeed(3);
+}
+
+void tearDown(void) {
+    nativeUseFakeClock(false);
+}
+
+/**
+ * @brief Start a game and run its first tick
+ */
+void startGame(Tetris &tetris) {
+    tetris.ctrlStart();
+    tetris.step();
+    TEST_ASSERT_EQUAL(GAME_STATE_RUNNING, tetris.getGameState());
+}
+
+// a vertical I brick completes four lines: the clear is spread over many ticks, no tick takes long
+void test_four_line_clear_is_spread(void) {
+    Tetris tetris(&ledmatrix, &logger);
+    startGame(tetris);
+    TetrisTest::fillRows(tetris, GRID_HEIGHT - 4, 0);
+    TetrisTest::setVerticalI(tetris, 0);
+    tetris.ctrlDown();
+
+    unsigned long maxMicros = 0;
+    uint32_t clearStartTick = 0;
+    uint32_t clearEndTick = 0;
+    unsigned long brickCount = tetris.getBrickCount();
+    for (uint16_t tick = 0; tick < 2000 && clearEndTick == 0; tick++) {
+        auto start = std::chrono::steady_clock::now();
+        tetris.step();
+        unsigned long micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+        maxMicros = max(maxMicros, micros);
+        // render every tick like the display path, it must not depend on the clear state
+        tetris.render(ledmatrix);
+
+        if (clearStartTick == 0 && TetrisTest::clearing(tetris)) {
+            clearStartTick = tetris.getTicks();
+            TEST_ASSERT_EQUAL_HEX16(0xF << (GRID_HEIGHT - 4), TetrisTest::clearingRows(tetris));
+            // no new brick during the animation
+            TEST_ASSERT_EQUAL(brickCount, tetris.getBrickCount());
+        }
+        if (clearStartTick != 0 && !TetrisTest::clearing(tetris)) {
+            clearEndTick = tetris.getTicks();
+        }
+    }
+    TEST_ASSERT_NOT_EQUAL(0, clearStartTick);
+    TEST_ASSERT_NOT_EQUAL(0, clearEndTick);
+
+    // one column per CLEAR_STEP_TIME, then the rows are removed
+    uint32_t expectedTicks = (GRID_WIDTH + 1) * CLEAR_STEP_TIME / TETRIS_TICK_TIME;
+    TEST_ASSERT_UINT32_WITHIN(CLEAR_STEP_TIME / TETRIS_TICK_TIME, expectedTicks, clearEndTick - clearStartTick);
+
+    TEST_ASSERT_EQUAL(4, tetris.getScore());
+    TEST_ASSERT_EQUAL(1, tetris.getLevel());
+    TEST_ASSERT_EQUAL(brickCount + 1, tetris.getBrickCount());
+    const uint16_t *rows = tetris.getFieldRows();
+    for (uint8_t y = 0; y < GRID_HEIGHT; y++) {
+        TEST_ASSERT_EQUAL_HEX16(FIELD_WALLS, rows[y]);
+    }
+
+    char message[80];
+    snprintf(message, sizeof(message), "4-line clear: %u ticks, longest update %lu us (host)",
+             (unsigned)(clearEndTick - clearStartTick), maxMicros);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_THAN(TETRIS_MAX_UPDATE_MICROS, maxMicros);
+}
+
+// each step of the animation clears exactly one column of all full lines
+void test_clear_steps_one_column(void) {
+    Tetris tetris(&ledmatrix, &logger);
+    startGame(tetris);
+    TetrisTest::fillRows(tetris, GRID_HEIGHT - 4, 5);
+    TetrisTest::setVerticalI(tetris, 5);
+    tetris.ctrlDown();
+
+    while (!TetrisTest::clearing(tetris)) {
+        tetris.step();
+    }
+    const uint16_t *rows = tetris.getFieldRows();
+    uint8_t clearedColumns = 0;
+    while (TetrisTest::clearing(tetris) && clearedColumns < GRID_WIDTH) {
+        for (uint8_t i = 0; i < CLEAR_STEP_TIME / TETRIS_TICK_TIME; i++) {
+            tetris.step();
+        }
+        clearedColumns++;
+        for (uint8_t y = GRID_HEIGHT - 4; y < GRID_HEIGHT; y++) {
+            uint16_t expected = FIELD_FULL & ~(((1 << clearedColumns) - 1) << FIELD_OFFSET);
+            TEST_ASSERT_EQUAL_HEX16(expected, rows[y]);
+        }
+    }
+    TEST_ASSERT_EQUAL(GRID_WIDTH, clearedColumns);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_four_line_clear_is_spread);
+    RUN_TEST(test_clear_steps_one_column);
+    return UNITY_END();
+}
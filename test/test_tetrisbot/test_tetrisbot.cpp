@@ -0,0 +1,204 @@
+/**
+ * @file test_tetrisbot.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Native tests of the tetris autoplayer: placement on crafted fields, survival over fixed seeds and search speed
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#include <unity.h>
+#include <chrono>
+#include "tetrisbot.h"
+
+#define TETRISBOT_TEST_SEARCHES     20      // timed searches per brick
+
+// access to the field and the active brick of a Tetris object (friend of Tetris)
+class TetrisTest {
+public:
+    // set the given rows of the field, the masks are given without the walls (bit x is column x)
+    static void setRows(Tetris &tetris, uint8_t firstRow, const uint16_t *masks, uint8_t numRows) {
+        for (uint8_t i = 0; i < numRows; i++) {
+            uint8_t y = firstRow + i;
+            tetris._field.rows[y] = FIELD_WALLS | (masks[i] << FIELD_OFFSET);
+            for (uint8_t x = 0; x < GRID_WIDTH; x++) {
+                tetris._field.color[y][x] = ((masks[i] >> x) & 1) ? 1 : 0;
+            }
+        }
+    }
+    // replace the active brick by a new one of the given type at the spawn position
+    static void setBrick(Tetris &tetris, uint8_t type) {
+        tetris._lastBrick = type;
+        tetris._activeBrick.type = type;
+        tetris._activeBrick.rotation = 0;
+        tetris._activeBrick.col = GREEN;
+        memcpy(tetris._activeBrick.rows, Tetris::getBrickRows(type, 0), MAX_BRICK_SIZE);
+    }
+};
+
+// access to the planned placement of a TetrisBot object (friend of TetrisBot)
+class TetrisBotTest {
+public:
+    static void plan(TetrisBot &bot, Tetris &tetris) {
+        uint8_t type, rotation;
+        int xpos, ypos;
+        TEST_ASSERT_TRUE(tetris.getActiveBrick(&type, &rotation, &xpos, &ypos));
+        bot.planPlacement(type, xpos, ypos);
+    }
+    static uint8_t targetRotation(TetrisBot &bot) { return bot._targetRotation; }
+    static int targetX(TetrisBot &bot) { return bot._targetX; }
+    static unsigned long numPlacements(TetrisBot &bot) { return bot._numPlacements; }
+};
+
+Adafruit_NeoMatrix matrix(GRID_WIDTH + 1, GRID_HEIGHT, NEOPIXELPIN, NEOPIXEL_MATRIX_TYPE, NEOPIXEL_LED_TYPE);
+UDPLogger logger;
+LEDMatrix ledmatrix(&matrix, 40, &logger);
+
+void setUp(void) {
+    nativeUseFakeClock(true, 1000);
+    randomSeed(5);
+}
+
+void tearDown(void) {
+    nativeUseFakeClock(false);
+}
+
+/**
+ * @brief Start a game and run its first tick
+ */
+void startGame(Tetris &tetris) {
+    tetris.ctrlStart();
+    tetris.step();
+    TEST_ASSERT_EQUAL(GAME_STATE_RUNNING, tetris.getGameState());
+}
+
+/**
+ * @brief Run game and bot like the main loop (bot every cycle, 10 ms per cycle)
+ */
+void runCycles(Tetris &tetris, TetrisBot &bot, uint32_t cycles) {
+    for (uint32_t i = 0; i < cycles; i++) {
+        nativeAdvanceMillis(10);
+        tetris.loopCycle();
+        bot.loopCycle();
+    }
+}
+
+// an I brick is put vertically into the well of four almost full rows
+void test_place_i_into_well(void) {
+    Tetris tetris(&ledmatrix, &logger);
+    TetrisBot bot(&tetris, &logger);
+    startGame(tetris);
+    const uint16_t well[4] = {0x3FF, 0x3FF, 0x3FF, 0x3FF};  // column 10 is free
+    TetrisTest::setRows(tetris, GRID_HEIGHT - 4, well, 4);
+    TetrisTest::setBrick(tetris, 1);
+
+    TetrisBotTest::plan(bot, tetris);
+    const uint8_t *brick = Tetris::getBrickRows(1, TetrisBotTest::targetRotation(bot));
+    for (uint8_t by = 0; by < MAX_BRICK_SIZE; by++) {
+        // vertical and in column 10
+        TEST_ASSERT_TRUE(brick[by] == 0 || (brick[by] << TetrisBotTest::targetX(bot)) == (1 << 10));
+    }
+
+    // the bot moves the brick there, the four lines are cleared
+    runCycles(tetris, bot, 300);
+    TEST_ASSERT_EQUAL(4, tetris.getScore());
+}
+
+// an O brick fills a gap of its width instead of leaving holes
+void test_place_o_into_gap(void) {
+    Tetris tetris(&ledmatrix, &logger);
+    TetrisBot bot(&tetris, &logger);
+    startGame(tetris);
+    const uint16_t gap[2] = {0x7E7, 0x7E7};                 // columns 3 and 4 are free
+    TetrisTest::setRows(tetris, GRID_HEIGHT - 2, gap, 2);
+    TetrisTest::setBrick(tetris, 0);
+
+    TetrisBotTest::plan(bot, tetris);
+    // O brick occupies columns 1 and 2 of the brick
+    TEST_ASSERT_EQUAL(2, TetrisBotTest::targetX(bot));
+
+    runCycles(tetris, bot, 300);
+    TEST_ASSERT_EQUAL(2, tetris.getScore());
+}
+
+// the bot plays one game for each of ten fixed seeds: every game lasts a while, on average more than 100 bricks,
+// and most of the cells end in cleared lines (few holes)
+void test_survival_fixed_seeds(void) {
+    unsigned long totalBricks = 0;
+    unsigned long totalLines = 0;
+    for (unsigned long seed = 1; seed <= 10; seed++) {
+        randomSeed(seed);
+        Tetris tetris(&ledmatrix, &logger);
+        TetrisBot bot(&tetris, &logger);
+        bot.initGame();
+        // at most 1000 s of game time
+        for (uint32_t cycle = 0; cycle < 100000 && tetris.getGameState() != GAME_STATE_END; cycle++) {
+            runCycles(tetris, bot, 1);
+        }
+        unsigned long bricks = tetris.getBrickCount();
+        totalBricks += bricks;
+        totalLines += tetris.getScore();
+
+        char message[80];
+        snprintf(message, sizeof(message), "seed %lu: %lu bricks, %u lines", seed, bricks, (unsigned)tetris.getScore());
+        TEST_MESSAGE(message);
+        TEST_ASSERT_GREATER_OR_EQUAL_MESSAGE(30, bricks, message);
+    }
+    TEST_ASSERT_GREATER_THAN(100 * 10, totalBricks);
+    // 4 cells per brick, GRID_WIDTH cells per line: at least two thirds of the cells are cleared
+    TEST_ASSERT_GREATER_OR_EQUAL(totalBricks * 4 * 2 / 3, totalLines * GRID_WIDTH);
+}
+
+// benchmark of the placement search on the fields of a real game, timed with the clock of the host
+void test_placement_rate(void) {
+    randomSeed(3);
+    Tetris tetris(&ledmatrix, &logger);
+    TetrisBot bot(&tetris, &logger);
+    bot.initGame();
+    unsigned long lastBrickCount = 0;
+    unsigned long placements = 0;
+    uint32_t searches = 0;
+    unsigned long long totalNanos = 0;
+    unsigned long long maxNanos = 0;
+    for (uint32_t cycle = 0; cycle < 100000 && tetris.getGameState() != GAME_STATE_END; cycle++) {
+        runCycles(tetris, bot, 1);
+        uint8_t type, rotation;
+        int xpos, ypos;
+        if (tetris.getBrickCount() == lastBrickCount || !tetris.getActiveBrick(&type, &rotation, &xpos, &ypos)) {
+            continue;
+        }
+        // new brick: search its placement again (same result), the game is not changed
+        lastBrickCount = tetris.getBrickCount();
+        for (uint8_t i = 0; i < TETRISBOT_TEST_SEARCHES; i++) {
+            unsigned long before = TetrisBotTest::numPlacements(bot);
+            auto start = std::chrono::steady_clock::now();
+            TetrisBotTest::plan(bot, tetris);
+            unsigned long long nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            placements += TetrisBotTest::numPlacements(bot) - before;
+            totalNanos += nanos;
+            maxNanos = max(maxNanos, nanos);
+            searches++;
+        }
+    }
+    TEST_ASSERT_GREATER_THAN(100, searches);
+
+    char message[120];
+    snprintf(message, sizeof(message), "%lu placements in %u searches: %lu placements/s, avg %.2f us, max %.2f us per search (host)",
+             placements, (unsigned)searches, (unsigned long)(placements * 1e9 / max(totalNanos, 1ULL)),
+             totalNanos / 1000.0 / searches, maxNanos / 1000.0);
+    TEST_MESSAGE(message);
+    // all rotations and columns are tried (4 rotations, at least 7 columns each)
+    TEST_ASSERT_GREATER_OR_EQUAL(searches * 4 * 7, placements);
+    // a search takes a small part of a 10 ms main loop cycle
+    TEST_ASSERT_LESS_THAN(1000000, totalNanos / searches);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_place_i_into_well);
+    RUN_TEST(test_place_o_into_gap);
+    RUN_TEST(test_survival_fixed_seeds);
+    RUN_TEST(test_placement_rate);
+    return UNITY_END();
+}
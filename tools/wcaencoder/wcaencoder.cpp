@@ -0,0 +1,140 @@
+/**
+ * @file wcaencoder.cpp
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Command line tool to create animation files (*.wca) for the player mode from PPM images
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * Build on the host:
+ *   g++ -std=c++11 -O2 -o wcaencoder tools/wcaencoder/wcaencoder.cpp
+ *
+ * Usage:
+ *   wcaencoder [-l] [-d <ms>] <output.wca> <frame1.ppm> [<frame2.ppm> ...]
+ *     -l       loop the animation
+ *     -d <ms>  duration of each frame (default 100 ms)
+ *
+ * Every frame is a binary PPM (P6, maxval 255) of 11x10 pixels, e.g.
+ * exported with "convert frame.png -resize 11x10! frame.ppm". Upload the
+ * result with the file manager and select it with /cmd?animation=<file>.
+ *
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "wcaencoder.h"
+
+#define WCAENCODER_WIDTH    11      // GRID_WIDTH of the firmware
+#define WCAENCODER_HEIGHT   10      // GRID_HEIGHT of the firmware
+
+/**
+ * @brief Read the next number of a PPM header (skips whitespace and comments)
+ *
+ * @param file opened PPM file
+ * @return long number, -1 if there is none
+ */
+static long readHeaderNumber(FILE *file){
+    int c = fgetc(file);
+    while (c == '#' || c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+        if (c == '#') {
+            while (c != '\n' && c != EOF) {
+                c = fgetc(file);
+            }
+        }
+        c = fgetc(file);
+    }
+    long value = -1;
+    while (c >= '0' && c <= '9') {
+        value = (value < 0 ? 0 : value * 10) + (c - '0');
+        c = fgetc(file);
+    }
+    // the single whitespace after the number has been consumed
+    return value;
+}
+
+/**
+ * @brief Read a binary PPM file with the size of the led grid
+ *
+ * @param path path of the file
+ * @param pixels vector to be filled with the 24bit colors (row-major)
+ * @return true if successful
+ */
+static bool readPPM(const char *path, std::vector<uint32_t> &pixels){
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        fprintf(stderr, "can't open %s\n", path);
+        return false;
+    }
+    bool ok = fgetc(file) == 'P' && fgetc(file) == '6';
+    long width = ok ? readHeaderNumber(file) : -1;
+    long height = ok ? readHeaderNumber(file) : -1;
+    long maxval = ok ? readHeaderNumber(file) : -1;
+    if (!ok || maxval != 255) {
+        fprintf(stderr, "%s: only binary PPM (P6) with maxval 255 is supported\n", path);
+        fclose(file);
+        return false;
+    }
+    if (width != WCAENCODER_WIDTH || height != WCAENCODER_HEIGHT) {
+        fprintf(stderr, "%s: size %ldx%ld, expected %dx%d\n", path, width, height, WCAENCODER_WIDTH, WCAENCODER_HEIGHT);
+        fclose(file);
+        return false;
+    }
+    pixels.clear();
+    for (long i = 0; i < width * height; i++) {
+        uint8_t rgb[3];
+        if (fread(rgb, 1, 3, file) != 3) {
+            fprintf(stderr, "%s: unexpected end of file\n", path);
+            fclose(file);
+            return false;
+        }
+        pixels.push_back(((uint32_t)rgb[0] << 16) | ((uint32_t)rgb[1] << 8) | rgb[2]);
+    }
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char **argv){
+    bool loop = false;
+    long duration = 100;
+    int arg = 1;
+    while (arg < argc && argv[arg][0] == '-') {
+        if (strcmp(argv[arg], "-l") == 0) {
+            loop = true;
+            arg++;
+        }
+        else if (strcmp(argv[arg], "-d") == 0 && arg + 1 < argc) {
+            duration = atol(argv[arg + 1]);
+            arg += 2;
+        }
+        else {
+            break;
+        }
+    }
+    if (argc - arg < 2 || duration <= 0 || duration > 0xFFFF) {
+        fprintf(stderr, "usage: %s [-l] [-d <ms>] <output.wca> <frame1.ppm> [<frame2.ppm> ...]\n", argv[0]);
+        return 1;
+    }
+
+    WcaEncoder encoder(WCAENCODER_WIDTH, WCAENCODER_HEIGHT, loop);
+    std::vector<uint32_t> pixels;
+    for (int i = arg + 1; i < argc; i++) {
+        if (!readPPM(argv[i], pixels)) {
+            return 1;
+        }
+        if (!encoder.addFrame(pixels, duration)) {
+            fprintf(stderr, "%s: more than %d colors in the animation\n", argv[i], WCAENCODER_MAX_COLORS);
+            return 1;
+        }
+    }
+
+    std::vector<uint8_t> data = encoder.encode();
+    FILE *out = fopen(argv[arg], "wb");
+    if (out == NULL || fwrite(data.data(), 1, data.size(), out) != data.size()) {
+        fprintf(stderr, "can't write %s\n", argv[arg]);
+        return 1;
+    }
+    fclose(out);
+    printf("%s: %d frames, %d colors, %d bytes\n", argv[arg], argc - arg - 1, (int)encoder.paletteSize(), (int)data.size());
+    return 0;
+}
@@ -0,0 +1,191 @@
+/**
+ * @file wcaencoder.h
+ * @author techniccontroller (mail[at]techniccontroller.com)
+ * @brief Encoder for the animation files (*.wca) of the AnimationPlayer, runs on the host
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * The file format is documented in src/animplayer.h. Frames are given as
+ * 24bit colors in row-major order. The palette is collected from all frames
+ * (max. 256 colors). The first frame is stored as key frame, every other
+ * frame as key or delta frame, whichever is smaller.
+ *
+ * Only depends on the C++ standard library, used by the command line tool
+ * (wcaencoder.cpp) and the native tests.
+ *
+ */
+#ifndef wcaencoder_h
+#define wcaencoder_h
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+#define WCAENCODER_MAX_COLORS   256
+#define WCAENCODER_MAX_RUN      255
+#define WCAENCODER_FRAME_KEY    0
+#define WCAENCODER_FRAME_DELTA  1
+#define WCAENCODER_FLAG_LOOP    0x01
+
+class WcaEncoder{
+
+    public:
+        /**
+         * @brief Construct a new WcaEncoder object
+         *
+         * @param width width of the animation (must be GRID_WIDTH of the firmware)
+         * @param height height of the animation (must be GRID_HEIGHT of the firmware)
+         * @param loop true if the animation is looped
+         */
+        WcaEncoder(uint8_t width, uint8_t height, bool loop) : _width(width), _height(height), _loop(loop) {}
+
+        /**
+         * @brief Add the next frame of the animation
+         *
+         * @param pixels 24bit colors of all pixels in row-major order
+         * @param duration duration of the frame in ms
+         * @return false if the frame has the wrong size or the palette is full
+         */
+        bool addFrame(const std::vector<uint32_t> &pixels, uint16_t duration) {
+            if (pixels.size() != (size_t)_width * _height || _frames.size() >= 0xFFFF) {
+                return false;
+            }
+            Frame frame;
+            frame.duration = duration;
+            for (uint32_t color : pixels) {
+                std::map<uint32_t, uint8_t>::iterator entry = _paletteIndex.find(color);
+                if (entry == _paletteIndex.end()) {
+                    if (_palette.size() >= WCAENCODER_MAX_COLORS) {
+                        return false;
+                    }
+                    entry = _paletteIndex.insert(std::make_pair(color, (uint8_t)_palette.size())).first;
+                    _palette.push_back(color);
+                }
+                frame.indices.push_back(entry->second);
+            }
+            _frames.push_back(frame);
+            return true;
+        }
+
+        /**
+         * @brief Encode all frames added so far
+         *
+         * @return std::vector<uint8_t> content of the .wca file, empty if there are no frames
+         */
+        std::vector<uint8_t> encode() const {
+            std::vector<uint8_t> out;
+            if (_frames.empty()) {
+                return out;
+            }
+            out.push_back('W');
+            out.push_back('C');
+            out.push_back('A');
+            out.push_back('1');
+            out.push_back(_width);
+            out.push_back(_height);
+            out.push_back((uint8_t)_palette.size());    // 256 is stored as 0
+            out.push_back(_loop ? WCAENCODER_FLAG_LOOP : 0);
+            pushUInt16(out, _frames.size());
+            for (uint32_t color : _palette) {
+                out.push_back((color >> 16) & 0xFF);
+                out.push_back((color >> 8) & 0xFF);
+                out.push_back(color & 0xFF);
+            }
+
+            for (size_t i = 0; i < _frames.size(); i++) {
+                std::vector<uint8_t> payload = encodeKey(_frames[i]);
+                uint8_t type = WCAENCODER_FRAME_KEY;
+                if (i > 0) {
+                    std::vector<uint8_t> delta = encodeDelta(_frames[i - 1], _frames[i]);
+                    if (delta.size() < payload.size()) {
+                        payload = delta;
+                        type = WCAENCODER_FRAME_DELTA;
+                    }
+                }
+                pushUInt16(out, _frames[i].duration);
+                out.push_back(type);
+                pushUInt16(out, payload.size());
+                out.insert(out.end(), payload.begin(), payload.end());
+            }
+            return out;
+        }
+
+        /**
+         * @brief Get the number of colors in the palette
+         *
+         * @return size_t number of colors
+         */
+        size_t paletteSize() const { return _palette.size(); }
+
+    private:
+        struct Frame {
+            uint16_t duration;
+            std::vector<uint8_t> indices;
+        };
+
+        static void pushUInt16(std::vector<uint8_t> &out, uint16_t value) {
+            out.push_back(value & 0xFF);
+            out.push_back(value >> 8);
+        }
+
+        // pairs of (run length, palette index) covering all pixels
+        static std::vector<uint8_t> encodeKey(const Frame &frame) {
+            std::vector<uint8_t> payload;
+            size_t pixel = 0;
+            while (pixel < frame.indices.size()) {
+                uint8_t run = 1;
+                while (pixel + run < frame.indices.size() && run < WCAENCODER_MAX_RUN
+                        && frame.indices[pixel + run] == frame.indices[pixel]) {
+                    run++;
+                }
+                payload.push_back(run);
+                payload.push_back(frame.indices[pixel]);
+                pixel += run;
+            }
+            return payload;
+        }
+
+        // triples of (pixels to skip, run length, palette index) covering the changed pixels
+        static std::vector<uint8_t> encodeDelta(const Frame &previous, const Frame &frame) {
+            std::vector<uint8_t> payload;
+            size_t pixel = 0;
+            size_t skip = 0;
+            while (pixel < frame.indices.size()) {
+                if (frame.indices[pixel] == previous.indices[pixel]) {
+                    skip++;
+                    pixel++;
+                    continue;
+                }
+                while (skip > WCAENCODER_MAX_RUN) {
+                    // empty run to skip more than 255 pixels
+                    payload.push_back(WCAENCODER_MAX_RUN);
+                    payload.push_back(0);
+                    payload.push_back(0);
+                    skip -= WCAENCODER_MAX_RUN;
+                }
+                uint8_t run = 1;
+                while (pixel + run < frame.indices.size() && run < WCAENCODER_MAX_RUN
+                        && frame.indices[pixel + run] == frame.indices[pixel]
+                        && frame.indices[pixel + run] != previous.indices[pixel + run]) {
+                    run++;
+                }
+                payload.push_back(skip);
+                payload.push_back(run);
+                payload.push_back(frame.indices[pixel]);
+                pixel += run;
+                skip = 0;
+            }
+            return payload;
+        }
+
+        uint8_t _width;
+        uint8_t _height;
+        bool _loop;
+        std::vector<uint32_t> _palette;
+        std::map<uint32_t, uint8_t> _paletteIndex;
+        std::vector<Frame> _frames;
+};
+
+#endif